@@ -0,0 +1,289 @@
+#include "BatchConverter.h"
+#include "../Features/StandaloneExportFeature.h"
+#include "../Features/StandaloneImportFeature.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+
+namespace
+{
+    void addUnique(juce::Array<juce::File>& inputs, const juce::File& file)
+    {
+        if (!inputs.contains(file))
+            inputs.add(file);
+    }
+
+    void sortByPath(juce::Array<juce::File>& files)
+    {
+        std::sort(files.begin(), files.end(), [](const juce::File& a, const juce::File& b)
+        {
+            return a.getFullPathName() < b.getFullPathName();
+        });
+    }
+
+    juce::File getOutputBase(const juce::File& input, const BatchConverter::Options& options)
+    {
+        return options.outputDirectory.getChildFile(input.getFileNameWithoutExtension());
+    }
+
+    // Both project formats use the .narrate extension
+    juce::File getOutputFile(const juce::File& outputBase, const juce::String& format)
+    {
+        return outputBase.withFileExtension(format == "narrate-bin" ? juce::String("narrate") : format);
+    }
+
+    bool loadInput(const juce::File& input, bool allowParallelImport, Narrate::NarrateProject& project, juce::String& error)
+    {
+        if (input.hasFileExtension(".narrate"))
+        {
+            if (project.loadFromFile(input))
+                return true;
+
+            error = "Failed to load Narrate project";
+            return false;
+        }
+
+        StandaloneImportFeature importer;
+
+        // Several files are converted at once, so one file's import shouldn't claim every core as well
+        if (!allowParallelImport)
+            importer.setMaxImportThreads(1);
+
+        auto source = importer.openForImport(input);
+        if (source == nullptr)
+        {
+            error = "Could not detect input file format";
+            return false;
+        }
+
+        if (importer.importFromSource(*source, project))
+            return true;
+
+        error = "Failed to import from " + source->getFormat() + " format";
+        return false;
+    }
+}
+
+bool BatchConverter::addInputs(const juce::String& argument, const juce::File& baseDirectory, bool recursive,
+                               juce::Array<juce::File>& inputs, juce::String& error)
+{
+    const auto path = baseDirectory.getChildFile(argument);
+
+    if (path.existsAsFile())
+    {
+        addUnique(inputs, path);
+        return true;
+    }
+
+    juce::Array<juce::File> matches;
+
+    if (path.isDirectory())
+    {
+        matches = path.findChildFiles(juce::File::findFiles, recursive, inputFilePatterns);
+    }
+    else if (path.getFileName().containsAnyOf("*?"))
+    {
+        // Wildcards are supported in the file name only
+        const auto directory = path.getParentDirectory();
+        if (directory.isDirectory())
+            matches = directory.findChildFiles(juce::File::findFiles, recursive, path.getFileName());
+    }
+    else
+    {
+        error = "No such file or directory: " + argument;
+        return false;
+    }
+
+    if (matches.isEmpty())
+    {
+        error = "No input files match: " + argument;
+        return false;
+    }
+
+    sortByPath(matches);
+    for (const auto& file : matches)
+        addUnique(inputs, file);
+
+    return true;
+}
+
+bool BatchConverter::addManifestInputs(const juce::File& manifest, bool recursive,
+                                       juce::Array<juce::File>& inputs, juce::StringArray& errors)
+{
+    if (!manifest.existsAsFile())
+    {
+        errors.add("Manifest not found: " + manifest.getFullPathName());
+        return false;
+    }
+
+    juce::StringArray lines;
+    manifest.readLines(lines);
+
+    bool allFound = true;
+
+    for (auto line : lines)
+    {
+        line = line.trim();
+        if (line.isEmpty() || line.startsWithChar('#'))
+            continue;
+
+        juce::String error;
+        if (!addInputs(line, manifest.getParentDirectory(), recursive, inputs, error))
+        {
+            errors.add(manifest.getFileName() + ": " + error);
+            allFound = false;
+        }
+    }
+
+    return allFound;
+}
+
+BatchConverter::Result BatchConverter::convertFile(const juce::File& input, const Options& options, bool allowParallelImport)
+{
+    Result result;
+    result.input = input;
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+    const auto outputBase = getOutputBase(input, options);
+
+    Narrate::NarrateProject project;
+
+    if (loadInput(input, allowParallelImport, project, result.error))
+    {
+        result.numClips = project.getNumClips();
+
+        // Exporter formats are written together in one pass; project formats are saved separately
+        std::vector<ExportTarget> targets;
+        juce::StringArray failedFormats;
+
+        for (const auto& format : options.formats)
+        {
+            if (format == "narrate")
+            {
+                if (!project.saveToFile(getOutputFile(outputBase, format)))
+                    failedFormats.add(format);
+            }
+            else if (format == "narrate-bin")
+            {
+                if (!project.saveToBinaryFile(getOutputFile(outputBase, format)))
+                    failedFormats.add(format);
+            }
+            else
+            {
+                targets.push_back({ format, getOutputFile(outputBase, format) });
+            }
+        }
+
+        if (!targets.empty())
+        {
+            StandaloneExportFeature exporter;
+            exporter.setCueMode(options.cueMode);
+            exporter.exportFormats(project, targets);
+
+            for (const auto& target : targets)
+                if (!target.succeeded)
+                    failedFormats.add(target.format);
+        }
+
+        if (failedFormats.isEmpty())
+            result.succeeded = true;
+        else
+            result.error = "Export to " + failedFormats.joinIntoString(", ") + " failed";
+    }
+
+    result.milliseconds = juce::Time::getMillisecondCounterHiRes() - startTime;
+    return result;
+}
+
+std::vector<BatchConverter::Result> BatchConverter::run(const juce::Array<juce::File>& inputs, const Options& options,
+                                                        const std::function<void(const Result&)>& onResult)
+{
+    std::vector<Result> results;
+    results.reserve((size_t) inputs.size());
+
+    const int numThreads = juce::jlimit(1, juce::jmax(1, inputs.size()),
+                                        options.numJobs > 0 ? options.numJobs : juce::SystemStats::getNumCpus());
+
+    // Files whose outputs would clash with an earlier file's, or overwrite the input itself, fail up front
+    juce::Array<juce::File> toConvert;
+    std::map<juce::String, juce::File> outputOwners;
+
+    for (const auto& input : inputs)
+    {
+        const auto outputBase = getOutputBase(input, options);
+
+        Result clash;
+        clash.input = input;
+
+        if (auto owner = outputOwners.find(outputBase.getFullPathName()); owner != outputOwners.end())
+            clash.error = "Output names clash with " + owner->second.getFullPathName();
+
+        for (const auto& format : options.formats)
+            if (getOutputFile(outputBase, format) == input)
+                clash.error = "Output would overwrite the input";
+
+        if (clash.error.isNotEmpty())
+        {
+            if (onResult)
+                onResult(clash);
+
+            results.push_back(std::move(clash));
+            continue;
+        }
+
+        outputOwners[outputBase.getFullPathName()] = input;
+        toConvert.add(input);
+    }
+
+    if (toConvert.isEmpty())
+        return results;
+
+    juce::CriticalSection lock;
+    std::deque<Result> completed;
+    juce::WaitableEvent resultReady;
+
+    {
+        juce::ThreadPool pool(numThreads);
+
+        for (const auto& input : toConvert)
+        {
+            pool.addJob([input, &options, numThreads, &lock, &completed, &resultReady]
+            {
+                auto result = convertFile(input, options, numThreads == 1);
+
+                {
+                    const juce::ScopedLock sl(lock);
+                    completed.push_back(std::move(result));
+                }
+
+                resultReady.signal();
+            });
+        }
+
+        // Report results on this thread as they arrive
+        size_t numReported = 0;
+
+        while (numReported < (size_t) toConvert.size())
+        {
+            resultReady.wait(100);
+
+            std::deque<Result> batch;
+            {
+                const juce::ScopedLock sl(lock);
+                batch.swap(completed);
+            }
+
+            for (auto& result : batch)
+            {
+                if (onResult)
+                    onResult(result);
+
+                results.push_back(std::move(result));
+                ++numReported;
+            }
+        }
+    }
+
+    return results;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "../Features/ExportFeature.h"
+#include <functional>
+#include <vector>
+
+/**
+ * BatchConverter
+ *
+ * Converts many input files in one process for `narrate-console batch`.
+ * Inputs are collected from files, directories, wildcard patterns and
+ * manifest files, then imported and exported on a thread pool; each file's
+ * result is handed back on the calling thread as soon as it completes.
+ *
+ * Every output is written to the output directory as <input name>.<format>.
+ */
+class BatchConverter
+{
+public:
+    struct Options
+    {
+        juce::File outputDirectory;
+        juce::StringArray formats;  // Exporter formats, plus "narrate" or "narrate-bin"
+        ExportFeature::CueMode cueMode = ExportFeature::CueMode::Word;
+        int numJobs = 0;            // 0 = one per CPU core
+    };
+
+    struct Result
+    {
+        juce::File input;
+        bool succeeded = false;
+        int numClips = 0;
+        double milliseconds = 0.0;
+        juce::String error;
+    };
+
+    // Extensions picked up when a directory is given as input
+    static constexpr const char* inputFilePatterns = "*.srt;*.vtt;*.json;*.txt;*.narrate";
+
+    /**
+     * Add the files an input argument names, relative to baseDirectory:
+     * - an existing file
+     * - a directory (files with a supported extension, sorted by name)
+     * - a wildcard pattern in the file name part, like "*.srt" after a directory path
+     * Files already in the list are not added again.
+     * @return false (with an error message) if nothing matches
+     */
+    static bool addInputs(const juce::String& argument, const juce::File& baseDirectory, bool recursive,
+                          juce::Array<juce::File>& inputs, juce::String& error);
+
+    /**
+     * Add the inputs listed in a manifest: one file, directory or pattern per line,
+     * relative to the manifest's directory. Blank lines and lines starting with # are skipped.
+     * @return false if the manifest can't be read or an entry matches nothing
+     */
+    static bool addManifestInputs(const juce::File& manifest, bool recursive,
+                                  juce::Array<juce::File>& inputs, juce::StringArray& errors);
+
+    /**
+     * Convert every input on a pool of options.numJobs threads.
+     * onResult is called on the calling thread as each file completes.
+     * @return the results in completion order
+     */
+    static std::vector<Result> run(const juce::Array<juce::File>& inputs, const Options& options,
+                                   const std::function<void(const Result&)>& onResult);
+
+    // Import one file and write all its outputs; safe to call from several threads at once
+    static Result convertFile(const juce::File& input, const Options& options, bool allowParallelImport = true);
+};
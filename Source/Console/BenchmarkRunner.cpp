@@ -0,0 +1,417 @@
+#include "BenchmarkRunner.h"
+#include "../Features/ExportWriter.h"
+#include "../Features/StandaloneExportFeature.h"
+#include "../Features/StandaloneImportFeature.h"
+#include "../Features/SubtitleTokenizer.h"
+#include "../Features/TextImportSource.h"
+#include "../TimelineEventManager.h"
+
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <string>
+
+#if JUCE_LINUX
+ #include <malloc.h>
+#endif
+
+namespace
+{
+    // Peak memory comes from /proc; VmHWM can be reset between stages by writing 5 to clear_refs
+   #if JUCE_LINUX
+    juce::int64 readStatusKB(const std::string& field)
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+
+        while (std::getline(status, line))
+            if (line.rfind(field, 0) == 0)
+                return std::stoll(line.substr(field.size()));
+
+        return -1;
+    }
+
+    void resetPeakMemory()
+    {
+        malloc_trim(0);
+        std::ofstream("/proc/self/clear_refs") << "5";
+    }
+
+    juce::int64 getCurrentMemoryKB() { return readStatusKB("VmRSS:"); }
+    juce::int64 getPeakMemoryKB()    { return readStatusKB("VmHWM:"); }
+   #else
+    void resetPeakMemory() {}
+    juce::int64 getCurrentMemoryKB() { return -1; }
+    juce::int64 getPeakMemoryKB()    { return -1; }
+   #endif
+
+    int getTotalWords(const BenchmarkRunner::Workload& workload)
+    {
+        return workload.numClips * workload.wordsPerClip;
+    }
+
+    /**
+     * Time one stage over workload.numRepeats runs. The stage returns the bytes it
+     * wrote or read (or -1 if it has none), or nothing if it failed.
+     */
+    template <typename StageFunction>
+    BenchmarkRunner::StageResult timeStage(const juce::String& name, const BenchmarkRunner::Workload& workload,
+                                           StageFunction&& stage)
+    {
+        BenchmarkRunner::StageResult result;
+        result.name = name;
+
+        const int numRuns = juce::jmax(1, workload.numRepeats);
+        double totalMs = 0.0;
+
+        resetPeakMemory();
+        const auto baselineKB = getCurrentMemoryKB();
+
+        for (int run = 0; run < numRuns; ++run)
+        {
+            const auto start = juce::Time::getMillisecondCounterHiRes();
+            const std::optional<juce::int64> bytes = stage();
+            const auto elapsed = juce::Time::getMillisecondCounterHiRes() - start;
+
+            if (!bytes.has_value())
+            {
+                result.succeeded = false;
+                break;
+            }
+
+            result.bytes = *bytes;
+            result.fastestMs = run == 0 ? elapsed : juce::jmin(result.fastestMs, elapsed);
+            totalMs += elapsed;
+            result.meanMs = totalMs / (run + 1);
+        }
+
+        result.peakResidentKB = getPeakMemoryKB();
+        if (baselineKB >= 0 && result.peakResidentKB >= 0)
+            result.peakMemoryKB = juce::jmax((juce::int64) 0, result.peakResidentKB - baselineKB);
+
+        return result;
+    }
+
+    std::optional<juce::int64> fileSizeIf(bool succeeded, const juce::File& file)
+    {
+        if (!succeeded)
+            return std::nullopt;
+
+        return file.getSize();
+    }
+
+    void writeField(ExportWriter& writer, const char* name, bool isFirst = false)
+    {
+        writer.write(isFirst ? "\n" : ",\n");
+        writer.write("      \"");
+        writer.write(name);
+        writer.write("\": ");
+    }
+}
+
+Narrate::NarrateProject BenchmarkRunner::generateProject(const Workload& workload)
+{
+    static const char* vocabulary[] = {
+        "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "and", "then",
+        "story", "begins", "once", "upon", "a", "time", "there", "was", "little", "voice",
+        "singing", "softly", "through", "night", "morning", "light", "river", "mountain", "we", "walked",
+        "together", "under", "stars", "remember", "every", "word", "you", "said", "to", "me",
+        "hello", "world", "narrate", "timing", "highlight", "karaoke", "teleprompter", "subtitle",
+        "don't", "it's", "café", "naïve", "über", "señor", "cœur", "fiancée", "\"quoted\"", "comma,separated",
+        "semi;colon", "<tag>", "ampersand&", "line"
+    };
+    static constexpr int vocabularySize = (int) (sizeof(vocabulary) / sizeof(vocabulary[0]));
+
+    // A handful of styles, like a real project: a few colours, some bold or italic, some larger
+    static const juce::uint32 colours[] = { 0xffffffff, 0xffffd700, 0xff00bfff, 0xffff6347, 0xff7cfc00 };
+
+    juce::Random random(workload.seed);
+    Narrate::NarrateProject project;
+    project.setProjectName("bench-" + juce::String(workload.numClips) + "x" + juce::String(workload.wordsPerClip)
+                           + "-seed" + juce::String(workload.seed));
+
+    Narrate::NarrateProject::ClipBatch batch(project, workload.numClips);
+    double clipStart = 0.0;
+
+    for (int clipIdx = 0; clipIdx < workload.numClips; ++clipIdx)
+    {
+        // Clip start and word offsets on whole milliseconds, as SRT and WebVTT store them
+        juce::Array<double> offsets;
+        double offset = 0.0;
+
+        for (int wordIdx = 0; wordIdx < workload.wordsPerClip; ++wordIdx)
+        {
+            offsets.add(offset);
+            offset += (150 + random.nextInt(450)) / 1000.0;
+        }
+
+        Narrate::NarrateClip clip("clip" + juce::String(clipIdx + 1), clipStart, clipStart + offset);
+        clip.reserveWords(workload.wordsPerClip);
+
+        for (int wordIdx = 0; wordIdx < workload.wordsPerClip; ++wordIdx)
+        {
+            Narrate::NarrateWord word(juce::String::fromUTF8(vocabulary[random.nextInt(vocabularySize)]), offsets[wordIdx]);
+
+            if (random.nextDouble() < workload.formattingDensity)
+            {
+                Narrate::TextFormatting formatting;
+                formatting.colour = juce::Colour(colours[random.nextInt(5)]);
+                formatting.bold = random.nextInt(3) == 0;
+                formatting.italic = random.nextInt(4) == 0;
+                formatting.fontSizeMultiplier = random.nextInt(5) == 0 ? 1.5f : 1.0f;
+                word.formatting = formatting;
+            }
+
+            clip.addWord(std::move(word));
+        }
+
+        batch.add(std::move(clip));
+        clipStart += offset + (random.nextInt(1000) / 1000.0);
+    }
+
+    batch.finish();
+    return project;
+}
+
+std::vector<BenchmarkRunner::StageResult> BenchmarkRunner::run(const Workload& workload, const juce::File& workingDirectory,
+                                                               const std::function<void(const StageResult&)>& onStage)
+{
+    std::vector<StageResult> results;
+
+    auto addResult = [&](StageResult result)
+    {
+        if (onStage)
+            onStage(result);
+
+        results.push_back(std::move(result));
+    };
+
+    Narrate::NarrateProject project;
+
+    addResult(timeStage("generate", workload, [&]() -> std::optional<juce::int64>
+    {
+        project = generateProject(workload);
+        return -1;
+    }));
+
+    // Native project formats
+    const auto xmlFile = workingDirectory.getChildFile("bench.narrate");
+    const auto binaryFile = workingDirectory.getChildFile("bench-bin.narrate");
+
+    addResult(timeStage("xml.save", workload, [&] { return fileSizeIf(project.saveToFile(xmlFile), xmlFile); }));
+    addResult(timeStage("xml.load", workload, [&]
+    {
+        Narrate::NarrateProject loaded;
+        return fileSizeIf(loaded.loadFromFile(xmlFile), xmlFile);
+    }));
+
+    addResult(timeStage("binary.save", workload, [&] { return fileSizeIf(project.saveToBinaryFile(binaryFile), binaryFile); }));
+    addResult(timeStage("binary.load", workload, [&]
+    {
+        Narrate::NarrateProject loaded;
+        return fileSizeIf(loaded.loadFromFile(binaryFile), binaryFile);
+    }));
+
+    // Exporters; their output is the input for the detection and import stages
+    StandaloneExportFeature exporter;
+    std::map<juce::String, juce::File> exportedFiles;
+
+    for (const auto& format : ExportFeature::getFormatNames())
+    {
+        const auto file = workingDirectory.getChildFile("bench." + format);
+
+        addResult(timeStage("export." + format, workload, [&]
+        {
+            std::vector<ExportTarget> targets { { format, file } };
+            return fileSizeIf(exporter.exportFormats(project, targets), file);
+        }));
+
+        exportedFiles[format] = file;
+    }
+
+    // Format detection reads only the start of each file
+    StandaloneImportFeature importer;
+    const juce::StringArray importFormats { "srt", "vtt", "txt", "json" };
+
+    for (const auto& format : importFormats)
+    {
+        const auto& file = exportedFiles[format];
+
+        addResult(timeStage("detect." + format, workload, [&]() -> std::optional<juce::int64>
+        {
+            juce::String detected;
+            if (!importer.detectFormat(file, detected) || detected != format)
+                return std::nullopt;
+
+            return juce::jmin(file.getSize(), (juce::int64) TextImportSource::detectionPrefixSize);
+        }));
+    }
+
+    // The subtitle tokenizer on its own: the mapped file read in windows and split into words, no project built
+    for (const auto& format : { juce::String("srt"), juce::String("vtt") })
+    {
+        const auto& file = exportedFiles[format];
+        const auto tokenizerFormat = format == "vtt" ? SubtitleTokenizer::Format::WebVTT : SubtitleTokenizer::Format::SRT;
+
+        addResult(timeStage("tokenize." + format, workload, [&]() -> std::optional<juce::int64>
+        {
+            auto source = TextImportSource::open(file);
+            if (source == nullptr)
+                return std::nullopt;
+
+            std::string_view window;
+            std::vector<juce::String> words;
+            size_t numWords = 0;
+
+            for (bool firstWindow = true; source->nextWindow(window); firstWindow = false)
+            {
+                SubtitleTokenizer tokenizer(window, tokenizerFormat, firstWindow);
+                SubtitleTokenizer::Cue cue;
+
+                while (tokenizer.next(cue))
+                {
+                    words.clear();
+                    SubtitleTokenizer::splitWords(cue.text, tokenizerFormat, words);
+                    numWords += words.size();
+                }
+            }
+
+            if (numWords == 0 && getTotalWords(workload) > 0)
+                return std::nullopt;
+
+            return file.getSize();
+        }));
+    }
+
+    for (const auto& format : importFormats)
+    {
+        const auto& file = exportedFiles[format];
+
+        addResult(timeStage("import." + format, workload, [&]
+        {
+            Narrate::NarrateProject imported;
+            bool success = false;
+
+            if (format == "srt")
+                success = importer.importSRT(file, imported);
+            else if (format == "vtt")
+                success = importer.importWebVTT(file, imported);
+            else if (format == "txt")
+                success = importer.importPlainText(file, imported);
+            else if (format == "json")
+                success = importer.importJSON(file, imported);
+
+            return fileSizeIf(success, file);
+        }));
+    }
+
+    // Timeline
+    addResult(timeStage("timeline.build", workload, [&]() -> std::optional<juce::int64>
+    {
+        TimelineEventManager timeline;
+        timeline.buildTimeline(project);
+        if (timeline.getNumEvents() == 0 && getTotalWords(workload) > 0)
+            return std::nullopt;
+
+        return -1;
+    }));
+
+    for (const auto& [format, file] : exportedFiles)
+        file.deleteFile();
+
+    xmlFile.deleteFile();
+    binaryFile.deleteFile();
+
+    return results;
+}
+
+bool BenchmarkRunner::writeReport(const Workload& workload, const std::vector<StageResult>& results, juce::OutputStream& output)
+{
+    ExportWriter writer(output);
+    const auto totalWords = getTotalWords(workload);
+
+    writer.write("{\n  \"workload\": {\n    \"clips\": ");
+    writer.writeInt(workload.numClips);
+    writer.write(",\n    \"wordsPerClip\": ");
+    writer.writeInt(workload.wordsPerClip);
+    writer.write(",\n    \"words\": ");
+    writer.writeInt(totalWords);
+    writer.write(",\n    \"formattingDensity\": ");
+    writer.writeNumber(workload.formattingDensity);
+    writer.write(",\n    \"seed\": ");
+    writer.writeInt(workload.seed);
+    writer.write(",\n    \"repeats\": ");
+    writer.writeInt(juce::jmax(1, workload.numRepeats));
+
+    writer.write("\n  },\n  \"build\": {\n    \"version\": \"0.2.0\",\n    \"config\": ");
+   #if JUCE_DEBUG
+    writer.write("\"debug\"");
+   #else
+    writer.write("\"release\"");
+   #endif
+    writer.write(",\n    \"cpus\": ");
+    writer.writeInt(juce::SystemStats::getNumCpus());
+
+    writer.write("\n  },\n  \"stages\": [");
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& result = results[i];
+        const double seconds = result.fastestMs / 1000.0;
+
+        writer.write(i == 0 ? "\n    {" : ",\n    {");
+        writeField(writer, "name", true);
+        writer.write('"');
+        writer.write(result.name);
+        writer.write('"');
+        writeField(writer, "succeeded");
+        writer.write(result.succeeded ? "true" : "false");
+        writeField(writer, "ms");
+        writer.writeNumber(result.fastestMs);
+        writeField(writer, "meanMs");
+        writer.writeNumber(result.meanMs);
+
+        // Throughput from the fastest run; stages without a file have no MB/s
+        writeField(writer, "bytes");
+        if (result.bytes >= 0)
+            writer.writeInt(result.bytes);
+        else
+            writer.write("null");
+
+        writeField(writer, "mbPerSecond");
+        if (result.bytes >= 0 && seconds > 0.0)
+            writer.writeNumber(result.bytes / (1024.0 * 1024.0) / seconds);
+        else
+            writer.write("null");
+
+        writeField(writer, "wordsPerSecond");
+        if (seconds > 0.0 && !result.name.startsWith("detect."))
+            writer.writeInt(std::llround(totalWords / seconds));
+        else
+            writer.write("null");
+
+        writeField(writer, "peakMemoryKB");
+        if (result.peakMemoryKB >= 0)
+            writer.writeInt(result.peakMemoryKB);
+        else
+            writer.write("null");
+
+        writer.write("\n    }");
+    }
+
+    // The peak is reset for each stage, so the process peak is the largest stage peak
+    juce::int64 peakKB = -1;
+    for (const auto& result : results)
+        peakKB = juce::jmax(peakKB, result.peakResidentKB);
+
+    writer.write("\n  ],\n  \"peakMemoryKB\": ");
+    if (peakKB >= 0)
+        writer.writeInt(peakKB);
+    else
+        writer.write("null");
+    writer.write("\n}\n");
+
+    writer.flush();
+    return !writer.failed();
+}
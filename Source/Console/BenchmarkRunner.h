@@ -0,0 +1,58 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "../NarrateDataModel.h"
+#include <functional>
+#include <vector>
+
+/**
+ * BenchmarkRunner
+ *
+ * Runs `narrate-console bench`: generates a synthetic project, then times each
+ * stage of a round trip through the file formats and the timeline:
+ *
+ *   generate, xml.save/load, binary.save/load, export.<format>,
+ *   detect.<format>, tokenize.srt/vtt, import.<format>, timeline.build
+ *
+ * The generator is deterministic, so the same workload always produces the same
+ * project and the same files, and reports from different builds can be compared.
+ */
+class BenchmarkRunner
+{
+public:
+    struct Workload
+    {
+        int numClips = 10000;
+        int wordsPerClip = 10;
+        double formattingDensity = 0.1;  // Fraction of words with their own formatting (0-1)
+        juce::int64 seed = 1;
+        int numRepeats = 3;              // Each stage runs this many times; the fastest run is reported
+    };
+
+    struct StageResult
+    {
+        juce::String name;
+        double fastestMs = 0.0;
+        double meanMs = 0.0;
+        juce::int64 bytes = -1;          // Bytes written or read, -1 if the stage has no file
+        juce::int64 peakMemoryKB = -1;   // Peak resident memory above the stage's starting point, -1 if unknown
+        juce::int64 peakResidentKB = -1; // Peak resident memory of the process during the stage, -1 if unknown
+        bool succeeded = true;
+    };
+
+    /**
+     * Build a project of workload.numClips clips with workload.wordsPerClip words each.
+     * Word text, timing and formatting come from a Random seeded with workload.seed.
+     */
+    static Narrate::NarrateProject generateProject(const Workload& workload);
+
+    /**
+     * Run every stage, writing its files to workingDirectory.
+     * onStage is called after each stage, for progress output.
+     */
+    static std::vector<StageResult> run(const Workload& workload, const juce::File& workingDirectory,
+                                        const std::function<void(const StageResult&)>& onStage);
+
+    // Write a report as JSON: the workload, the build, and per stage the times, MB/s, words/s and peak memory
+    static bool writeReport(const Workload& workload, const std::vector<StageResult>& results, juce::OutputStream& output);
+};
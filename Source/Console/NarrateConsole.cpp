@@ -1,9 +1,16 @@
 #include <juce_core/juce_core.h>
 #include <juce_graphics/juce_graphics.h>
 #include "../NarrateDataModel.h"
+#include "../NarrateBinaryFormat.h"
+#include "../NarrateXmlReader.h"
 #include "../Features/StandaloneExportFeature.h"
 #include "../Features/StandaloneImportFeature.h"
+#include "../Features/PrefixedInputStream.h"
+#include "../Features/TextImportSource.h"
 #include "../NarrateConfig.h"
+#include "BatchConverter.h"
+#include "BenchmarkRunner.h"
+#include "StandardStreams.h"
 
 #include <iostream>
 #include <string>
@@ -16,6 +23,22 @@
  * Usage:
  *   narrate-console <input> <output> --format <format>
  *   narrate-console convert <input> <output> [--format <format>]
+ *   narrate-console <input> <output-base> --formats srt,vtt,json,csv
+ *   narrate-console batch <inputs...> --out <dir> --formats srt,vtt [--jobs N]
+ *   narrate-console - - --from srt --format vtt < input.srt > output.vtt
+ *   narrate-console bench [--clips N] [--words N] [--formatting 0.1] [--seed N]
+ *
+ * "-" reads the input from stdin or writes the output to stdout. Input formats
+ * are detected from the first few KB of the stream (override with --from);
+ * writing to stdout needs --format, and status messages then go to stderr.
+ *
+ * Bench mode generates a deterministic project and times each import, export,
+ * save/load and timeline stage, printing the results as JSON.
+ *
+ * Batch mode converts many files in one process: inputs can be files,
+ * directories, wildcard patterns or manifest files (--manifest), and are
+ * converted on a pool of worker threads. One line is printed per file as it
+ * completes, then a summary; the exit code is nonzero if any file failed.
  *
  * Supported Formats:
  *   - srt       : SubRip subtitle format
@@ -24,6 +47,7 @@
  *   - json      : JSON format with full metadata
  *   - csv       : CSV format with word-level timing
  *   - narrate   : Native Narrate project format
+ *   - narrate-bin : Native Narrate project, binary container (fast to load)
  */
 
 void printUsage(const juce::String& programName)
@@ -33,18 +57,41 @@ void printUsage(const juce::String& programName)
     std::cout << "Convert between subtitle and transcript formats\n\n";
     std::cout << "Usage:\n";
     std::cout << "  " << programName.toStdString() << " <input> <output> --format <format>\n";
-    std::cout << "  " << programName.toStdString() << " convert <input> <output> [--format <format>]\n\n";
+    std::cout << "  " << programName.toStdString() << " convert <input> <output> [--format <format>]\n";
+    std::cout << "  " << programName.toStdString() << " <input> <output-base> --formats <format,format,...>\n";
+    std::cout << "  " << programName.toStdString() << " batch <input>... --out <dir> (--format <format> | --formats <list>)\n";
+    std::cout << "  " << programName.toStdString() << " bench [--clips <n>] [--words <n>] [--formatting <0-1>] [--seed <n>]\n\n";
     std::cout << "Options:\n";
     std::cout << "  --format <format>   Output format (auto-detected if not specified)\n";
-    std::cout << "                      Available: srt, vtt, txt, json, csv, narrate\n";
+    std::cout << "                      Available: srt, vtt, txt, json, csv, narrate, narrate-bin\n";
+    std::cout << "  --formats <list>    Export several formats in one pass, named <output-base>.<format>\n";
+    std::cout << "                      Available: srt, vtt, txt, json, csv\n";
+    std::cout << "  --from <format>     Input format instead of detecting it: srt, vtt, txt, json, narrate\n";
+    std::cout << "  --cues <word|clip>  SRT/WebVTT cues per word (default) or per clip;\n";
+    std::cout << "                      per-clip WebVTT keeps word timing as <hh:mm:ss.mmm> tags\n";
     std::cout << "  --help, -h          Show this help message\n";
     std::cout << "  --version, -v       Show version information\n\n";
+    std::cout << "Batch Options:\n";
+    std::cout << "  <input>...          Files, directories or wildcard patterns (e.g. \"subs/*.srt\")\n";
+    std::cout << "  --manifest <file>   Read inputs from a file, one per line (# starts a comment)\n";
+    std::cout << "  --out <dir>         Directory for the outputs, named <input name>.<format>\n";
+    std::cout << "  --jobs <n>          Files converted in parallel (default: one per CPU core)\n";
+    std::cout << "  --recursive, -r     Include subdirectories when searching directories and patterns\n\n";
+    std::cout << "Bench Options:\n";
+    std::cout << "  --clips <n>         Clips in the generated project (default 10000)\n";
+    std::cout << "  --words <n>         Words per clip (default 10)\n";
+    std::cout << "  --formatting <f>    Fraction of words with their own formatting (default 0.1)\n";
+    std::cout << "  --seed <n>          Generator seed; the same seed gives the same project (default 1)\n";
+    std::cout << "  --repeat <n>        Runs per stage, fastest reported (default 3)\n";
+    std::cout << "  --dir <dir>         Directory for the temporary files (default: system temp)\n";
+    std::cout << "  --output <file>     Write the JSON report to a file instead of stdout\n\n";
     std::cout << "Supported Input Formats:\n";
     std::cout << "  .srt       SubRip subtitle files\n";
     std::cout << "  .vtt       WebVTT subtitle files\n";
     std::cout << "  .txt       Plain text (timing estimated)\n";
     std::cout << "  .json      JSON export from Narrate\n";
-    std::cout << "  .narrate   Native Narrate project files\n\n";
+    std::cout << "  .narrate   Native Narrate project files (XML or binary)\n";
+    std::cout << "  -          stdin (the format is detected from the stream; output \"-\" is stdout)\n\n";
     std::cout << "Examples:\n";
     std::cout << "  # Convert SRT to WebVTT\n";
     std::cout << "  " << programName.toStdString() << " input.srt output.vtt\n\n";
@@ -52,8 +99,20 @@ void printUsage(const juce::String& programName)
     std::cout << "  " << programName.toStdString() << " input.vtt output.json --format json\n\n";
     std::cout << "  # Import SRT and save as Narrate project\n";
     std::cout << "  " << programName.toStdString() << " subtitles.srt project.narrate\n\n";
+    std::cout << "  # Save a large project in the binary container\n";
+    std::cout << "  " << programName.toStdString() << " project.narrate project-bin.narrate --format narrate-bin\n\n";
     std::cout << "  # Export Narrate project to CSV\n";
     std::cout << "  " << programName.toStdString() << " project.narrate data.csv --format csv\n\n";
+    std::cout << "  # Write out/lyrics.srt, out/lyrics.vtt, out/lyrics.json and out/lyrics.csv from one import\n";
+    std::cout << "  " << programName.toStdString() << " input.srt out/lyrics --formats srt,vtt,json,csv\n\n";
+    std::cout << "  # One WebVTT cue per line, with word timing inside the cue\n";
+    std::cout << "  " << programName.toStdString() << " project.narrate lyrics.vtt --cues clip\n\n";
+    std::cout << "  # Convert in a pipeline, without temporary files\n";
+    std::cout << "  curl -s https://example.com/talk.srt | " << programName.toStdString() << " - - --format vtt > talk.vtt\n\n";
+    std::cout << "  # Time every stage on 1M words and keep the report for comparison\n";
+    std::cout << "  " << programName.toStdString() << " bench --clips 100000 --words 10 --output bench.json\n\n";
+    std::cout << "  # Convert every subtitle file under subs/ to WebVTT and JSON, four files at a time\n";
+    std::cout << "  " << programName.toStdString() << " batch subs -r --out converted --formats vtt,json --jobs 4\n\n";
 }
 
 void printVersion()
@@ -66,7 +125,12 @@ struct CommandLineArgs
 {
     juce::File inputFile;
     juce::File outputFile;
+    bool inputIsStdin = false;     // Input given as "-"
+    bool outputIsStdout = false;   // Output given as "-"
+    juce::String fromFormat;  // --from: input format (empty to detect)
     juce::String format;  // Output format (can be empty for auto-detect)
+    juce::StringArray formats;  // --formats: several exporter formats, written next to outputFile
+    ExportFeature::CueMode cueMode = ExportFeature::CueMode::Word;
     bool valid = false;
 };
 
@@ -112,12 +176,16 @@ CommandLineArgs parseArguments(int argc, char* argv[])
         return args;
     }
 
-    // Parse input file
-    args.inputFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[argIndex]);
+    // Parse input file ("-" is stdin)
+    args.inputIsStdin = juce::String(argv[argIndex]) == "-";
+    if (!args.inputIsStdin)
+        args.inputFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[argIndex]);
     ++argIndex;
 
-    // Parse output file
-    args.outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[argIndex]);
+    // Parse output file ("-" is stdout)
+    args.outputIsStdout = juce::String(argv[argIndex]) == "-";
+    if (!args.outputIsStdout)
+        args.outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[argIndex]);
     ++argIndex;
 
     // Parse optional format flag
@@ -130,6 +198,43 @@ CommandLineArgs parseArguments(int argc, char* argv[])
             args.format = juce::String(argv[argIndex + 1]).toLowerCase();
             argIndex += 2;
         }
+        else if (arg == "--from" && argIndex + 1 < argc)
+        {
+            args.fromFormat = juce::String(argv[argIndex + 1]).toLowerCase();
+
+            if (!juce::StringArray { "srt", "vtt", "txt", "json", "narrate" }.contains(args.fromFormat))
+            {
+                std::cerr << "Error: Unknown input format '" << args.fromFormat.toStdString() << "'\n";
+                std::cerr << "Supported input formats: srt, vtt, txt, json, narrate\n";
+                return args;
+            }
+
+            argIndex += 2;
+        }
+        else if (arg == "--cues" && argIndex + 1 < argc)
+        {
+            const auto cues = juce::String(argv[argIndex + 1]).toLowerCase();
+
+            if (cues == "word")
+                args.cueMode = ExportFeature::CueMode::Word;
+            else if (cues == "clip")
+                args.cueMode = ExportFeature::CueMode::Clip;
+            else
+            {
+                std::cerr << "Error: Unknown cue mode '" << cues.toStdString() << "' (use word or clip)\n";
+                return args;
+            }
+
+            argIndex += 2;
+        }
+        else if (arg == "--formats" && argIndex + 1 < argc)
+        {
+            args.formats = juce::StringArray::fromTokens(juce::String(argv[argIndex + 1]).toLowerCase(), ",", "");
+            args.formats.trim();
+            args.formats.removeEmptyStrings();
+            args.formats.removeDuplicates(false);
+            argIndex += 2;
+        }
         else
         {
             std::cerr << "Error: Unknown argument '" << arg.toStdString() << "'\n";
@@ -138,13 +243,47 @@ CommandLineArgs parseArguments(int argc, char* argv[])
     }
 
     // Validate input file exists
-    if (!args.inputFile.existsAsFile())
+    if (!args.inputIsStdin && !args.inputFile.existsAsFile())
     {
         std::cerr << "Error: Input file does not exist: " << args.inputFile.getFullPathName().toStdString() << "\n";
         return args;
     }
 
+    if (!args.formats.isEmpty())
+    {
+        if (args.format.isNotEmpty())
+        {
+            std::cerr << "Error: Use either --format or --formats, not both\n";
+            return args;
+        }
+
+        if (args.outputIsStdout)
+        {
+            std::cerr << "Error: --formats writes several files and can't write to stdout\n";
+            return args;
+        }
+
+        for (const auto& format : args.formats)
+        {
+            if (!ExportFeature::getFormatNames().contains(format))
+            {
+                std::cerr << "Error: Unknown format '" << format.toStdString() << "' in --formats\n";
+                std::cerr << "Supported formats: " << ExportFeature::getFormatNames().joinIntoString(", ").toStdString() << "\n";
+                return args;
+            }
+        }
+
+        args.valid = true;
+        return args;
+    }
+
     // Auto-detect output format from file extension if not specified
+    if (args.format.isEmpty() && args.outputIsStdout)
+    {
+        std::cerr << "Error: Writing to stdout needs --format\n";
+        return args;
+    }
+
     if (args.format.isEmpty())
     {
         args.format = args.outputFile.getFileExtension().substring(1).toLowerCase();
@@ -153,10 +292,134 @@ CommandLineArgs parseArguments(int argc, char* argv[])
     // Validate format
     if (args.format != "srt" && args.format != "vtt" &&
         args.format != "txt" && args.format != "json" &&
-        args.format != "csv" && args.format != "narrate")
+        args.format != "csv" && args.format != "narrate" &&
+        args.format != "narrate-bin")
     {
         std::cerr << "Error: Unknown format '" << args.format.toStdString() << "'\n";
-        std::cerr << "Supported formats: srt, vtt, txt, json, csv, narrate\n";
+        std::cerr << "Supported formats: srt, vtt, txt, json, csv, narrate, narrate-bin\n";
+        return args;
+    }
+
+    args.valid = true;
+    return args;
+}
+
+struct BatchArgs
+{
+    juce::StringArray inputs;     // Files, directories or patterns
+    juce::StringArray manifests;
+    bool recursive = false;
+    BatchConverter::Options options;
+    bool valid = false;
+};
+
+BatchArgs parseBatchArguments(int argc, char* argv[])
+{
+    BatchArgs args;
+    const auto programName = juce::File(argv[0]).getFileName();
+
+    for (int argIndex = 2; argIndex < argc; ++argIndex)
+    {
+        juce::String arg(argv[argIndex]);
+        const bool hasValue = argIndex + 1 < argc;
+
+        if (arg == "--help" || arg == "-h")
+        {
+            printUsage(programName);
+            return args;
+        }
+
+        if (arg == "--out" && hasValue)
+        {
+            args.options.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++argIndex]);
+        }
+        else if (arg == "--manifest" && hasValue)
+        {
+            args.manifests.add(argv[++argIndex]);
+        }
+        else if (arg == "--format" && hasValue)
+        {
+            args.options.formats.add(juce::String(argv[++argIndex]).toLowerCase());
+        }
+        else if (arg == "--formats" && hasValue)
+        {
+            args.options.formats.addTokens(juce::String(argv[++argIndex]).toLowerCase(), ",", "");
+        }
+        else if (arg == "--jobs" && hasValue)
+        {
+            args.options.numJobs = juce::String(argv[++argIndex]).getIntValue();
+
+            if (args.options.numJobs < 1)
+            {
+                std::cerr << "Error: --jobs needs a positive number\n";
+                return args;
+            }
+        }
+        else if (arg == "--cues" && hasValue)
+        {
+            const auto cues = juce::String(argv[++argIndex]).toLowerCase();
+
+            if (cues == "word")
+                args.options.cueMode = ExportFeature::CueMode::Word;
+            else if (cues == "clip")
+                args.options.cueMode = ExportFeature::CueMode::Clip;
+            else
+            {
+                std::cerr << "Error: Unknown cue mode '" << cues.toStdString() << "' (use word or clip)\n";
+                return args;
+            }
+        }
+        else if (arg == "--recursive" || arg == "-r")
+        {
+            args.recursive = true;
+        }
+        else if (arg.startsWith("-"))
+        {
+            std::cerr << "Error: Unknown argument '" << arg.toStdString() << "'\n";
+            return args;
+        }
+        else
+        {
+            args.inputs.add(arg);
+        }
+    }
+
+    args.options.formats.trim();
+    args.options.formats.removeEmptyStrings();
+    args.options.formats.removeDuplicates(false);
+
+    if (args.inputs.isEmpty() && args.manifests.isEmpty())
+    {
+        std::cerr << "Error: No inputs given (pass files, directories, patterns or --manifest)\n";
+        return args;
+    }
+
+    if (args.options.outputDirectory == juce::File())
+    {
+        std::cerr << "Error: Missing --out <dir>\n";
+        return args;
+    }
+
+    if (args.options.formats.isEmpty())
+    {
+        std::cerr << "Error: Missing --format or --formats\n";
+        return args;
+    }
+
+    for (const auto& format : args.options.formats)
+    {
+        if (!ExportFeature::getFormatNames().contains(format) && format != "narrate" && format != "narrate-bin")
+        {
+            std::cerr << "Error: Unknown format '" << format.toStdString() << "'\n";
+            std::cerr << "Supported formats: " << ExportFeature::getFormatNames().joinIntoString(", ").toStdString()
+                      << ", narrate, narrate-bin\n";
+            return args;
+        }
+    }
+
+    if (args.options.formats.contains("narrate") && args.options.formats.contains("narrate-bin"))
+    {
+        std::cerr << "Error: narrate and narrate-bin would write the same file\n";
         return args;
     }
 
@@ -164,14 +427,270 @@ CommandLineArgs parseArguments(int argc, char* argv[])
     return args;
 }
 
-bool loadProject(const juce::File& inputFile, Narrate::NarrateProject& project)
+int runBatch(int argc, char* argv[])
 {
-    // Try to load as native Narrate project first
-    if (inputFile.hasFileExtension(".narrate"))
+    auto args = parseBatchArguments(argc, argv);
+    if (!args.valid)
+        return 1;
+
+    // Collect inputs; a missing input is reported but doesn't stop the others
+    juce::Array<juce::File> inputs;
+    juce::StringArray inputErrors;
+
+    for (const auto& input : args.inputs)
     {
-        if (project.loadFromFile(inputFile))
+        juce::String error;
+        if (!BatchConverter::addInputs(input, juce::File::getCurrentWorkingDirectory(), args.recursive, inputs, error))
+            inputErrors.add(error);
+    }
+
+    for (const auto& manifest : args.manifests)
+        BatchConverter::addManifestInputs(juce::File::getCurrentWorkingDirectory().getChildFile(manifest),
+                                          args.recursive, inputs, inputErrors);
+
+    for (const auto& error : inputErrors)
+        std::cerr << "Error: " << error.toStdString() << "\n";
+
+    if (inputs.isEmpty())
+    {
+        std::cerr << "Error: No input files to convert\n";
+        return 1;
+    }
+
+    if (args.options.outputDirectory.createDirectory().failed())
+    {
+        std::cerr << "Error: Could not create output directory: "
+                  << args.options.outputDirectory.getFullPathName().toStdString() << "\n";
+        return 1;
+    }
+
+    std::cout << "Converting " << inputs.size() << " files to " << args.options.formats.joinIntoString(", ").toStdString()
+              << " in " << args.options.outputDirectory.getFullPathName().toStdString() << "\n" << std::flush;
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+    int numDone = 0;
+
+    // One line per file as it completes, flushed so progress can be followed from a pipe
+    auto results = BatchConverter::run(inputs, args.options, [&](const BatchConverter::Result& result)
+    {
+        ++numDone;
+        std::cout << "[" << numDone << "/" << inputs.size() << "] ";
+
+        if (result.succeeded)
+            std::cout << "ok   " << result.input.getFullPathName().toStdString() << " (" << result.numClips << " clips, "
+                      << juce::String(result.milliseconds, 1).toStdString() << " ms)\n";
+        else
+            std::cout << "FAIL " << result.input.getFullPathName().toStdString() << ": " << result.error.toStdString() << "\n";
+
+        std::cout << std::flush;
+    });
+
+    const auto elapsedSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+    int numSucceeded = 0;
+    juce::int64 totalClips = 0;
+    juce::StringArray failures;
+
+    for (const auto& result : results)
+    {
+        if (result.succeeded)
+        {
+            ++numSucceeded;
+            totalClips += result.numClips;
+        }
+        else
         {
-            std::cout << "Loaded Narrate project: " << inputFile.getFileNameWithoutExtension().toStdString() << "\n";
+            failures.add(result.input.getFullPathName() + ": " + result.error);
+        }
+    }
+
+    std::cout << "\nBatch summary\n";
+    std::cout << "  Files:     " << results.size() << "\n";
+    std::cout << "  Converted: " << numSucceeded << "\n";
+    std::cout << "  Failed:    " << failures.size() + inputErrors.size() << "\n";
+    std::cout << "  Clips:     " << totalClips << "\n";
+    std::cout << "  Elapsed:   " << juce::String(elapsedSeconds, 2).toStdString() << " s ("
+              << juce::String(elapsedSeconds > 0.0 ? results.size() / elapsedSeconds : 0.0, 1).toStdString() << " files/s)\n";
+
+    if (!failures.isEmpty() || !inputErrors.isEmpty())
+    {
+        std::cerr << "\nFailed:\n";
+        for (const auto& error : inputErrors)
+            std::cerr << "  " << error.toStdString() << "\n";
+        for (const auto& failure : failures)
+            std::cerr << "  " << failure.toStdString() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+int runBench(int argc, char* argv[])
+{
+    BenchmarkRunner::Workload workload;
+    auto workingDirectory = juce::File::getSpecialLocation(juce::File::tempDirectory);
+    juce::File reportFile;
+
+    for (int argIndex = 2; argIndex < argc; ++argIndex)
+    {
+        juce::String arg(argv[argIndex]);
+        const bool hasValue = argIndex + 1 < argc;
+
+        if (arg == "--help" || arg == "-h")
+        {
+            printUsage(juce::File(argv[0]).getFileName());
+            return 0;
+        }
+
+        if (arg == "--clips" && hasValue)
+            workload.numClips = juce::String(argv[++argIndex]).getIntValue();
+        else if (arg == "--words" && hasValue)
+            workload.wordsPerClip = juce::String(argv[++argIndex]).getIntValue();
+        else if (arg == "--formatting" && hasValue)
+            workload.formattingDensity = juce::String(argv[++argIndex]).getDoubleValue();
+        else if (arg == "--seed" && hasValue)
+            workload.seed = juce::String(argv[++argIndex]).getLargeIntValue();
+        else if (arg == "--repeat" && hasValue)
+            workload.numRepeats = juce::String(argv[++argIndex]).getIntValue();
+        else if (arg == "--dir" && hasValue)
+            workingDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++argIndex]);
+        else if (arg == "--output" && hasValue)
+            reportFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++argIndex]);
+        else
+        {
+            std::cerr << "Error: Unknown argument '" << arg.toStdString() << "'\n";
+            return 1;
+        }
+    }
+
+    if (workload.numClips < 1 || workload.wordsPerClip < 1 || workload.numRepeats < 1
+        || workload.formattingDensity < 0.0 || workload.formattingDensity > 1.0)
+    {
+        std::cerr << "Error: --clips, --words and --repeat need positive numbers, --formatting a value from 0 to 1\n";
+        return 1;
+    }
+
+    if (workingDirectory.createDirectory().failed())
+    {
+        std::cerr << "Error: Could not create directory: " << workingDirectory.getFullPathName().toStdString() << "\n";
+        return 1;
+    }
+
+    // Progress goes to stderr, so stdout holds only the report
+    std::cerr << "Benchmarking " << workload.numClips << " clips x " << workload.wordsPerClip << " words, "
+              << workload.numRepeats << " runs per stage\n";
+
+    const auto results = BenchmarkRunner::run(workload, workingDirectory, [](const BenchmarkRunner::StageResult& result)
+    {
+        std::cerr << "  " << result.name.paddedRight(' ', 16).toStdString()
+                  << (result.succeeded ? juce::String(result.fastestMs, result.fastestMs < 1.0 ? 3 : 1) + " ms" : juce::String("FAILED")).toStdString() << "\n";
+    });
+
+    bool reportWritten = false;
+
+    if (reportFile != juce::File())
+    {
+        juce::FileOutputStream output(reportFile);
+        reportWritten = output.openedOk() && output.setPosition(0) && output.truncate().wasOk()
+                        && BenchmarkRunner::writeReport(workload, results, output);
+    }
+    else
+    {
+        StandardOutputStream output;
+        reportWritten = BenchmarkRunner::writeReport(workload, results, output);
+        output.flush();
+        reportWritten = reportWritten && !output.failed();
+    }
+
+    if (!reportWritten)
+    {
+        std::cerr << "Error: Could not write the report\n";
+        return 1;
+    }
+
+    for (const auto& result : results)
+        if (!result.succeeded)
+            return 1;
+
+    return 0;
+}
+
+// Status messages; they go to stderr when the converted output is written to stdout
+std::ostream* statusOutput = &std::cout;
+
+std::ostream& status()
+{
+    return *statusOutput;
+}
+
+// True if the start of a stream is a Narrate project, XML or binary
+bool isNarrateProjectData(std::string_view prefix)
+{
+    if (Narrate::NarrateBinaryFormat::isBinaryProject(prefix.data(), prefix.size()))
+        return true;
+
+    if (prefix.substr(0, 3) == "\xEF\xBB\xBF")
+        prefix.remove_prefix(3);
+
+    const auto firstNonSpace = prefix.find_first_not_of(" \t\r\n");
+    if (firstNonSpace == std::string_view::npos)
+        return false;
+
+    prefix.remove_prefix(firstNonSpace);
+    return prefix.substr(0, 5) == "<?xml" || prefix.substr(0, 15) == "<NarrateProject";
+}
+
+bool loadProjectFromStream(juce::InputStream& input, bool isBinary, Narrate::NarrateProject& project)
+{
+    // The binary container is read from memory; XML is parsed as it streams in
+    if (isBinary)
+    {
+        juce::MemoryBlock data;
+        input.readIntoMemoryBlock(data);
+        return Narrate::NarrateBinaryFormat::read(data.getData(), data.getSize(), project);
+    }
+
+    return Narrate::NarrateXmlReader::read(input, project);
+}
+
+bool loadProject(const CommandLineArgs& args, Narrate::NarrateProject& project)
+{
+    // Project files are loaded in place (the binary container is memory-mapped)
+    if (!args.inputIsStdin && args.fromFormat.isEmpty() && args.inputFile.hasFileExtension(".narrate"))
+    {
+        if (project.loadFromFile(args.inputFile))
+        {
+            status() << "Loaded Narrate project: " << args.inputFile.getFileNameWithoutExtension().toStdString() << "\n";
+            return true;
+        }
+        std::cerr << "Error: Failed to load Narrate project\n";
+        return false;
+    }
+
+    std::unique_ptr<juce::InputStream> input;
+    if (args.inputIsStdin)
+        input = std::make_unique<StandardInputStream>();
+    else
+        input = args.inputFile.createInputStream();
+
+    if (input == nullptr)
+    {
+        std::cerr << "Error: Could not open input\n";
+        return false;
+    }
+
+    // Detect the format from the first few KB; the import continues from the same stream,
+    // so stdin and other pipes are read once, front to back
+    auto prefix = TextImportSource::readPrefix(*input, TextImportSource::detectionPrefixSize);
+    const bool isBinaryProject = Narrate::NarrateBinaryFormat::isBinaryProject(prefix.data(), prefix.size());
+    const bool isProject = args.fromFormat == "narrate" || (args.fromFormat.isEmpty() && isNarrateProjectData(prefix));
+    auto stream = std::make_unique<PrefixedInputStream>(std::move(prefix), std::move(input));
+
+    if (isProject)
+    {
+        if (loadProjectFromStream(*stream, isBinaryProject, project))
+        {
+            status() << "Loaded Narrate project" << (isBinaryProject ? " (binary)" : "") << "\n";
             return true;
         }
         std::cerr << "Error: Failed to load Narrate project\n";
@@ -181,31 +700,22 @@ bool loadProject(const juce::File& inputFile, Narrate::NarrateProject& project)
     // Otherwise, try to import from subtitle format
     StandaloneImportFeature importer;
 
-    // Auto-detect format
-    juce::String detectedFormat;
-    if (!importer.detectFormat(inputFile, detectedFormat))
+    auto source = importer.openForImport(std::move(stream), args.fromFormat, args.inputFile);
+    if (source == nullptr)
     {
         std::cerr << "Error: Could not detect input file format\n";
         return false;
     }
 
-    std::cout << "Detected format: " << detectedFormat.toStdString() << "\n";
+    const auto detectedFormat = source->getFormat();
+    status() << (args.fromFormat.isEmpty() ? "Detected format: " : "Input format: ") << detectedFormat.toStdString() << "\n";
 
     // Import based on detected format
-    bool success = false;
-
-    if (detectedFormat == "srt")
-        success = importer.importSRT(inputFile, project);
-    else if (detectedFormat == "vtt")
-        success = importer.importWebVTT(inputFile, project);
-    else if (detectedFormat == "json")
-        success = importer.importJSON(inputFile, project);
-    else if (detectedFormat == "txt")
-        success = importer.importPlainText(inputFile, project);
+    bool success = importer.importFromSource(*source, project);
 
     if (success)
     {
-        std::cout << "Imported " << project.getNumClips() << " clips from " << detectedFormat.toStdString() << " file\n";
+        status() << "Imported " << project.getNumClips() << " clips from " << detectedFormat.toStdString() << " file\n";
         return true;
     }
 
@@ -213,22 +723,35 @@ bool loadProject(const juce::File& inputFile, Narrate::NarrateProject& project)
     return false;
 }
 
-bool exportProject(Narrate::NarrateProject& project, const juce::File& outputFile, const juce::String& format)
+bool exportProject(Narrate::NarrateProject& project, const juce::File& outputFile, const juce::String& format,
+                   ExportFeature::CueMode cueMode)
 {
     // Handle native Narrate format
     if (format == "narrate")
     {
         if (project.saveToFile(outputFile))
         {
-            std::cout << "Saved Narrate project to: " << outputFile.getFullPathName().toStdString() << "\n";
+            status() << "Saved Narrate project to: " << outputFile.getFullPathName().toStdString() << "\n";
             return true;
         }
         std::cerr << "Error: Failed to save Narrate project\n";
         return false;
     }
 
+    if (format == "narrate-bin")
+    {
+        if (project.saveToBinaryFile(outputFile))
+        {
+            status() << "Saved binary Narrate project to: " << outputFile.getFullPathName().toStdString() << "\n";
+            return true;
+        }
+        std::cerr << "Error: Failed to save binary Narrate project\n";
+        return false;
+    }
+
     // Export to subtitle format
     StandaloneExportFeature exporter;
+    exporter.setCueMode(cueMode);
     bool success = false;
 
     if (format == "srt")
@@ -244,7 +767,7 @@ bool exportProject(Narrate::NarrateProject& project, const juce::File& outputFil
 
     if (success)
     {
-        std::cout << "Exported to " << format.toStdString() << ": " << outputFile.getFullPathName().toStdString() << "\n";
+        status() << "Exported to " << format.toStdString() << ": " << outputFile.getFullPathName().toStdString() << "\n";
         return true;
     }
 
@@ -252,11 +775,82 @@ bool exportProject(Narrate::NarrateProject& project, const juce::File& outputFil
     return false;
 }
 
+bool exportProjectToFormats(const Narrate::NarrateProject& project, const juce::File& outputBase, const juce::StringArray& formats,
+                            ExportFeature::CueMode cueMode)
+{
+    // One target per format, named after the output with the format as extension
+    std::vector<ExportTarget> targets;
+    for (const auto& format : formats)
+        targets.push_back({ format, outputBase.withFileExtension(format) });
+
+    StandaloneExportFeature exporter;
+    exporter.setCueMode(cueMode);
+    const bool success = exporter.exportFormats(project, targets);
+
+    for (const auto& target : targets)
+    {
+        if (target.succeeded)
+            status() << "Exported to " << target.format.toStdString() << ": " << target.file.getFullPathName().toStdString() << "\n";
+        else
+            std::cerr << "Error: Export to " << target.format.toStdString() << " format failed\n";
+    }
+
+    return success;
+}
+
+bool exportProjectToStdout(const Narrate::NarrateProject& project, const juce::String& format, ExportFeature::CueMode cueMode)
+{
+    StandardOutputStream output;
+    StandaloneExportFeature exporter;
+    exporter.setCueMode(cueMode);
+    bool success = false;
+
+    // The exporters stream through their own buffered writer; nothing touches disk
+    if (format == "narrate")
+    {
+        if (auto xml = project.toXml())
+        {
+            xml->writeTo(output, juce::XmlElement::TextFormat().singleLine());
+            success = true;
+        }
+    }
+    else if (format == "narrate-bin")
+        success = Narrate::NarrateBinaryFormat::write(project, output);
+    else if (format == "srt")
+        success = exporter.exportSRT(project, output);
+    else if (format == "vtt")
+        success = exporter.exportWebVTT(project, output);
+    else if (format == "txt")
+        success = exporter.exportPlainText(project, output);
+    else if (format == "json")
+        success = exporter.exportJSON(project, output);
+    else if (format == "csv")
+        success = exporter.exportCSV(project, output);
+
+    output.flush();
+
+    if (success && !output.failed())
+    {
+        status() << "Exported to " << format.toStdString() << ": stdout\n";
+        return true;
+    }
+
+    std::cerr << "Error: Export to " << format.toStdString() << " on stdout failed\n";
+    return false;
+}
+
 int main(int argc, char* argv[])
 {
     // Initialize JUCE
     juce::initialiseJuce_GUI();
 
+    if (argc > 1 && (juce::String(argv[1]) == "batch" || juce::String(argv[1]) == "bench"))
+    {
+        const int exitCode = juce::String(argv[1]) == "batch" ? runBatch(argc, argv) : runBench(argc, argv);
+        juce::shutdownJuce_GUI();
+        return exitCode;
+    }
+
     // Parse command line arguments
     CommandLineArgs args = parseArguments(argc, argv);
     if (!args.valid)
@@ -265,22 +859,35 @@ int main(int argc, char* argv[])
         return 1;
     }
 
+    // Keep stdout for the converted output
+    if (args.outputIsStdout)
+        statusOutput = &std::cerr;
+
     // Load/import project
     Narrate::NarrateProject project;
-    if (!loadProject(args.inputFile, project))
+    if (!loadProject(args, project))
     {
         juce::shutdownJuce_GUI();
         return 1;
     }
 
     // Export project
-    if (!exportProject(project, args.outputFile, args.format))
+    bool exported = false;
+
+    if (args.outputIsStdout)
+        exported = exportProjectToStdout(project, args.format, args.cueMode);
+    else if (args.formats.isEmpty())
+        exported = exportProject(project, args.outputFile, args.format, args.cueMode);
+    else
+        exported = exportProjectToFormats(project, args.outputFile, args.formats, args.cueMode);
+
+    if (!exported)
     {
         juce::shutdownJuce_GUI();
         return 1;
     }
 
-    std::cout << "\nConversion successful!\n";
+    status() << "\nConversion successful!\n";
 
     // Cleanup
     juce::shutdownJuce_GUI();
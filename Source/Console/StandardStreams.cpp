@@ -0,0 +1,78 @@
+#include "StandardStreams.h"
+
+#if JUCE_WINDOWS
+ #include <fcntl.h>
+ #include <io.h>
+#endif
+
+// ============================================================================
+// StandardInputStream
+// ============================================================================
+
+StandardInputStream::StandardInputStream()
+{
+   #if JUCE_WINDOWS
+    _setmode(_fileno(stdin), _O_BINARY);
+   #endif
+}
+
+bool StandardInputStream::isExhausted()
+{
+    return std::feof(stdin) != 0 || std::ferror(stdin) != 0;
+}
+
+int StandardInputStream::read(void* destBuffer, int maxBytesToRead)
+{
+    if (maxBytesToRead <= 0)
+        return 0;
+
+    const auto numRead = std::fread(destBuffer, 1, (size_t) maxBytesToRead, stdin);
+    position += (juce::int64) numRead;
+    return (int) numRead;
+}
+
+bool StandardInputStream::setPosition(juce::int64 newPosition)
+{
+    if (newPosition < position)
+        return false;
+
+    skipNextBytes(newPosition - position);
+    return position == newPosition;
+}
+
+// ============================================================================
+// StandardOutputStream
+// ============================================================================
+
+StandardOutputStream::StandardOutputStream()
+{
+   #if JUCE_WINDOWS
+    _setmode(_fileno(stdout), _O_BINARY);
+   #endif
+}
+
+StandardOutputStream::~StandardOutputStream()
+{
+    flush();
+}
+
+void StandardOutputStream::flush()
+{
+    if (std::fflush(stdout) != 0)
+        writeFailed = true;
+}
+
+bool StandardOutputStream::write(const void* dataToWrite, size_t numberOfBytes)
+{
+    if (writeFailed)
+        return false;
+
+    if (std::fwrite(dataToWrite, 1, numberOfBytes, stdout) != numberOfBytes)
+    {
+        writeFailed = true;
+        return false;
+    }
+
+    position += (juce::int64) numberOfBytes;
+    return true;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cstdio>
+
+/**
+ * StandardInputStream / StandardOutputStream
+ *
+ * juce::InputStream and juce::OutputStream over the process's stdin and stdout,
+ * so narrate-console can read and write "-" in a shell pipeline. Both switch the
+ * handle to binary mode, so bytes pass through unchanged on every platform.
+ */
+class StandardInputStream : public juce::InputStream
+{
+public:
+    StandardInputStream();
+
+    // A pipe's length isn't known up front
+    juce::int64 getTotalLength() override { return -1; }
+    juce::int64 getPosition() override { return position; }
+    bool isExhausted() override;
+    int read(void* destBuffer, int maxBytesToRead) override;
+
+    // Only forward seeks are supported, by reading and discarding
+    bool setPosition(juce::int64 newPosition) override;
+
+private:
+    juce::int64 position = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(StandardInputStream)
+};
+
+class StandardOutputStream : public juce::OutputStream
+{
+public:
+    StandardOutputStream();
+    ~StandardOutputStream() override;
+
+    void flush() override;
+    bool setPosition(juce::int64) override { return false; }
+    juce::int64 getPosition() override { return position; }
+    bool write(const void* dataToWrite, size_t numberOfBytes) override;
+
+    // True if a write failed, e.g. because the reading end of the pipe was closed
+    bool failed() const { return writeFailed; }
+
+private:
+    juce::int64 position = 0;
+    bool writeFailed = false;
+
+    JUCE_DECLARE_NON_COPYABLE(StandardOutputStream)
+};
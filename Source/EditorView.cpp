@@ -93,6 +93,10 @@ EditorView::EditorView(NarrateAudioProcessor* processor)
 
     previewButton.onClick = [this]
     {
+        // Apply unsaved edits to the selected clip so the preview shows them
+        if (selectedClipIndex >= 0 && selectedClipIndex < project.getNumClips())
+            updateClipFromUI();
+
         if (onPreviewClicked)
             onPreviewClicked();
     };
@@ -107,6 +111,13 @@ EditorView::EditorView(NarrateAudioProcessor* processor)
     // Show panels based on feature availability
     audioPlaybackPanel.setVisible(audioProcessor->getAudioPlayback().isAvailable());
     exportPanel.setVisible(audioProcessor->getExportFeature().isAvailable());
+    exportPanel.getProjectToExport = [this]() -> const Narrate::NarrateProject&
+    {
+        // Include unsaved edits to the selected clip, as saving does
+        if (selectedClipIndex >= 0 && selectedClipIndex < project.getNumClips())
+            updateClipFromUI();
+        return project;
+    };
     dawSyncPanel.setVisible(audioProcessor->getDawSync().isAvailable());
 
     // Select first clip
@@ -201,7 +212,7 @@ void EditorView::resized()
     if (exportPanel.isVisible())
     {
         toolbar.removeFromRight(5);
-        exportPanel.setBounds(toolbar.removeFromRight(200));
+        exportPanel.setBounds(toolbar.removeFromRight(425));
     }
 
     // Add spacing after toolbar
@@ -311,8 +322,24 @@ void EditorView::selectedRowsChanged(int lastRowSelected)
     {
         // Save previous clip before switching
         if (selectedClipIndex >= 0 && selectedClipIndex < project.getNumClips())
+        {
+            const int previousIndex = selectedClipIndex;
             updateClipFromUI();
 
+            // A new start time may have moved the saved clip past the clicked row,
+            // shifting that row's clip by one
+            const int savedIndex = selectedClipIndex;
+            if (savedIndex != previousIndex)
+            {
+                if (previousIndex < lastRowSelected && lastRowSelected <= savedIndex)
+                    --lastRowSelected;
+                else if (savedIndex <= lastRowSelected && lastRowSelected < previousIndex)
+                    ++lastRowSelected;
+
+                selectRowQuietly(lastRowSelected);
+            }
+        }
+
         selectedClipIndex = lastRowSelected;
         updateUIFromClip();
     }
@@ -343,6 +370,7 @@ void EditorView::addClipClicked()
     }
 
     project.addClip(newClip);
+    projectChanged();
     clipListBox.updateContent();
     clipListBox.selectRow(project.getNumClips() - 1);
 }
@@ -363,6 +391,7 @@ void EditorView::removeClipClicked()
             project.removeClip(clipIndex);
     }
 
+    projectChanged();
     clipListBox.updateContent();
 
     // Select previous clip or first clip
@@ -396,6 +425,7 @@ void EditorView::recalculateTimelineClicked()
 
     // Recalculate the timeline to remove gaps
     project.recalculateTimeline();
+    projectChanged();
 
     // Refresh UI
     clipListBox.updateContent();
@@ -407,6 +437,7 @@ void EditorView::newProjectClicked()
 {
     project = Narrate::NarrateProject();
     project.setProjectName("New Project");
+    projectChanged();
     selectedClipIndex = -1;
     clipListBox.updateContent();
     startTimeEditor.clear();
@@ -429,6 +460,8 @@ void EditorView::loadProjectClicked()
 
         if (project.loadFromFile(file))
         {
+            projectChanged();
+
             // Reset selection to avoid writing old UI data into new project
             selectedClipIndex = -1;
 
@@ -499,21 +532,12 @@ void EditorView::importProjectClicked()
             auto& importFeature = audioProcessor->getImportFeature();
             Narrate::NarrateProject importedProject;
 
-            // Detect format and import accordingly
-            juce::String detectedFormat;
+            // Detect format from the start of the file and import from the same handle
             bool importSuccess = false;
 
-            if (importFeature.detectFormat(file, detectedFormat))
+            if (auto source = importFeature.openForImport(file))
             {
-                // Try importing with detected format
-                if (detectedFormat == "srt")
-                    importSuccess = importFeature.importSRT(file, importedProject, progressCallback);
-                else if (detectedFormat == "vtt" || detectedFormat == "webvtt")
-                    importSuccess = importFeature.importWebVTT(file, importedProject, progressCallback);
-                else if (detectedFormat == "json")
-                    importSuccess = importFeature.importJSON(file, importedProject, progressCallback);
-                else if (detectedFormat == "txt" || detectedFormat == "text")
-                    importSuccess = importFeature.importPlainText(file, importedProject, progressCallback);
+                importSuccess = importFeature.importFromSource(*source, importedProject, progressCallback);
             }
             else
             {
@@ -543,6 +567,7 @@ void EditorView::importProjectClicked()
                 {
                     // Replace current project with imported project
                     project = importedProject;
+                    projectChanged();
 
                     // Reset selection to avoid writing old UI data into new project
                     selectedClipIndex = -1;
@@ -600,7 +625,12 @@ void EditorView::updateClipFromUI()
     if (selectedClipIndex < 0 || selectedClipIndex >= project.getNumClips())
         return;
 
-    auto& clip = project.getClip(selectedClipIndex);
+    // Nothing to save while the editors still show what updateUIFromClip() put in them
+    const auto& savedClip = std::as_const(project).getClip(selectedClipIndex);
+    if (startTimeEditor.getText() == juce::String(savedClip.getStartTime(), 2)
+        && endTimeEditor.getText() == juce::String(savedClip.getEndTime(), 2)
+        && clipTextEditor.getText() == savedClip.getFullText())
+        return;
 
     // Update times
     double startTime = startTimeEditor.getText().getDoubleValue();
@@ -609,8 +639,9 @@ void EditorView::updateClipFromUI()
     if (endTime <= startTime)
         endTime = startTime + 1.0;
 
-    clip.setStartTime(startTime);
-    clip.setEndTime(endTime);
+    // A new start time can move the clip in the list; keep it selected
+    const int clipIndex = project.setClipTimes(selectedClipIndex, startTime, endTime);
+    auto& clip = project.getClip(clipIndex);
 
     // Update text
     clip.setText(clipTextEditor.getText());
@@ -625,7 +656,19 @@ void EditorView::updateClipFromUI()
             clip.getWord(i).relativeTime = i * timePerWord;
     }
 
-    clipListBox.repaintRow(selectedClipIndex);
+    if (clipIndex != selectedClipIndex)
+    {
+        selectedClipIndex = clipIndex;
+        clipListBox.updateContent();
+        selectRowQuietly(clipIndex);
+        clipListBox.repaint();
+    }
+    else
+    {
+        clipListBox.repaintRow(selectedClipIndex);
+    }
+
+    clipEdited();
 }
 
 void EditorView::updateUIFromClip()
@@ -659,14 +702,44 @@ void EditorView::autoSpaceWords()
     double duration = clip.getDuration();
     int numWords = clip.getNumWords();
 
+    bool changed = false;
+
     if (numWords > 0)
     {
         double timePerWord = duration / numWords;
         for (int i = 0; i < numWords; ++i)
-            clip.getWord(i).relativeTime = i * timePerWord;
+        {
+            auto& word = clip.getWord(i);
+            changed = changed || word.relativeTime != i * timePerWord;
+            word.relativeTime = i * timePerWord;
+        }
     }
 
     clipListBox.repaintRow(selectedClipIndex);
+
+    // Saving the UI above already spaced the words if anything else changed
+    if (changed)
+        clipEdited();
+}
+
+void EditorView::selectRowQuietly(int row)
+{
+    // Select without calling selectedRowsChanged(), which would save the clip again
+    juce::SparseSet<int> rows;
+    rows.addRange({ row, row + 1 });
+    clipListBox.setSelectedRows(rows, juce::dontSendNotification);
+}
+
+void EditorView::clipEdited()
+{
+    if (onClipEdited)
+        onClipEdited(selectedClipIndex);
+}
+
+void EditorView::projectChanged()
+{
+    if (onProjectChanged)
+        onProjectChanged();
 }
 
 Narrate::NarrateProject EditorView::createTestProject()
@@ -37,6 +37,13 @@ public:
     // Set a callback for when the Preview button is clicked
     std::function<void()> onPreviewClicked;
 
+    // Called after one clip was edited in place (times, text or word spacing), with its
+    // index in getProject() - which may differ from before if a new start time moved it
+    std::function<void(int clipIndex)> onClipEdited;
+
+    // Called when clips were added, removed or retimed together, or the project was replaced
+    std::function<void()> onProjectChanged;
+
 private:
     // ListBoxModel overrides
     int getNumRows() override;
@@ -56,6 +63,9 @@ private:
     void updateUIFromClip();
     void textChanged();
     void autoSpaceWords();
+    void selectRowQuietly(int row);
+    void clipEdited();
+    void projectChanged();
 
 private:
     NarrateAudioProcessor* audioProcessor;
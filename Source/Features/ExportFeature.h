@@ -2,6 +2,20 @@
 
 #include <juce_core/juce_core.h>
 #include "../NarrateDataModel.h"
+#include <vector>
+
+/**
+ * ExportTarget - One output of a multi-format export
+ *
+ * The format is named like ImportSource formats and the console's --format
+ * values: "srt", "vtt", "txt", "json" or "csv".
+ */
+struct ExportTarget
+{
+    juce::String format;
+    juce::File file;
+    bool succeeded = false;  // Set by ExportFeature::exportFormats()
+};
 
 /**
  * ExportFeature
@@ -15,6 +29,21 @@ class ExportFeature
 public:
     virtual ~ExportFeature() = default;
 
+    /**
+     * Cue granularity for SRT and WebVTT
+     * - Word: one cue per word (the default)
+     * - Clip: one cue per clip; WebVTT keeps word timing with inline <hh:mm:ss.mmm> tags,
+     *   SRT has the clip text only
+     */
+    enum class CueMode
+    {
+        Word,
+        Clip
+    };
+
+    // The format names exportFormats() accepts; each is also the file extension
+    static juce::StringArray getFormatNames() { return { "srt", "vtt", "txt", "json", "csv" }; }
+
     // Feature availability
     virtual bool isAvailable() const = 0;
 
@@ -27,6 +56,17 @@ public:
     virtual bool exportJSON(const Narrate::NarrateProject& project, const juce::File& outputFile) = 0;
     virtual bool exportCSV(const Narrate::NarrateProject& project, const juce::File& outputFile) = 0;
 
+    /**
+     * Export to several formats at once, walking the project a single time
+     * Each target's succeeded flag is set; a failed target does not stop the others.
+     * @return true if every target was written
+     */
+    virtual bool exportFormats(const Narrate::NarrateProject& project, std::vector<ExportTarget>& targets) = 0;
+
+    // Cue mode used by later SRT and WebVTT exports
+    virtual void setCueMode(CueMode mode) = 0;
+    virtual CueMode getCueMode() const = 0;
+
     // Format support queries
     virtual bool supportsSRT() const = 0;
     virtual bool supportsWebVTT() const = 0;
@@ -0,0 +1,127 @@
+#include "ExportWriter.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+ExportWriter::ExportWriter(juce::OutputStream& destination, size_t bufferSize)
+    : stream(destination), buffer(juce::jmax(bufferSize, (size_t) 256))
+{
+}
+
+ExportWriter::~ExportWriter()
+{
+    flushBuffer();
+}
+
+void ExportWriter::flushBuffer()
+{
+    if (used > 0 && !stream.write(buffer.data(), used))
+        writeFailed = true;
+
+    used = 0;
+}
+
+void ExportWriter::writeLarge(std::string_view text)
+{
+    // Fill the buffer up, then pass anything that is still too big straight through
+    const size_t head = buffer.size() - used;
+    std::memcpy(buffer.data() + used, text.data(), head);
+    used += head;
+    text.remove_prefix(head);
+    flushBuffer();
+
+    if (text.size() >= buffer.size())
+    {
+        if (!stream.write(text.data(), text.size()))
+            writeFailed = true;
+        return;
+    }
+
+    std::memcpy(buffer.data(), text.data(), text.size());
+    used = text.size();
+}
+
+void ExportWriter::writeInt(juce::int64 value)
+{
+    char* start = reserve(24);
+    auto result = std::to_chars(start, start + 24, value);
+    commit((size_t) (result.ptr - start));
+}
+
+namespace
+{
+    template <typename FloatType>
+    char* formatNumber(char* start, FloatType value)
+    {
+        if (!std::isfinite(value) || value == 0)
+            value = 0; // Also drops the sign of -0.0
+
+        char* end = std::to_chars(start, start + 32, value).ptr;
+
+        // Whole numbers keep a decimal point so they read back as decimals
+        if (std::find_if(start, end, [](char c) { return c == '.' || c == 'e'; }) == end)
+        {
+            *end++ = '.';
+            *end++ = '0';
+        }
+
+        return end;
+    }
+
+    char* writeTwoDigits(char* out, int value)
+    {
+        out[0] = (char) ('0' + value / 10);
+        out[1] = (char) ('0' + value % 10);
+        return out + 2;
+    }
+}
+
+void ExportWriter::writeNumber(double value)
+{
+    // The longest shortest-form double is 24 characters, plus ".0"
+    char* start = reserve(34);
+    commit((size_t) (formatNumber(start, value) - start));
+}
+
+void ExportWriter::writeNumber(float value)
+{
+    char* start = reserve(34);
+    commit((size_t) (formatNumber(start, value) - start));
+}
+
+void ExportWriter::writeTimestamp(double seconds, char millisecondSeparator)
+{
+    // Rounded once to whole milliseconds; everything after is integer arithmetic.
+    // Times beyond ~30,000 years are clamped so the conversion cannot overflow.
+    const juce::int64 totalMillis = seconds > 0.0 ? std::llround(juce::jmin(seconds, 1.0e12) * 1000.0) : 0;
+
+    const auto hours = totalMillis / 3600000;
+    const auto minutes = (int) (totalMillis / 60000 % 60);
+    const auto secs = (int) (totalMillis / 1000 % 60);
+    const auto millis = (int) (totalMillis % 1000);
+
+    char* start = reserve(40);
+    char* out = start;
+
+    if (hours < 100)
+        out = writeTwoDigits(out, (int) hours);
+    else
+        out = std::to_chars(out, out + 20, hours).ptr;
+
+    *out++ = ':';
+    out = writeTwoDigits(out, minutes);
+    *out++ = ':';
+    out = writeTwoDigits(out, secs);
+    *out++ = millisecondSeparator;
+    *out++ = (char) ('0' + millis / 100);
+    out = writeTwoDigits(out, millis % 100);
+
+    commit((size_t) (out - start));
+}
+
+bool ExportWriter::flush()
+{
+    flushBuffer();
+    stream.flush();
+    return !writeFailed;
+}
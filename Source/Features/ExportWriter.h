@@ -0,0 +1,112 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+/**
+ * ExportWriter - Buffered text sink for the exporters
+ *
+ * Collects output in a fixed-size buffer and hands it to an OutputStream
+ * (a FileOutputStream, a MemoryOutputStream, a pipe...) one full buffer at a
+ * time, so an export holds at most one buffer of text however large the
+ * project is. The small writes the exporters make per field are plain memcpys
+ * into the buffer.
+ *
+ * Line breaks are written as "\r\n", the line ending File::replaceWithText()
+ * used for the exports before they were streamed.
+ *
+ * Numbers and timestamps are formatted straight into the buffer with
+ * std::to_chars and fixed-width digit writes, without temporary strings.
+ * Neither depends on the locale or the platform's printf, so the same
+ * project always exports to the same bytes.
+ */
+class ExportWriter
+{
+public:
+    static constexpr size_t defaultBufferSize = 64 * 1024;
+
+    explicit ExportWriter(juce::OutputStream& destination, size_t bufferSize = defaultBufferSize);
+    ~ExportWriter();
+
+    void write(std::string_view text)
+    {
+        if (text.size() > buffer.size() - used)
+        {
+            writeLarge(text);
+            return;
+        }
+
+        std::memcpy(buffer.data() + used, text.data(), text.size());
+        used += text.size();
+    }
+
+    void write(char c)
+    {
+        if (used == buffer.size())
+            flushBuffer();
+
+        buffer[used++] = c;
+    }
+
+    // The string's UTF-8 bytes, without copying the string
+    void write(const juce::String& text)
+    {
+        write(std::string_view(text.toRawUTF8(), text.getNumBytesAsUTF8()));
+    }
+
+    void write(const char* text) { write(std::string_view(text)); }
+
+    void writeInt(juce::int64 value);
+
+    /**
+     * Shortest text that reads back as exactly the same value, with ".0" added
+     * to whole numbers (1.0, 2.5, 0.1, 1e+20). Infinities and NaN have no JSON
+     * or CSV form and are written as 0.0, as is -0.0.
+     */
+    void writeNumber(double value);
+    void writeNumber(float value);
+
+    /**
+     * HH:MM:SS<separator>mmm, rounded to the nearest millisecond (1.9999 is
+     * 00:00:02.000). Hours grow past two digits if needed; negative times are
+     * written as zero.
+     */
+    void writeTimestamp(double seconds, char millisecondSeparator);
+
+    void newLine() { write(std::string_view("\r\n", 2)); }
+
+    /**
+     * Room for at least numBytes in the buffer, for callers that format in place.
+     * Write the bytes at the returned pointer, then call commit().
+     */
+    char* reserve(size_t numBytes)
+    {
+        if (numBytes > buffer.size() - used)
+            flushBuffer();
+
+        return buffer.data() + used;
+    }
+
+    void commit(size_t numBytes) { used += numBytes; }
+
+    /**
+     * Pass everything written so far on to the stream and flush it
+     * @return false if any write to the stream failed
+     */
+    bool flush();
+
+    bool failed() const { return writeFailed; }
+
+private:
+    void flushBuffer();
+    void writeLarge(std::string_view text);
+
+    juce::OutputStream& stream;
+    std::vector<char> buffer;
+    size_t used = 0;
+    bool writeFailed = false;
+
+    JUCE_DECLARE_NON_COPYABLE(ExportWriter)
+};
@@ -3,6 +3,36 @@
 #include <juce_core/juce_core.h>
 #include "../NarrateDataModel.h"
 #include <functional>
+#include <memory>
+
+/**
+ * ImportSource - A file opened for import, with its detected format
+ *
+ * Created by ImportFeature::openForImport(), which reads only the first few KB
+ * of the file (or stream) to detect the format. The bytes read for detection are kept, so
+ * importing through ImportFeature::importFromSource() reads the file once.
+ * A source can be imported from once.
+ */
+class ImportSource
+{
+public:
+    virtual ~ImportSource() = default;
+
+    const juce::File& getFile() const { return file; }
+
+    // "srt", "vtt", "json" or "txt"
+    const juce::String& getFormat() const { return format; }
+
+protected:
+    ImportSource(const juce::File& sourceFile, const juce::String& detectedFormat)
+        : file(sourceFile), format(detectedFormat) {}
+
+private:
+    juce::File file;
+    juce::String format;
+
+    JUCE_DECLARE_NON_COPYABLE(ImportSource)
+};
 
 /**
  * ImportFeature - Abstract interface for importing subtitle/transcript files
@@ -36,6 +66,37 @@ public:
      */
     virtual bool detectFormat(const juce::File& file, juce::String& outFormat) const = 0;
 
+    /**
+     * Opens a file and detects its format from the first few KB.
+     *
+     * @param file The file to open
+     * @return The opened source, or nullptr if the file is missing, empty or unreadable
+     */
+    virtual std::unique_ptr<ImportSource> openForImport(const juce::File& file) const = 0;
+
+    /**
+     * Opens a stream for import, such as a pipe or stdin. The stream doesn't need to be
+     * seekable or know its length; the format is detected from its first few KB.
+     *
+     * @param input The stream to import from (taken over by the source)
+     * @param format "srt", "vtt", "json" or "txt" to use instead of detecting it, or empty
+     * @param file The file the stream reads, if any; names the imported project
+     * @return The opened source, or nullptr if the stream is empty or the format is unknown
+     */
+    virtual std::unique_ptr<ImportSource> openForImport(std::unique_ptr<juce::InputStream> input, const juce::String& format = {},
+                                                        const juce::File& file = {}) const = 0;
+
+    /**
+     * Imports from a source returned by openForImport(), using its detected format.
+     * Continues from the bytes read during detection instead of reopening the file.
+     *
+     * @param source A source from this feature's openForImport() (consumed)
+     * @param outProject The project to populate with imported data (will be cleared first)
+     * @param progressCallback Optional callback for progress updates (progress, message) -> continue?
+     * @return true if import succeeded, false otherwise (including cancellation)
+     */
+    virtual bool importFromSource(ImportSource& source, Narrate::NarrateProject& outProject, ProgressCallback progressCallback = nullptr) = 0;
+
     // Import operations - each returns true on success, false on failure
     /**
      * Import from SubRip (.srt) format
@@ -89,7 +150,6 @@ public:
     virtual bool supportsPlainText() const = 0;
     virtual bool supportsJSON() const = 0;
 
-protected:
     /**
      * Helper to parse timecode in various formats
      * Supports: HH:MM:SS,mmm (SRT) and HH:MM:SS.mmm (WebVTT)
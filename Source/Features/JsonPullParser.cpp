@@ -0,0 +1,402 @@
+#include "JsonPullParser.h"
+
+namespace
+{
+    bool isJsonWhitespace(int c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+    bool isDigit(int c) { return c >= '0' && c <= '9'; }
+
+    void appendUTF8(std::string& dest, juce::uint32 c)
+    {
+        if (c < 0x80)
+        {
+            dest += (char) c;
+        }
+        else if (c < 0x800)
+        {
+            dest += (char) (0xc0 | (c >> 6));
+            dest += (char) (0x80 | (c & 0x3f));
+        }
+        else if (c < 0x10000)
+        {
+            dest += (char) (0xe0 | (c >> 12));
+            dest += (char) (0x80 | ((c >> 6) & 0x3f));
+            dest += (char) (0x80 | (c & 0x3f));
+        }
+        else
+        {
+            dest += (char) (0xf0 | (c >> 18));
+            dest += (char) (0x80 | ((c >> 12) & 0x3f));
+            dest += (char) (0x80 | ((c >> 6) & 0x3f));
+            dest += (char) (0x80 | (c & 0x3f));
+        }
+    }
+
+    // -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+    bool isValidNumber(const std::string& text)
+    {
+        size_t i = 0;
+        const size_t size = text.size();
+
+        if (i < size && text[i] == '-')
+            ++i;
+
+        if (i >= size || !isDigit(text[i]))
+            return false;
+
+        if (text[i] == '0')
+            ++i;
+        else
+            while (i < size && isDigit(text[i]))
+                ++i;
+
+        if (i < size && text[i] == '.')
+        {
+            if (++i >= size || !isDigit(text[i]))
+                return false;
+            while (i < size && isDigit(text[i]))
+                ++i;
+        }
+
+        if (i < size && (text[i] == 'e' || text[i] == 'E'))
+        {
+            if (++i < size && (text[i] == '+' || text[i] == '-'))
+                ++i;
+            if (i >= size || !isDigit(text[i]))
+                return false;
+            while (i < size && isDigit(text[i]))
+                ++i;
+        }
+
+        return i == size;
+    }
+}
+
+JsonPullParser::JsonPullParser(juce::InputStream& source, size_t bufferSize)
+    : input(source), buffer(juce::jmax((size_t) 4, bufferSize))
+{
+    // Skip a UTF-8 byte order mark
+    if (peekChar() == 0xef)
+    {
+        if (bufferEnd - bufferPos >= 3
+            && (unsigned char) buffer[bufferPos + 1] == 0xbb
+            && (unsigned char) buffer[bufferPos + 2] == 0xbf)
+            bufferPos += 3;
+    }
+}
+
+bool JsonPullParser::refill()
+{
+    if (endOfInput)
+        return false;
+
+    bufferStartPosition += (juce::int64) bufferEnd;
+
+    auto numRead = input.read(buffer.data(), (int) buffer.size());
+    bufferPos = 0;
+    bufferEnd = (size_t) juce::jmax(0, numRead);
+
+    if (bufferEnd == 0)
+        endOfInput = true;
+
+    return bufferEnd > 0;
+}
+
+int JsonPullParser::peekChar()
+{
+    if (bufferPos >= bufferEnd && !refill())
+        return -1;
+
+    return (unsigned char) buffer[bufferPos];
+}
+
+int JsonPullParser::readChar()
+{
+    if (bufferPos >= bufferEnd && !refill())
+        return -1;
+
+    return (unsigned char) buffer[bufferPos++];
+}
+
+void JsonPullParser::skipWhitespace()
+{
+    while (isJsonWhitespace(peekChar()))
+        ++bufferPos;
+}
+
+JsonPullParser::Token JsonPullParser::fail(const juce::String& message)
+{
+    if (errorMessage.isEmpty())
+        errorMessage = message + " at byte " + juce::String(getPosition());
+
+    return Token::Error;
+}
+
+bool JsonPullParser::readUnicodeEscape(juce::uint32& codeUnit)
+{
+    codeUnit = 0;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        auto digit = juce::CharacterFunctions::getHexDigitValue((juce::juce_wchar) readChar());
+        if (digit < 0)
+            return false;
+
+        codeUnit = (codeUnit << 4) | (juce::uint32) digit;
+    }
+
+    return true;
+}
+
+bool JsonPullParser::readString()
+{
+    // The opening quote has been consumed
+    stringValue.clear();
+
+    for (;;)
+    {
+        if (bufferPos >= bufferEnd && !refill())
+            return false;
+
+        // Copy runs of plain characters straight from the buffer
+        const char* start = buffer.data() + bufferPos;
+        const char* end = buffer.data() + bufferEnd;
+        const char* p = start;
+
+        while (p < end && *p != '"' && *p != '\\' && (unsigned char) *p >= 0x20)
+            ++p;
+
+        stringValue.append(start, (size_t) (p - start));
+        bufferPos += (size_t) (p - start);
+
+        if (p == end)
+            continue;
+
+        auto c = readChar();
+
+        if (c == '"')
+            return true;
+
+        // Raw control characters must be escaped
+        if (c != '\\')
+            return false;
+
+        switch (readChar())
+        {
+            case '"':  stringValue += '"'; break;
+            case '\\': stringValue += '\\'; break;
+            case '/':  stringValue += '/'; break;
+            case 'b':  stringValue += '\b'; break;
+            case 'f':  stringValue += '\f'; break;
+            case 'n':  stringValue += '\n'; break;
+            case 'r':  stringValue += '\r'; break;
+            case 't':  stringValue += '\t'; break;
+
+            case 'u':
+            {
+                juce::uint32 code = 0;
+                if (!readUnicodeEscape(code))
+                    return false;
+
+                // Characters outside the BMP are written as a surrogate pair
+                if (code >= 0xd800 && code < 0xdc00 && peekChar() == '\\')
+                {
+                    ++bufferPos;
+                    juce::uint32 low = 0;
+
+                    if (readChar() != 'u' || !readUnicodeEscape(low))
+                        return false;
+
+                    if (low >= 0xdc00 && low < 0xe000)
+                    {
+                        code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+                    }
+                    else
+                    {
+                        appendUTF8(stringValue, 0xfffd);
+                        code = low;
+                    }
+                }
+
+                // Unpaired surrogates can't be encoded in UTF-8
+                appendUTF8(stringValue, code >= 0xd800 && code < 0xe000 ? 0xfffd : code);
+                break;
+            }
+
+            default:
+                return false;
+        }
+    }
+}
+
+JsonPullParser::Token JsonPullParser::readNumber()
+{
+    numberText.clear();
+
+    for (;;)
+    {
+        auto c = peekChar();
+        if (!(isDigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'))
+            break;
+
+        numberText += (char) c;
+        ++bufferPos;
+    }
+
+    if (!isValidNumber(numberText))
+        return fail("Malformed number \"" + juce::String(numberText) + "\"");
+
+    // Small integers (indices, flags) don't need the general parser
+    const bool negative = numberText[0] == '-';
+
+    if (numberText.size() <= 16 && numberText.find_first_of(".eE") == std::string::npos)
+    {
+        juce::int64 value = 0;
+        for (size_t i = negative ? 1 : 0; i < numberText.size(); ++i)
+            value = value * 10 + (numberText[i] - '0');
+
+        numberValue = (double) (negative ? -value : value);
+    }
+    else
+    {
+        numberValue = juce::CharacterFunctions::getDoubleValue(juce::CharPointer_UTF8(numberText.c_str()));
+    }
+
+    return Token::Number;
+}
+
+JsonPullParser::Token JsonPullParser::readLiteral(const char* literal, Token token)
+{
+    for (auto* p = literal; *p != 0; ++p)
+        if (readChar() != *p)
+            return fail("Unknown literal, expected \"" + juce::String(literal) + "\"");
+
+    return token;
+}
+
+JsonPullParser::Token JsonPullParser::readValue()
+{
+    skipWhitespace();
+    auto c = peekChar();
+
+    // Whatever follows this value is a separator or the end of its container
+    expect = openContainers.empty() ? Expect::Nothing : Expect::SeparatorOrEnd;
+
+    switch (c)
+    {
+        case '{':
+            ++bufferPos;
+            openContainers.push_back('{');
+            expect = Expect::FirstKeyOrEnd;
+            return Token::BeginObject;
+
+        case '[':
+            ++bufferPos;
+            openContainers.push_back('[');
+            expect = Expect::FirstValueOrEnd;
+            return Token::BeginArray;
+
+        case '"':
+            ++bufferPos;
+            return readString() ? Token::String : fail("Malformed string");
+
+        case 't': return readLiteral("true", Token::True);
+        case 'f': return readLiteral("false", Token::False);
+        case 'n': return readLiteral("null", Token::Null);
+
+        default:
+            if (c == '-' || isDigit(c))
+                return readNumber();
+
+            return fail(c < 0 ? "Unexpected end of document" : "Unexpected character '" + juce::String::charToString((juce::juce_wchar) c) + "'");
+    }
+}
+
+JsonPullParser::Token JsonPullParser::next()
+{
+    if (errorMessage.isNotEmpty())
+        return Token::Error;
+
+    skipWhitespace();
+    auto c = peekChar();
+
+    switch (expect)
+    {
+        case Expect::Nothing:
+            return c < 0 ? Token::EndOfDocument : fail("Unexpected data after the end of the document");
+
+        case Expect::Value:
+            return readValue();
+
+        case Expect::FirstValueOrEnd:
+            if (c != ']')
+                return readValue();
+            break;
+
+        case Expect::SeparatorOrEnd:
+            if (c == ',')
+            {
+                ++bufferPos;
+
+                if (openContainers.back() == '[')
+                    return readValue();
+
+                skipWhitespace();
+                c = peekChar();
+                expect = Expect::Key;
+                break;
+            }
+
+            if (c != (openContainers.back() == '{' ? '}' : ']'))
+                return fail(c < 0 ? "Unexpected end of document" : "Expected ',' or the end of the container");
+            break;
+
+        case Expect::FirstKeyOrEnd:
+        case Expect::Key:
+            break;
+    }
+
+    if (expect != Expect::Key && (c == '}' || c == ']'))
+    {
+        if (c != (openContainers.back() == '{' ? '}' : ']'))
+            return fail("Mismatched closing bracket");
+
+        ++bufferPos;
+        openContainers.pop_back();
+        expect = openContainers.empty() ? Expect::Nothing : Expect::SeparatorOrEnd;
+        return c == '}' ? Token::EndObject : Token::EndArray;
+    }
+
+    // Object member name
+    if (c != '"')
+        return fail(c < 0 ? "Unexpected end of document" : "Expected a member name");
+
+    ++bufferPos;
+    if (!readString())
+        return fail("Malformed member name");
+
+    skipWhitespace();
+    if (readChar() != ':')
+        return fail("Expected ':' after member name");
+
+    expect = Expect::Value;
+    return Token::Key;
+}
+
+bool JsonPullParser::skipValue(Token firstToken)
+{
+    if (firstToken != Token::BeginObject && firstToken != Token::BeginArray)
+        return firstToken != Token::Error && firstToken != Token::EndOfDocument;
+
+    const auto targetDepth = openContainers.size() - 1;
+
+    for (;;)
+    {
+        auto token = next();
+
+        if (token == Token::Error || token == Token::EndOfDocument)
+            return false;
+
+        if ((token == Token::EndObject || token == Token::EndArray) && openContainers.size() == targetDepth)
+            return true;
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <string>
+#include <vector>
+
+/**
+ * JsonPullParser - Minimal streaming JSON tokenizer
+ *
+ * Reads UTF-8 JSON from an InputStream through a fixed-size buffer and returns
+ * one token per next() call, so an importer can walk a known schema and build
+ * its own objects directly instead of going through a juce::var tree. Temporary
+ * memory is bounded by the buffer plus the largest single string in the input.
+ *
+ * Commas and colons are checked but not returned as tokens. String escapes
+ * (including \u surrogate pairs) are decoded to UTF-8. After a syntax error
+ * every call returns Token::Error.
+ */
+class JsonPullParser
+{
+public:
+    enum class Token
+    {
+        BeginObject,
+        EndObject,
+        BeginArray,
+        EndArray,
+        Key,            // Object member name; its value is the next token
+        String,
+        Number,
+        True,
+        False,
+        Null,
+        EndOfDocument,  // The top-level value is complete
+        Error
+    };
+
+    explicit JsonPullParser(juce::InputStream& source, size_t bufferSize = 64 * 1024);
+
+    // Advance to the next token
+    Token next();
+
+    /**
+     * Skip the rest of a value whose first token was just returned
+     * (the whole object or array for BeginObject/BeginArray)
+     * @return false if the document ends or is malformed first
+     */
+    bool skipValue(Token firstToken);
+
+    // Text of the last Key or String token (unescaped UTF-8)
+    const std::string& getString() const { return stringValue; }
+    bool isString(const char* text) const { return stringValue == text; }
+    juce::String getJuceString() const { return juce::String::fromUTF8(stringValue.data(), (int) stringValue.size()); }
+
+    // Value of the last Number token
+    double getNumber() const { return numberValue; }
+
+    // Input bytes consumed so far, for progress reporting
+    juce::int64 getPosition() const { return bufferStartPosition + (juce::int64) bufferPos; }
+
+    int getDepth() const { return (int) openContainers.size(); }
+    const juce::String& getErrorMessage() const { return errorMessage; }
+
+private:
+    enum class Expect
+    {
+        Value,              // Any value
+        FirstKeyOrEnd,      // Just after '{'
+        Key,                // After ',' in an object
+        FirstValueOrEnd,    // Just after '['
+        SeparatorOrEnd,     // After a value: ',' or the end of the enclosing container
+        Nothing             // The top-level value is complete
+    };
+
+    int peekChar();
+    int readChar();
+    bool refill();
+    void skipWhitespace();
+    bool readString();
+    bool readUnicodeEscape(juce::uint32& codeUnit);
+    Token readNumber();
+    Token readLiteral(const char* literal, Token token);
+    Token readValue();
+    Token fail(const juce::String& message);
+
+    juce::InputStream& input;
+    std::vector<char> buffer;
+    size_t bufferPos = 0, bufferEnd = 0;
+    juce::int64 bufferStartPosition = 0;
+    bool endOfInput = false;
+
+    std::vector<char> openContainers;  // '{' or '[' per open object or array
+    Expect expect = Expect::Value;
+
+    std::string stringValue;
+    std::string numberText;
+    double numberValue = 0.0;
+    juce::String errorMessage;
+
+    JUCE_DECLARE_NON_COPYABLE(JsonPullParser)
+};
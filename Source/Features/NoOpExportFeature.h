@@ -20,6 +20,10 @@ public:
     bool exportPlainText(const Narrate::NarrateProject&, const juce::File&) override { return false; }
     bool exportJSON(const Narrate::NarrateProject&, const juce::File&) override { return false; }
     bool exportCSV(const Narrate::NarrateProject&, const juce::File&) override { return false; }
+    bool exportFormats(const Narrate::NarrateProject&, std::vector<ExportTarget>&) override { return false; }
+
+    void setCueMode(CueMode) override {}
+    CueMode getCueMode() const override { return CueMode::Word; }
 
     bool supportsSRT() const override { return false; }
     bool supportsWebVTT() const override { return false; }
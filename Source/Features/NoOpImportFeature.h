@@ -16,12 +16,16 @@ public:
 
     // Format detection - always fails
     bool detectFormat(const juce::File&, juce::String&) const override { return false; }
+    std::unique_ptr<ImportSource> openForImport(const juce::File&) const override { return nullptr; }
+    std::unique_ptr<ImportSource> openForImport(std::unique_ptr<juce::InputStream>, const juce::String& = {},
+                                                const juce::File& = {}) const override { return nullptr; }
 
     // Import operations - all return false (not supported)
     bool importSRT(const juce::File&, Narrate::NarrateProject&, ProgressCallback = nullptr) override { return false; }
     bool importWebVTT(const juce::File&, Narrate::NarrateProject&, ProgressCallback = nullptr) override { return false; }
     bool importPlainText(const juce::File&, Narrate::NarrateProject&, ProgressCallback = nullptr) override { return false; }
     bool importJSON(const juce::File&, Narrate::NarrateProject&, ProgressCallback = nullptr) override { return false; }
+    bool importFromSource(ImportSource&, Narrate::NarrateProject&, ProgressCallback = nullptr) override { return false; }
 
     // Format support queries - none supported
     bool supportsSRT() const override { return false; }
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cstring>
+#include <memory>
+#include <string>
+
+/**
+ * PrefixedInputStream - Bytes already read from a stream, followed by the rest of it
+ *
+ * Lets a stream that can't seek back (a pipe, stdin) be read from the start
+ * again after its first few KB were read for format detection.
+ * Only forward seeks are supported.
+ */
+class PrefixedInputStream : public juce::InputStream
+{
+public:
+    PrefixedInputStream(std::string prefixBytes, std::unique_ptr<juce::InputStream> rest)
+        : prefix(std::move(prefixBytes)), stream(std::move(rest))
+    {
+        const auto remaining = stream != nullptr ? stream->getNumBytesRemaining() : 0;
+        totalLength = remaining < 0 ? -1 : (juce::int64) prefix.size() + remaining;
+    }
+
+    juce::int64 getTotalLength() override { return totalLength; }
+    juce::int64 getPosition() override { return position; }
+
+    bool isExhausted() override
+    {
+        return position >= (juce::int64) prefix.size() && (stream == nullptr || stream->isExhausted());
+    }
+
+    int read(void* destBuffer, int maxBytesToRead) override
+    {
+        auto* dest = static_cast<char*>(destBuffer);
+        int numRead = 0;
+
+        if (position < (juce::int64) prefix.size())
+        {
+            numRead = (int) juce::jmin((juce::int64) maxBytesToRead, (juce::int64) prefix.size() - position);
+            std::memcpy(dest, prefix.data() + position, (size_t) numRead);
+        }
+
+        if (numRead < maxBytesToRead && stream != nullptr)
+            numRead += juce::jmax(0, stream->read(dest + numRead, maxBytesToRead - numRead));
+
+        position += numRead;
+        return numRead;
+    }
+
+    bool setPosition(juce::int64 newPosition) override
+    {
+        // Only forward skips are supported
+        if (newPosition < position)
+            return false;
+
+        skipNextBytes(newPosition - position);
+        return position == newPosition;
+    }
+
+private:
+    std::string prefix;
+    std::unique_ptr<juce::InputStream> stream;
+    juce::int64 position = 0;
+    juce::int64 totalLength = -1;
+
+    JUCE_DECLARE_NON_COPYABLE(PrefixedInputStream)
+};
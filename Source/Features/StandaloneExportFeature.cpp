@@ -2,334 +2,759 @@
 
 #if NARRATE_ENABLE_SUBTITLE_EXPORT
 
-bool StandaloneExportFeature::exportSRT(const Narrate::NarrateProject& project, const juce::File& outputFile)
+#include "ExportWriter.h"
+#include <memory>
+
+namespace
 {
-    if (project.getNumClips() == 0)
-        return false;
+    // Cue end: the next word's start, or the clip end (at least one second after the start) for the last word
+    double getWordEndTime(const Narrate::NarrateClip& clip, int wordIdx, double startTime)
+    {
+        if (wordIdx + 1 < clip.getNumWords())
+            return clip.getStartTime() + clip.getWord(wordIdx + 1).relativeTime;
 
-    juce::String srtContent;
-    int sequenceNumber = 1;
+        double endTime = clip.getEndTime();
+        if (endTime <= startTime)
+            endTime = startTime + 1.0; // Minimum 1 second
+        return endTime;
+    }
 
-    // Iterate through all clips and words
-    for (int clipIdx = 0; clipIdx < project.getNumClips(); ++clipIdx)
+    void writeHTMLEscaped(ExportWriter& writer, const juce::String& text)
     {
-        const auto& clip = project.getClip(clipIdx);
+        for (auto* p = text.toRawUTF8(); *p != 0; ++p)
+        {
+            switch (*p)
+            {
+                case '&': writer.write("&amp;"); break;
+                case '<': writer.write("&lt;"); break;
+                case '>': writer.write("&gt;"); break;
+                default:  writer.write(*p); break;
+            }
+        }
+    }
 
-        for (int wordIdx = 0; wordIdx < clip.getNumWords(); ++wordIdx)
+    // Quoted, with quotes doubled, if the field contains a comma, quote or newline
+    void writeCSVField(ExportWriter& writer, const juce::String& text)
+    {
+        const std::string_view field(text.toRawUTF8(), text.getNumBytesAsUTF8());
+
+        if (field.find_first_of(",\"\n") == std::string_view::npos)
         {
-            const auto& word = clip.getWord(wordIdx);
+            writer.write(field);
+            return;
+        }
 
-            // Calculate absolute start time
-            double startTime = clip.getStartTime() + word.relativeTime;
+        writer.write('"');
+        for (auto c : field)
+        {
+            if (c == '"')
+                writer.write('"');
+            writer.write(c);
+        }
+        writer.write('"');
+    }
 
-            // Calculate end time (until next word or clip end)
-            double endTime;
-            if (wordIdx + 1 < clip.getNumWords())
-            {
-                const auto& nextWord = clip.getWord(wordIdx + 1);
-                endTime = clip.getStartTime() + nextWord.relativeTime;
-            }
-            else
+    // JSON string contents (without the quotes)
+    void writeJSONEscaped(ExportWriter& writer, const juce::String& text)
+    {
+        for (auto* p = text.toRawUTF8(); *p != 0; ++p)
+        {
+            const auto c = static_cast<unsigned char>(*p);
+
+            switch (c)
             {
-                // Last word in clip - use clip end time or add default duration
-                endTime = clip.getEndTime();
-                if (endTime <= startTime)
-                    endTime = startTime + 1.0; // Minimum 1 second
+                case '\\': writer.write("\\\\"); break;
+                case '"':  writer.write("\\\""); break;
+                case '\n': writer.write("\\n"); break;
+                case '\r': writer.write("\\r"); break;
+                case '\t': writer.write("\\t"); break;
+
+                default:
+                    if (c < 0x20)
+                    {
+                        // Other control characters are not allowed raw in JSON
+                        const char* hexDigits = "0123456789abcdef";
+                        const char escape[6] = { '\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 15] };
+                        writer.write(std::string_view(escape, 6));
+                    }
+                    else
+                    {
+                        writer.write(*p);
+                    }
+                    break;
             }
+        }
+    }
 
-            // Format SRT entry
-            srtContent += juce::String(sequenceNumber) + "\n";
-            srtContent += formatSRTTimestamp(startTime) + " --> " + formatSRTTimestamp(endTime) + "\n";
-            srtContent += word.text + "\n";
-            srtContent += "\n"; // Blank line between entries
+    // RRGGBB in lower case, without the alpha channel
+    void writeColourHex(ExportWriter& writer, juce::Colour colour)
+    {
+        const char* hexDigits = "0123456789abcdef";
+        const auto rgb = colour.getARGB() & 0xffffff;
+        char* out = writer.reserve(6);
 
-            sequenceNumber++;
+        for (int i = 0; i < 6; ++i)
+            out[i] = hexDigits[(rgb >> (20 - 4 * i)) & 15];
+
+        writer.commit(6);
+    }
+
+    void writeBool(ExportWriter& writer, bool value)
+    {
+        writer.write(value ? "true" : "false");
+    }
+
+    void writeFormattingJSON(ExportWriter& writer, const Narrate::TextFormatting& formatting, std::string_view indent)
+    {
+        writer.write(indent);
+        writer.write("{");
+        writer.newLine();
+
+        writer.write(indent);
+        writer.write("  \"colour\": \"");
+        writeColourHex(writer, formatting.colour);
+        writer.write("\",");
+        writer.newLine();
+
+        writer.write(indent);
+        writer.write("  \"bold\": ");
+        writeBool(writer, formatting.bold);
+        writer.write(",");
+        writer.newLine();
+
+        writer.write(indent);
+        writer.write("  \"italic\": ");
+        writeBool(writer, formatting.italic);
+        writer.write(",");
+        writer.newLine();
+
+        writer.write(indent);
+        writer.write("  \"fontSizeMultiplier\": ");
+        writer.writeNumber(formatting.fontSizeMultiplier);
+        writer.newLine();
+
+        writer.write(indent);
+        writer.write("}");
+    }
+
+    // Escaped text with its formatting as nested tags: <c.color_RRGGBB><i><b>text</b></i></c>
+    void writeWebVTTWord(ExportWriter& writer, const Narrate::NarrateWord& word)
+    {
+        const bool hasFormatting = word.formatting.has_value();
+        const bool bold = hasFormatting && word.formatting->bold;
+        const bool italic = hasFormatting && word.formatting->italic;
+        const bool coloured = hasFormatting && word.formatting->colour != juce::Colours::white;
+
+        if (coloured)
+        {
+            // WebVTT supports color via CSS class or <c> tag
+            writer.write("<c.color_");
+            writeColourHex(writer, word.formatting->colour);
+            writer.write(">");
         }
+
+        if (italic)
+            writer.write("<i>");
+        if (bold)
+            writer.write("<b>");
+
+        writeHTMLEscaped(writer, word.text);
+
+        if (bold)
+            writer.write("</b>");
+        if (italic)
+            writer.write("</i>");
+        if (coloured)
+            writer.write("</c>");
     }
 
-    // Write to file
-    if (!outputFile.replaceWithText(srtContent))
+    bool hasText(const Narrate::NarrateClip& clip)
+    {
+        for (const auto& word : clip.getWords())
+            if (word.text.isNotEmpty())
+                return true;
+
         return false;
+    }
 
-    return true;
-}
+    // Clip cue end: the clip end, or one second after the start for clips without a proper end
+    double getClipCueEndTime(const Narrate::NarrateClip& clip)
+    {
+        return clip.getEndTime() > clip.getStartTime() ? clip.getEndTime() : clip.getStartTime() + 1.0;
+    }
 
-bool StandaloneExportFeature::exportWebVTT(const Narrate::NarrateProject& project, const juce::File& outputFile)
-{
-    if (project.getNumClips() == 0)
-        return false;
+    //==============================================================================
+    /**
+     * One export format, fed word by word as the project is walked.
+     * Each writer has its own ExportWriter buffer in front of its stream, so any
+     * number of formats can be written in the same pass.
+     */
+    class FormatWriter
+    {
+    public:
+        explicit FormatWriter(juce::OutputStream& output) : writer(output) {}
+        virtual ~FormatWriter() = default;
+
+        virtual void begin(const Narrate::NarrateProject&) {}
+        virtual void beginClip(const Narrate::NarrateClip&, int /*clipIdx*/) {}
+        virtual void writeWord(const Narrate::NarrateClip& clip, int wordIdx, double startTime, double endTime) = 0;
+        virtual void endClip(const Narrate::NarrateClip&, int /*clipIdx*/) {}
+        virtual void end() {}
+
+        // Writes the trailer and flushes; false if any write to the stream failed
+        bool finish()
+        {
+            end();
+            return writer.flush();
+        }
+
+        bool failed() const { return writer.failed(); }
+
+    protected:
+        ExportWriter writer;
 
-    juce::String vttContent = "WEBVTT\n\n"; // WebVTT header
+        JUCE_DECLARE_NON_COPYABLE(FormatWriter)
+    };
 
-    // Iterate through all clips and words
-    for (int clipIdx = 0; clipIdx < project.getNumClips(); ++clipIdx)
+    // One entry per word
+    class SRTWriter : public FormatWriter
     {
-        const auto& clip = project.getClip(clipIdx);
+    public:
+        using FormatWriter::FormatWriter;
+
+        void writeWord(const Narrate::NarrateClip& clip, int wordIdx, double startTime, double endTime) override
+        {
+            writer.writeInt(sequenceNumber++);
+            writer.newLine();
+            writer.writeTimestamp(startTime, ',');
+            writer.write(" --> ");
+            writer.writeTimestamp(endTime, ',');
+            writer.newLine();
+            writer.write(clip.getWord(wordIdx).text);
+            writer.newLine();
+            writer.newLine(); // Blank line between entries
+        }
+
+    private:
+        int sequenceNumber = 1;
+    };
+
+    // One cue per word
+    class WebVTTWriter : public FormatWriter
+    {
+    public:
+        using FormatWriter::FormatWriter;
+
+        void begin(const Narrate::NarrateProject&) override
+        {
+            writer.write("WEBVTT");
+            writer.newLine();
+            writer.newLine();
+        }
 
-        for (int wordIdx = 0; wordIdx < clip.getNumWords(); ++wordIdx)
+        void writeWord(const Narrate::NarrateClip& clip, int wordIdx, double startTime, double endTime) override
         {
             const auto& word = clip.getWord(wordIdx);
 
-            // Calculate absolute start time
-            double startTime = clip.getStartTime() + word.relativeTime;
+            writer.writeTimestamp(startTime, '.');
+            writer.write(" --> ");
+            writer.writeTimestamp(endTime, '.');
+            writer.newLine();
+            writeWebVTTWord(writer, word);
+            writer.newLine();
+            writer.newLine(); // Blank line between cues
+        }
+    };
+
+    // Words separated by spaces, with nothing before the first word or after the last
+    class PlainTextWriter : public FormatWriter
+    {
+    public:
+        using FormatWriter::FormatWriter;
 
-            // Calculate end time
-            double endTime;
-            if (wordIdx + 1 < clip.getNumWords())
+        void writeWord(const Narrate::NarrateClip& clip, int wordIdx, double, double) override
+        {
+            const auto& text = clip.getWord(wordIdx).text;
+
+            if (text.isNotEmpty())
             {
-                const auto& nextWord = clip.getWord(wordIdx + 1);
-                endTime = clip.getStartTime() + nextWord.relativeTime;
+                for (; anyWritten && pendingSpaces > 0; --pendingSpaces)
+                    writer.write(' ');
+
+                writer.write(text);
+                anyWritten = true;
+                pendingSpaces = 0;
             }
-            else
+
+            ++pendingSpaces;
+        }
+
+    private:
+        int pendingSpaces = 0;
+        bool anyWritten = false;
+    };
+
+    /**
+     * One cue per clip, for CueMode::Clip.
+     * SRT has no way to mark word times, so the cue is just the clip's words.
+     * WebVTT puts an <hh:mm:ss.mmm> timestamp tag before each word that starts
+     * after the cue start, which players use for karaoke-style highlighting.
+     * Clips without any text are skipped; a cue needs a payload.
+     */
+    class ClipCueWriter : public FormatWriter
+    {
+    public:
+        ClipCueWriter(juce::OutputStream& output, bool isWebVTT) : FormatWriter(output), webVTT(isWebVTT) {}
+
+        void begin(const Narrate::NarrateProject&) override
+        {
+            if (webVTT)
             {
-                endTime = clip.getEndTime();
-                if (endTime <= startTime)
-                    endTime = startTime + 1.0;
+                writer.write("WEBVTT");
+                writer.newLine();
+                writer.newLine();
             }
+        }
+
+        void beginClip(const Narrate::NarrateClip& clip, int) override
+        {
+            inCue = hasText(clip);
+            if (!inCue)
+                return;
 
-            // Format WebVTT cue
-            vttContent += formatWebVTTTimestamp(startTime) + " --> " + formatWebVTTTimestamp(endTime) + "\n";
+            cueStart = clip.getStartTime();
+            cueEnd = getClipCueEndTime(clip);
+            lastTimestamp = cueStart;
+            anyWordWritten = false;
 
-            // Apply formatting if present
-            juce::String formattedText = escapeHTMLEntities(word.text);
+            const char separator = webVTT ? '.' : ',';
 
-            if (word.formatting.has_value())
+            if (!webVTT)
             {
-                const auto& fmt = word.formatting.value();
+                writer.writeInt(sequenceNumber++);
+                writer.newLine();
+            }
 
-                if (fmt.bold)
-                    formattedText = "<b>" + formattedText + "</b>";
-                if (fmt.italic)
-                    formattedText = "<i>" + formattedText + "</i>";
+            writer.writeTimestamp(cueStart, separator);
+            writer.write(" --> ");
+            writer.writeTimestamp(cueEnd, separator);
+            writer.newLine();
+        }
 
-                // WebVTT supports color via CSS class or <c> tag
-                if (fmt.colour != juce::Colours::white)
+        void writeWord(const Narrate::NarrateClip& clip, int wordIdx, double startTime, double) override
+        {
+            const auto& word = clip.getWord(wordIdx);
+            if (!inCue || word.text.isEmpty())
+                return;
+
+            if (anyWordWritten)
+                writer.write(' ');
+
+            if (webVTT)
+            {
+                // Timestamp tags must lie inside the cue and increase
+                if (startTime > lastTimestamp && startTime < cueEnd)
                 {
-                    // Convert JUCE color to hex
-                    juce::String colorHex = fmt.colour.toString().substring(2); // Skip "ff" alpha
-                    formattedText = "<c.color_" + colorHex + ">" + formattedText + "</c>";
+                    writer.write('<');
+                    writer.writeTimestamp(startTime, '.');
+                    writer.write('>');
+                    lastTimestamp = startTime;
                 }
+
+                writeWebVTTWord(writer, word);
+            }
+            else
+            {
+                writer.write(word.text);
             }
 
-            vttContent += formattedText + "\n";
-            vttContent += "\n"; // Blank line between cues
+            anyWordWritten = true;
         }
-    }
 
-    // Write to file
-    if (!outputFile.replaceWithText(vttContent))
-        return false;
+        void endClip(const Narrate::NarrateClip&, int) override
+        {
+            if (!inCue)
+                return;
 
-    return true;
-}
+            writer.newLine();
+            writer.newLine(); // Blank line between cues
+        }
 
-juce::String StandaloneExportFeature::formatSRTTimestamp(double seconds) const
-{
-    int hours = static_cast<int>(seconds) / 3600;
-    int minutes = (static_cast<int>(seconds) % 3600) / 60;
-    int secs = static_cast<int>(seconds) % 60;
-    int millis = static_cast<int>((seconds - static_cast<int>(seconds)) * 1000);
+    private:
+        const bool webVTT;
+        int sequenceNumber = 1;
+        bool inCue = false;
+        bool anyWordWritten = false;
+        double cueStart = 0.0, cueEnd = 0.0, lastTimestamp = 0.0;
+    };
 
-    return juce::String::formatted("%02d:%02d:%02d,%03d", hours, minutes, secs, millis);
-}
+    // Distinct styles are written once; clips and words refer to them by index
+    class JSONWriter : public FormatWriter
+    {
+    public:
+        using FormatWriter::FormatWriter;
 
-juce::String StandaloneExportFeature::formatWebVTTTimestamp(double seconds) const
-{
-    int hours = static_cast<int>(seconds) / 3600;
-    int minutes = (static_cast<int>(seconds) % 3600) / 60;
-    int secs = static_cast<int>(seconds) % 60;
-    int millis = static_cast<int>((seconds - static_cast<int>(seconds)) * 1000);
+        void begin(const Narrate::NarrateProject& project) override
+        {
+            // One pass over the formatting alone; the styles table must come before the clips
+            palette.clear();
+            for (int clipIdx = 0; clipIdx < project.getNumClips(); ++clipIdx)
+                palette.addClipStyles(project.getClip(clipIdx));
+
+            numClips = project.getNumClips();
+
+            writer.write("{");
+            writer.newLine();
+            writer.write("  \"projectName\": \"");
+            writeJSONEscaped(writer, project.getProjectName());
+            writer.write("\",");
+            writer.newLine();
+            writer.write("  \"totalDuration\": ");
+            writer.writeNumber(project.getTotalDuration());
+            writer.write(",");
+            writer.newLine();
+            writer.write("  \"styles\": [");
+            writer.newLine();
+
+            for (int styleIdx = 0; styleIdx < palette.size(); ++styleIdx)
+            {
+                writeFormattingJSON(writer, palette[styleIdx], "    ");
+                if (styleIdx < palette.size() - 1)
+                    writer.write(",");
+                writer.newLine();
+            }
 
-    return juce::String::formatted("%02d:%02d:%02d.%03d", hours, minutes, secs, millis);
-}
+            writer.write("  ],");
+            writer.newLine();
+            writer.write("  \"clips\": [");
+            writer.newLine();
+        }
 
-juce::String StandaloneExportFeature::escapeHTMLEntities(const juce::String& text) const
-{
-    juce::String escaped = text;
-    escaped = escaped.replace("&", "&amp;");
-    escaped = escaped.replace("<", "&lt;");
-    escaped = escaped.replace(">", "&gt;");
-    return escaped;
-}
+        void beginClip(const Narrate::NarrateClip& clip, int) override
+        {
+            writer.write("    {");
+            writer.newLine();
+            writer.write("      \"id\": \"");
+            writeJSONEscaped(writer, clip.getId());
+            writer.write("\",");
+            writer.newLine();
+            writer.write("      \"startTime\": ");
+            writer.writeNumber(clip.getStartTime());
+            writer.write(",");
+            writer.newLine();
+            writer.write("      \"endTime\": ");
+            writer.writeNumber(clip.getEndTime());
+            writer.write(",");
+            writer.newLine();
+            writer.write("      \"duration\": ");
+            writer.writeNumber(clip.getDuration());
+            writer.write(",");
+            writer.newLine();
+            writer.write("      \"defaultStyle\": ");
+            writer.writeInt(palette.indexOf(clip.getDefaultFormatting()));
+            writer.write(",");
+            writer.newLine();
+            writer.write("      \"words\": [");
+            writer.newLine();
+        }
 
-bool StandaloneExportFeature::exportPlainText(const Narrate::NarrateProject& project, const juce::File& outputFile)
-{
-    if (project.getNumClips() == 0)
-        return false;
+        void writeWord(const Narrate::NarrateClip& clip, int wordIdx, double startTime, double) override
+        {
+            const auto& word = clip.getWord(wordIdx);
 
-    juce::String plainText;
+            writer.write("        {");
+            writer.newLine();
+            writer.write("          \"text\": \"");
+            writeJSONEscaped(writer, word.text);
+            writer.write("\",");
+            writer.newLine();
+            writer.write("          \"relativeTime\": ");
+            writer.writeNumber(word.relativeTime);
+            writer.write(",");
+            writer.newLine();
+            writer.write("          \"absoluteTime\": ");
+            writer.writeNumber(startTime);
 
-    // Iterate through all clips and words
-    for (int clipIdx = 0; clipIdx < project.getNumClips(); ++clipIdx)
-    {
-        const auto& clip = project.getClip(clipIdx);
+            if (word.formatting.has_value())
+            {
+                writer.write(",");
+                writer.newLine();
+                writer.write("          \"style\": ");
+                writer.writeInt(palette.indexOf(*word.formatting));
+            }
+
+            writer.newLine();
+            writer.write("        }");
+            if (wordIdx < clip.getNumWords() - 1)
+                writer.write(",");
+            writer.newLine();
+        }
 
-        // Add all words from the clip
-        for (int wordIdx = 0; wordIdx < clip.getNumWords(); ++wordIdx)
+        void endClip(const Narrate::NarrateClip&, int clipIdx) override
         {
-            const auto& word = clip.getWord(wordIdx);
-            plainText += word.text + " ";
+            writer.write("      ]");
+            writer.newLine();
+            writer.write("    }");
+            if (clipIdx < numClips - 1)
+                writer.write(",");
+            writer.newLine();
         }
-    }
 
-    plainText = plainText.trim();
+        void end() override
+        {
+            writer.write("  ]");
+            writer.newLine();
+            writer.write("}");
+            writer.newLine();
+        }
 
-    // Write to file
-    if (!outputFile.replaceWithText(plainText))
-        return false;
+    private:
+        Narrate::FormattingPalette palette;
+        int numClips = 0;
+    };
 
-    return true;
-}
+    // One row per word
+    class CSVWriter : public FormatWriter
+    {
+    public:
+        using FormatWriter::FormatWriter;
 
-bool StandaloneExportFeature::exportJSON(const Narrate::NarrateProject& project, const juce::File& outputFile)
-{
-    if (project.getNumClips() == 0)
-        return false;
+        void begin(const Narrate::NarrateProject&) override
+        {
+            writer.write("ClipID,StartTime,EndTime,Duration,WordIndex,Word,RelativeTime,AbsoluteTime,Bold,Italic,Colour,FontSizeMultiplier");
+            writer.newLine();
+        }
 
-    juce::String jsonContent = "{\n";
-    jsonContent += "  \"projectName\": \"" + escapeJSONString(project.getProjectName()) + "\",\n";
-    jsonContent += "  \"totalDuration\": " + juce::String(project.getTotalDuration()) + ",\n";
-    jsonContent += "  \"clips\": [\n";
+        void writeWord(const Narrate::NarrateClip& clip, int wordIdx, double startTime, double) override
+        {
+            const auto& word = clip.getWord(wordIdx);
+            const auto& effectiveFmt = word.getEffectiveFormatting(clip.getDefaultFormatting());
+
+            writeCSVField(writer, clip.getId());
+            writer.write(',');
+            writer.writeNumber(clip.getStartTime());
+            writer.write(',');
+            writer.writeNumber(clip.getEndTime());
+            writer.write(',');
+            writer.writeNumber(clip.getDuration());
+            writer.write(',');
+            writer.writeInt(wordIdx);
+            writer.write(',');
+            writeCSVField(writer, word.text);
+            writer.write(',');
+            writer.writeNumber(word.relativeTime);
+            writer.write(',');
+            writer.writeNumber(startTime);
+            writer.write(',');
+            writeBool(writer, effectiveFmt.bold);
+            writer.write(',');
+            writeBool(writer, effectiveFmt.italic);
+            writer.write(',');
+            writeColourHex(writer, effectiveFmt.colour);
+            writer.write(',');
+            writer.writeNumber(effectiveFmt.fontSizeMultiplier);
+            writer.newLine();
+        }
+    };
+
+    // nullptr for an unknown format name
+    std::unique_ptr<FormatWriter> createFormatWriter(const juce::String& format, juce::OutputStream& output,
+                                                     ExportFeature::CueMode cueMode)
+    {
+        const bool clipCues = cueMode == ExportFeature::CueMode::Clip;
+
+        if (format == "srt" && clipCues) return std::make_unique<ClipCueWriter>(output, false);
+        if (format == "vtt" && clipCues) return std::make_unique<ClipCueWriter>(output, true);
+        if (format == "srt")  return std::make_unique<SRTWriter>(output);
+        if (format == "vtt")  return std::make_unique<WebVTTWriter>(output);
+        if (format == "txt")  return std::make_unique<PlainTextWriter>(output);
+        if (format == "json") return std::make_unique<JSONWriter>(output);
+        if (format == "csv")  return std::make_unique<CSVWriter>(output);
+        return nullptr;
+    }
 
-    // Iterate through all clips
-    for (int clipIdx = 0; clipIdx < project.getNumClips(); ++clipIdx)
+    /**
+     * Walk the clips and words once, feeding every writer in turn.
+     * Word times are worked out once and shared by all the formats.
+     * @return false if any writer failed
+     */
+    bool writeProject(const Narrate::NarrateProject& project, const std::vector<FormatWriter*>& writers)
     {
-        const auto& clip = project.getClip(clipIdx);
-
-        jsonContent += "    {\n";
-        jsonContent += "      \"id\": \"" + escapeJSONString(clip.getId()) + "\",\n";
-        jsonContent += "      \"startTime\": " + juce::String(clip.getStartTime()) + ",\n";
-        jsonContent += "      \"endTime\": " + juce::String(clip.getEndTime()) + ",\n";
-        jsonContent += "      \"duration\": " + juce::String(clip.getDuration()) + ",\n";
-
-        // Default formatting
-        const auto& fmt = clip.getDefaultFormatting();
-        jsonContent += "      \"defaultFormatting\": {\n";
-        jsonContent += "        \"colour\": \"" + colourToHex(fmt.colour) + "\",\n";
-        jsonContent += "        \"bold\": " + juce::String(fmt.bold ? "true" : "false") + ",\n";
-        jsonContent += "        \"italic\": " + juce::String(fmt.italic ? "true" : "false") + ",\n";
-        jsonContent += "        \"fontSizeMultiplier\": " + juce::String(fmt.fontSizeMultiplier) + "\n";
-        jsonContent += "      },\n";
-
-        jsonContent += "      \"words\": [\n";
-
-        // Iterate through all words
-        for (int wordIdx = 0; wordIdx < clip.getNumWords(); ++wordIdx)
+        for (auto* writer : writers)
+            writer->begin(project);
+
+        for (int clipIdx = 0; clipIdx < project.getNumClips(); ++clipIdx)
         {
-            const auto& word = clip.getWord(wordIdx);
+            const auto& clip = project.getClip(clipIdx);
 
-            jsonContent += "        {\n";
-            jsonContent += "          \"text\": \"" + escapeJSONString(word.text) + "\",\n";
-            jsonContent += "          \"relativeTime\": " + juce::String(word.relativeTime) + ",\n";
-            jsonContent += "          \"absoluteTime\": " + juce::String(clip.getStartTime() + word.relativeTime);
+            for (auto* writer : writers)
+                writer->beginClip(clip, clipIdx);
 
-            if (word.formatting.has_value())
-            {
-                const auto& wordFmt = word.formatting.value();
-                jsonContent += ",\n";
-                jsonContent += "          \"formatting\": {\n";
-                jsonContent += "            \"colour\": \"" + colourToHex(wordFmt.colour) + "\",\n";
-                jsonContent += "            \"bold\": " + juce::String(wordFmt.bold ? "true" : "false") + ",\n";
-                jsonContent += "            \"italic\": " + juce::String(wordFmt.italic ? "true" : "false") + ",\n";
-                jsonContent += "            \"fontSizeMultiplier\": " + juce::String(wordFmt.fontSizeMultiplier) + "\n";
-                jsonContent += "          }\n";
-            }
-            else
+            for (int wordIdx = 0; wordIdx < clip.getNumWords(); ++wordIdx)
             {
-                jsonContent += "\n";
+                const double startTime = clip.getStartTime() + clip.getWord(wordIdx).relativeTime;
+                const double endTime = getWordEndTime(clip, wordIdx, startTime);
+
+                for (auto* writer : writers)
+                    writer->writeWord(clip, wordIdx, startTime, endTime);
             }
 
-            jsonContent += "        }";
-            if (wordIdx < clip.getNumWords() - 1)
-                jsonContent += ",";
-            jsonContent += "\n";
+            for (auto* writer : writers)
+                writer->endClip(clip, clipIdx);
         }
 
-        jsonContent += "      ]\n";
-        jsonContent += "    }";
-        if (clipIdx < project.getNumClips() - 1)
-            jsonContent += ",";
-        jsonContent += "\n";
+        bool allOk = true;
+        for (auto* writer : writers)
+            allOk = writer->finish() && allOk;
+
+        return allOk;
     }
 
-    jsonContent += "  ]\n";
-    jsonContent += "}\n";
+    bool exportToStream(const Narrate::NarrateProject& project, const juce::String& format, juce::OutputStream& output,
+                        ExportFeature::CueMode cueMode)
+    {
+        if (project.getNumClips() == 0)
+            return false;
 
-    // Write to file
-    if (!outputFile.replaceWithText(jsonContent))
-        return false;
+        auto writer = createFormatWriter(format, output, cueMode);
+        return writer != nullptr && writeProject(project, { writer.get() });
+    }
+}
 
-    return true;
+bool StandaloneExportFeature::exportSRT(const Narrate::NarrateProject& project, const juce::File& outputFile)
+{
+    std::vector<ExportTarget> targets { { "srt", outputFile } };
+    return exportFormats(project, targets);
+}
+
+bool StandaloneExportFeature::exportSRT(const Narrate::NarrateProject& project, juce::OutputStream& output)
+{
+    return exportToStream(project, "srt", output, cueMode);
+}
+
+bool StandaloneExportFeature::exportWebVTT(const Narrate::NarrateProject& project, const juce::File& outputFile)
+{
+    std::vector<ExportTarget> targets { { "vtt", outputFile } };
+    return exportFormats(project, targets);
+}
+
+bool StandaloneExportFeature::exportWebVTT(const Narrate::NarrateProject& project, juce::OutputStream& output)
+{
+    return exportToStream(project, "vtt", output, cueMode);
+}
+
+bool StandaloneExportFeature::exportPlainText(const Narrate::NarrateProject& project, const juce::File& outputFile)
+{
+    std::vector<ExportTarget> targets { { "txt", outputFile } };
+    return exportFormats(project, targets);
+}
+
+bool StandaloneExportFeature::exportPlainText(const Narrate::NarrateProject& project, juce::OutputStream& output)
+{
+    return exportToStream(project, "txt", output, cueMode);
+}
+
+bool StandaloneExportFeature::exportJSON(const Narrate::NarrateProject& project, const juce::File& outputFile)
+{
+    std::vector<ExportTarget> targets { { "json", outputFile } };
+    return exportFormats(project, targets);
+}
+
+bool StandaloneExportFeature::exportJSON(const Narrate::NarrateProject& project, juce::OutputStream& output)
+{
+    return exportToStream(project, "json", output, cueMode);
 }
 
 bool StandaloneExportFeature::exportCSV(const Narrate::NarrateProject& project, const juce::File& outputFile)
 {
-    if (project.getNumClips() == 0)
-        return false;
+    std::vector<ExportTarget> targets { { "csv", outputFile } };
+    return exportFormats(project, targets);
+}
 
-    juce::String csvContent;
+bool StandaloneExportFeature::exportCSV(const Narrate::NarrateProject& project, juce::OutputStream& output)
+{
+    return exportToStream(project, "csv", output, cueMode);
+}
 
-    // CSV Header
-    csvContent += "ClipID,StartTime,EndTime,Duration,WordIndex,Word,RelativeTime,AbsoluteTime,Bold,Italic,Colour,FontSizeMultiplier\n";
+bool StandaloneExportFeature::exportFormats(const Narrate::NarrateProject& project, std::vector<ExportTarget>& targets)
+{
+    for (auto& target : targets)
+        target.succeeded = false;
+
+    // Nothing is written for an empty project
+    if (project.getNumClips() == 0 || targets.empty())
+        return false;
 
-    // Iterate through all clips and words
-    for (int clipIdx = 0; clipIdx < project.getNumClips(); ++clipIdx)
+    // Open every file first, then write them all in one pass. Each target is written to a
+    // temporary file beside it and only replaces the target once complete, so a failed
+    // export leaves the previous file as it was.
+    std::vector<std::unique_ptr<juce::TemporaryFile>> tempFiles(targets.size());
+    std::vector<std::unique_ptr<juce::FileOutputStream>> streams(targets.size());
+    std::vector<std::unique_ptr<FormatWriter>> writers(targets.size());
+    std::vector<FormatWriter*> activeWriters;
+    const auto formatNames = ExportFeature::getFormatNames();
+
+    for (size_t i = 0; i < targets.size(); ++i)
     {
-        const auto& clip = project.getClip(clipIdx);
+        if (!formatNames.contains(targets[i].format))
+            continue;
+
+        auto tempFile = std::make_unique<juce::TemporaryFile>(targets[i].file);
+        auto stream = std::make_unique<juce::FileOutputStream>(tempFile->getFile());
+        if (!stream->openedOk())
+            continue;
+
+        writers[i] = createFormatWriter(targets[i].format, *stream, cueMode);
+        activeWriters.push_back(writers[i].get());
+        streams[i] = std::move(stream);
+        tempFiles[i] = std::move(tempFile);
+    }
+
+    if (!activeWriters.empty())
+        writeProject(project, activeWriters);
 
-        for (int wordIdx = 0; wordIdx < clip.getNumWords(); ++wordIdx)
+    bool allOk = true;
+
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        if (streams[i] != nullptr)
         {
-            const auto& word = clip.getWord(wordIdx);
-            const auto effectiveFmt = word.getEffectiveFormatting(clip.getDefaultFormatting());
-            double absoluteTime = clip.getStartTime() + word.relativeTime;
-
-            csvContent += escapeCSVField(clip.getId()) + ",";
-            csvContent += juce::String(clip.getStartTime()) + ",";
-            csvContent += juce::String(clip.getEndTime()) + ",";
-            csvContent += juce::String(clip.getDuration()) + ",";
-            csvContent += juce::String(wordIdx) + ",";
-            csvContent += escapeCSVField(word.text) + ",";
-            csvContent += juce::String(word.relativeTime) + ",";
-            csvContent += juce::String(absoluteTime) + ",";
-            csvContent += juce::String(effectiveFmt.bold ? "true" : "false") + ",";
-            csvContent += juce::String(effectiveFmt.italic ? "true" : "false") + ",";
-            csvContent += escapeCSVField(colourToHex(effectiveFmt.colour)) + ",";
-            csvContent += juce::String(effectiveFmt.fontSizeMultiplier) + "\n";
+            // The writer knows whether its own writes failed; the stream reports the rest
+            const bool written = !writers[i]->failed();
+            writers[i].reset();
+            streams[i]->flush();
+            const bool streamOk = streams[i]->getStatus().wasOk();
+            streams[i].reset();  // Close the file before it is moved over the target
+
+            targets[i].succeeded = written && streamOk && tempFiles[i]->overwriteTargetFileWithTemporary();
         }
-    }
 
-    // Write to file
-    if (!outputFile.replaceWithText(csvContent))
-        return false;
+        allOk = allOk && targets[i].succeeded;
+    }
 
-    return true;
+    return allOk;
 }
 
-juce::String StandaloneExportFeature::escapeCSVField(const juce::String& text) const
+bool StandaloneExportFeature::exportFormats(const Narrate::NarrateProject& project,
+                                            const std::vector<std::pair<juce::String, juce::OutputStream*>>& outputs)
 {
-    // If field contains comma, quote, or newline, wrap in quotes and escape quotes
-    if (text.contains(",") || text.contains("\"") || text.contains("\n"))
+    if (project.getNumClips() == 0 || outputs.empty())
+        return false;
+
+    std::vector<std::unique_ptr<FormatWriter>> writers;
+    std::vector<FormatWriter*> activeWriters;
+
+    for (const auto& [format, stream] : outputs)
     {
-        juce::String escaped = text.replace("\"", "\"\"");
-        return "\"" + escaped + "\"";
-    }
-    return text;
-}
+        auto writer = stream != nullptr ? createFormatWriter(format, *stream, cueMode) : nullptr;
+        if (writer == nullptr)
+            return false;
 
-juce::String StandaloneExportFeature::escapeJSONString(const juce::String& text) const
-{
-    juce::String escaped = text;
-    escaped = escaped.replace("\\", "\\\\");
-    escaped = escaped.replace("\"", "\\\"");
-    escaped = escaped.replace("\n", "\\n");
-    escaped = escaped.replace("\r", "\\r");
-    escaped = escaped.replace("\t", "\\t");
-    return escaped;
-}
+        activeWriters.push_back(writer.get());
+        writers.push_back(std::move(writer));
+    }
 
-juce::String StandaloneExportFeature::colourToHex(const juce::Colour& colour) const
-{
-    return colour.toString().substring(2); // Skip alpha channel (first 2 chars)
+    return writeProject(project, activeWriters);
 }
 
 #endif // NARRATE_ENABLE_SUBTITLE_EXPORT
@@ -31,6 +31,32 @@ public:
     bool exportJSON(const Narrate::NarrateProject& project, const juce::File& outputFile) override;
     bool exportCSV(const Narrate::NarrateProject& project, const juce::File& outputFile) override;
 
+    /**
+     * Streaming versions of the exports above: the output goes through a
+     * fixed-size buffer (see ExportWriter) into any stream, so memory use
+     * does not grow with the project
+     * @return false for an empty project or if writing to the stream failed
+     */
+    bool exportSRT(const Narrate::NarrateProject& project, juce::OutputStream& output);
+    bool exportWebVTT(const Narrate::NarrateProject& project, juce::OutputStream& output);
+    bool exportPlainText(const Narrate::NarrateProject& project, juce::OutputStream& output);
+    bool exportJSON(const Narrate::NarrateProject& project, juce::OutputStream& output);
+    bool exportCSV(const Narrate::NarrateProject& project, juce::OutputStream& output);
+
+    // Multi-format export: one pass over the clips and words feeds every target's writer
+    bool exportFormats(const Narrate::NarrateProject& project, std::vector<ExportTarget>& targets) override;
+
+    /**
+     * Streaming version of exportFormats(), with one stream per format name
+     * @return false for an empty project, an unknown format or if writing to any stream failed
+     */
+    bool exportFormats(const Narrate::NarrateProject& project,
+                       const std::vector<std::pair<juce::String, juce::OutputStream*>>& outputs);
+
+    // Cue granularity for SRT and WebVTT (the other formats are always per word)
+    void setCueMode(CueMode mode) override { cueMode = mode; }
+    CueMode getCueMode() const override { return cueMode; }
+
     // Format support queries
     bool supportsSRT() const override { return true; }
     bool supportsWebVTT() const override { return true; }
@@ -39,15 +65,7 @@ public:
     bool supportsCSV() const override { return true; }
 
 private:
-    // Helper functions for subtitle formats
-    juce::String formatSRTTimestamp(double seconds) const;
-    juce::String formatWebVTTTimestamp(double seconds) const;
-    juce::String escapeHTMLEntities(const juce::String& text) const;
-
-    // Helper functions for text formats
-    juce::String escapeCSVField(const juce::String& text) const;
-    juce::String escapeJSONString(const juce::String& text) const;
-    juce::String colourToHex(const juce::Colour& colour) const;
+    CueMode cueMode = CueMode::Word;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StandaloneExportFeature)
 };
@@ -1,6 +1,12 @@
 #include "StandaloneImportFeature.h"
+#include "JsonPullParser.h"
+#include "SubtitleTokenizer.h"
 #include "../NarrateLogger.h"
-#include <juce_data_structures/juce_data_structures.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <queue>
 
 // ============================================================================
 // Helper function for parsing timecode (static method in base class)
@@ -11,25 +17,7 @@ double ImportFeature::parseTimecode(const juce::String& timecodeStr)
     // Supports formats:
     // HH:MM:SS,mmm (SRT format)
     // HH:MM:SS.mmm (WebVTT format)
-
-    juce::String normalized = timecodeStr.trim();
-
-    // Replace comma with period for consistent parsing
-    normalized = normalized.replace(",", ".");
-
-    // Split by colons
-    juce::StringArray parts = juce::StringArray::fromTokens(normalized, ":", "");
-
-    if (parts.size() != 3)
-        return -1.0;
-
-    int hours = parts[0].getIntValue();
-    int minutes = parts[1].getIntValue();
-
-    // The seconds part may contain milliseconds (e.g., "45.500")
-    double seconds = parts[2].getDoubleValue();
-
-    return hours * 3600.0 + minutes * 60.0 + seconds;
+    return SubtitleTokenizer::parseTimecode(std::string_view(timecodeStr.toRawUTF8(), timecodeStr.getNumBytesAsUTF8()));
 }
 
 // ============================================================================
@@ -38,384 +26,368 @@ double ImportFeature::parseTimecode(const juce::String& timecodeStr)
 
 bool StandaloneImportFeature::detectFormat(const juce::File& file, juce::String& outFormat) const
 {
-    if (!file.existsAsFile())
+    auto source = openForImport(file);
+    if (source == nullptr)
         return false;
 
-    juce::String content = file.loadFileAsString();
-    if (content.isEmpty())
-        return false;
+    outFormat = source->getFormat();
+    return true;
+}
 
-    // Check for WebVTT signature
-    if (content.startsWith("WEBVTT"))
-    {
-        outFormat = "vtt";
-        return true;
-    }
+std::unique_ptr<ImportSource> StandaloneImportFeature::openForImport(const juce::File& file) const
+{
+    // Only the first few KB are read; the importer continues from them
+    return TextImportSource::open(file);
+}
 
-    // Check for JSON format
-    if (content.trimStart().startsWith("{") && content.contains("\"projectName\""))
-    {
-        outFormat = "json";
-        return true;
-    }
+std::unique_ptr<ImportSource> StandaloneImportFeature::openForImport(std::unique_ptr<juce::InputStream> input, const juce::String& format,
+                                                                     const juce::File& file) const
+{
+    return TextImportSource::open(std::move(input), format, file);
+}
 
-    // Check for SRT format (numeric index followed by timecode)
-    juce::StringArray lines = juce::StringArray::fromLines(content);
-    if (lines.size() >= 3)
-    {
-        // SRT starts with a numeric index
-        if (lines[0].trim().containsOnly("0123456789"))
-        {
-            // Second line should contain the arrow separator
-            if (lines[1].contains("-->"))
-            {
-                outFormat = "srt";
-                return true;
-            }
-        }
-    }
+bool StandaloneImportFeature::importFromSource(ImportSource& source, Narrate::NarrateProject& outProject, ProgressCallback progressCallback)
+{
+    auto* textSource = dynamic_cast<TextImportSource*>(&source);
+    if (textSource == nullptr)
+        return false;
 
-    // Default to plain text
-    outFormat = "txt";
-    return true;
+    const auto& format = source.getFormat();
+
+    if (format == "srt")
+        return importSubtitles(*textSource, false, outProject, progressCallback);
+    if (format == "vtt")
+        return importSubtitles(*textSource, true, outProject, progressCallback);
+    if (format == "json")
+        return importJSON(*textSource, outProject, progressCallback);
+    if (format == "txt")
+        return importPlainText(*textSource, outProject, progressCallback);
+
+    return false;
 }
 
 // ============================================================================
-// SRT Import
+// SRT / WebVTT Import
 // ============================================================================
 
-bool StandaloneImportFeature::parseSRTEntry(juce::StringArray& lines, int& lineIndex, SubtitleEntry& outEntry) const
+namespace
 {
-    // SRT Format:
-    // 1
-    // 00:00:01,000 --> 00:00:03,500
-    // This is the subtitle text
-    // It can span multiple lines
-    //
-    // (blank line separator)
-
-    if (lineIndex >= lines.size())
-        return false;
-
-    // Skip empty lines
-    while (lineIndex < lines.size() && lines[lineIndex].trim().isEmpty())
-        ++lineIndex;
+    // One clip per cue, with the words spread evenly across the cue duration
+    Narrate::NarrateClip makeClip(const SubtitleTokenizer::Cue& cue, SubtitleTokenizer::Format format,
+                                  std::vector<juce::String>& words)
+    {
+        words.clear();
+        SubtitleTokenizer::splitWords(cue.text, format, words);
 
-    if (lineIndex >= lines.size())
-        return false;
+        Narrate::NarrateClip clip;
+        clip.setStartTime(cue.startTime);
+        clip.setEndTime(cue.endTime);
 
-    // Parse index (line 1)
-    outEntry.index = lines[lineIndex].trim().getIntValue();
-    ++lineIndex;
+        const int wordCount = (int) words.size();
+        if (wordCount > 0)
+        {
+            double timePerWord = clip.getDuration() / wordCount;
+            clip.reserveWords(wordCount);
 
-    if (lineIndex >= lines.size())
-        return false;
+            for (int i = 0; i < wordCount; ++i)
+                clip.addWord(Narrate::NarrateWord(std::move(words[(size_t) i]), i * timePerWord));
+        }
 
-    // Parse timecode (line 2): "00:00:01,000 --> 00:00:03,500"
-    juce::String timecodeLine = lines[lineIndex].trim();
-    NARRATE_LOG_DEBUG("parseSRTEntry: Timecode line: '" << timecodeLine << "'");
-    ++lineIndex;
+        return clip;
+    }
 
-    // Split on " --> " separator
-    int separatorPos = timecodeLine.indexOf("-->");
-    if (separatorPos < 0)
+    bool startsBefore(const Narrate::NarrateClip& a, const Narrate::NarrateClip& b)
     {
-        NARRATE_LOG_DEBUG("parseSRTEntry: No --> separator found");
-        return false;
+        return a.getStartTime() < b.getStartTime();
     }
 
-    juce::String startTimeStr = timecodeLine.substring(0, separatorPos).trim();
-    juce::String endTimeStr = timecodeLine.substring(separatorPos + 3).trim();
+    /**
+     * Parsed clips of one chunk, filled in on a pool thread
+     */
+    struct SubtitleChunk
+    {
+        explicit SubtitleChunk(SubtitleTokenizer chunkTokenizer) : tokenizer(chunkTokenizer) {}
+
+        SubtitleTokenizer tokenizer;
+        std::vector<Narrate::NarrateClip> clips;
+    };
+
+    /**
+     * Move every chunk's clips into the batch in start-time order.
+     * Each chunk is sorted on its own (stably); if the chunks then follow on from
+     * each other they are appended as they are, otherwise they are k-way merged.
+     * Ties go to the earlier chunk, so the result matches a stable sort of the
+     * whole file.
+     */
+    void mergeChunks(std::vector<SubtitleChunk>& chunks, Narrate::NarrateProject::ClipBatch& batch)
+    {
+        bool chunksInOrder = true;
+        const Narrate::NarrateClip* previousLast = nullptr;
 
-    NARRATE_LOG_DEBUG("parseSRTEntry: Start: '" << startTimeStr << "' End: '" << endTimeStr << "'");
+        for (auto& chunk : chunks)
+        {
+            auto& clips = chunk.clips;
+            if (!std::is_sorted(clips.begin(), clips.end(), startsBefore))
+                std::stable_sort(clips.begin(), clips.end(), startsBefore);
 
-    outEntry.startTime = parseTimecode(startTimeStr);
-    outEntry.endTime = parseTimecode(endTimeStr);
-    NARRATE_LOG_DEBUG("parseSRTEntry: Parsed times: " << outEntry.startTime << " -> " << outEntry.endTime);
+            if (clips.empty())
+                continue;
 
-    if (outEntry.startTime < 0.0 || outEntry.endTime < 0.0)
-    {
-        NARRATE_LOG_DEBUG("parseSRTEntry: Invalid times (negative)");
-        return false;
-    }
+            if (previousLast != nullptr && startsBefore(clips.front(), *previousLast))
+                chunksInOrder = false;
 
-    // Parse text (can be multiple lines until blank line)
-    juce::String textContent;
-    while (lineIndex < lines.size() && !lines[lineIndex].trim().isEmpty())
-    {
-        juce::String line = lines[lineIndex].trim();
+            previousLast = &clips.back();
+        }
 
-        // Skip lines with invalid characters or encoding issues
-        if (line.isEmpty())
+        if (chunksInOrder)
         {
-            ++lineIndex;
-            continue;
+            for (auto& chunk : chunks)
+                for (auto& clip : chunk.clips)
+                    batch.add(std::move(clip));
+            return;
         }
 
-        // Remove any zero-width or control characters that might cause issues
-        line = line.replace(juce::CharPointer_UTF8("\xE2\x80\x8B"), "");  // Zero-width space
-        line = line.replace(juce::CharPointer_UTF8("\xEF\xBB\xBF"), "");  // UTF-8 BOM
-        line = line.removeCharacters("\x00\x01\x02\x03\x04\x05\x06\x07\x08\x0B\x0C\x0E\x0F"
-                                    "\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F");  // Control chars
+        // Heap of (chunk index, next clip index); smallest start time on top, earlier chunk on ties
+        using Head = std::pair<size_t, size_t>;
+        auto later = [&chunks](const Head& a, const Head& b)
+        {
+            const auto& clipA = chunks[a.first].clips[a.second];
+            const auto& clipB = chunks[b.first].clips[b.second];
 
-        if (!textContent.isEmpty())
-            textContent += " ";
-        textContent += line;
-        ++lineIndex;
-    }
+            if (clipA.getStartTime() != clipB.getStartTime())
+                return clipA.getStartTime() > clipB.getStartTime();
+            return a.first > b.first;
+        };
 
-    outEntry.text = textContent.trim();
+        std::priority_queue<Head, std::vector<Head>, decltype(later)> heads(later);
 
-    return !textContent.isEmpty();
-}
+        for (size_t c = 0; c < chunks.size(); ++c)
+            if (!chunks[c].clips.empty())
+                heads.push({ c, 0 });
 
-bool StandaloneImportFeature::importSRT(const juce::File& file, Narrate::NarrateProject& outProject, ProgressCallback progressCallback)
-{
-    if (!file.existsAsFile())
-    {
-        NARRATE_LOG_ERROR("importSRT: File does not exist: " << file.getFullPathName());
-        return false;
-    }
+        while (!heads.empty())
+        {
+            auto [c, index] = heads.top();
+            heads.pop();
 
-    // Report start
-    if (progressCallback && !progressCallback(0.0, "Loading SRT file..."))
-        return false;
+            batch.add(std::move(chunks[c].clips[index]));
 
-    juce::String content = file.loadFileAsString();
-    if (content.isEmpty())
-    {
-        NARRATE_LOG_ERROR("importSRT: File content is empty");
-        return false;
+            if (index + 1 < chunks[c].clips.size())
+                heads.push({ c, index + 1 });
+        }
     }
 
-    NARRATE_LOG_INFO("importSRT: File loaded, " << content.length() << " characters");
-
-    // Clear existing project
-    outProject = Narrate::NarrateProject();
-    outProject.setProjectName(file.getFileNameWithoutExtension());
+    /**
+     * Byte-based progress for one import.
+     * Once the callback asks to stop, every later report() returns false.
+     */
+    struct ImportProgress
+    {
+        ImportProgress(ImportFeature::ProgressCallback progressCallback, juce::int64 totalBytes, const char* itemName)
+            : callback(std::move(progressCallback)),
+              total((double) juce::jmax((juce::int64) 1, totalBytes)),
+              interval(juce::jmax((juce::int64) 64 * 1024, totalBytes / 100)),
+              messagePrefix(juce::String("Importing ") + itemName + " ")
+        {
+        }
 
-    // Parse SRT content
-    juce::StringArray lines = juce::StringArray::fromLines(content);
-    int lineIndex = 0;
+        bool report(juce::int64 bytesParsed)
+        {
+            if (cancelled)
+                return false;
 
-    NARRATE_LOG_DEBUG("importSRT: Split into " << lines.size() << " lines");
+            if (!callback || bytesParsed < nextReport)
+                return true;
 
-    if (progressCallback && !progressCallback(0.1, "Parsing SRT entries..."))
-        return false;
+            nextReport = bytesParsed + interval;
 
-    int clipCount = 0;
-    int totalLines = lines.size();
+            double progress = 0.1 + (0.8 * juce::jmin(1.0, (double) bytesParsed / total));
+            cancelled = !callback(progress, messagePrefix + juce::String(numItems) + "...");
+            return !cancelled;
+        }
 
-    while (lineIndex < lines.size())
+        ImportFeature::ProgressCallback callback;
+        double total;
+        juce::int64 interval;
+        juce::int64 nextReport = 0;
+        juce::String messagePrefix;
+        int numItems = 0;
+        int numSkipped = 0;
+        bool cancelled = false;
+    };
+
+    // Read one window's cues on the calling thread
+    bool parseWindow(SubtitleTokenizer& tokenizer, juce::int64 windowStart, Narrate::NarrateProject::ClipBatch& batch,
+                     ImportProgress& progress)
     {
-        // Skip empty lines before trying to parse
-        int startLineIndex = lineIndex;
-        while (lineIndex < lines.size() && lines[lineIndex].trim().isEmpty())
-            ++lineIndex;
-
-        // Check if we've reached the end
-        if (lineIndex >= lines.size())
-            break;
+        const auto format = tokenizer.getFormat();
+        std::vector<juce::String> words;
+        SubtitleTokenizer::Cue cue;
 
-        SubtitleEntry entry;
-        if (parseSRTEntry(lines, lineIndex, entry))
+        while (tokenizer.next(cue))
         {
-            NARRATE_LOG_DEBUG("importSRT: Parsed entry " << entry.index
-                             << " [" << entry.startTime << " -> " << entry.endTime << "]: "
-                             << entry.text);
+            batch.add(makeClip(cue, format, words));
+            progress.numItems++;
 
-            // Create a clip from this entry
-            Narrate::NarrateClip clip;
-            clip.setStartTime(entry.startTime);
-            clip.setEndTime(entry.endTime);
+            if (!progress.report(windowStart + (juce::int64) tokenizer.getPosition()))
+                return false;
+        }
 
-            // Split text into words
-            juce::StringArray words = juce::StringArray::fromTokens(entry.text, " ", "");
+        progress.numSkipped += tokenizer.getNumSkippedBlocks();
+        return true;
+    }
 
-            // Distribute words evenly across the clip duration
-            double clipDuration = clip.getDuration();
-            int wordCount = words.size();
+    /**
+     * Split one window at cue boundaries, parse the chunks on the pool and merge
+     * them back in start-time order. Progress and cancellation stay on the
+     * calling thread; the workers only bump a counter.
+     */
+    bool parseWindowParallel(SubtitleTokenizer& tokenizer, juce::int64 windowStart, juce::ThreadPool& pool,
+                             Narrate::NarrateProject::ClipBatch& batch, ImportProgress& progress)
+    {
+        const auto format = tokenizer.getFormat();
 
-            if (wordCount > 0)
-            {
-                double timePerWord = clipDuration / wordCount;
+        // A few chunks per thread evens out chunks that happen to be slow
+        std::vector<SubtitleChunk> chunks;
+        for (auto& chunkTokenizer : tokenizer.splitAtBlockBoundaries(pool.getNumThreads() * 4))
+            chunks.emplace_back(chunkTokenizer);
 
-                for (int i = 0; i < wordCount; ++i)
-                {
-                    Narrate::NarrateWord word(words[i], i * timePerWord);
-                    clip.addWord(word);
-                }
-            }
+        if (chunks.empty())
+            return true;
 
-            outProject.addClip(clip);
-            clipCount++;
+        std::atomic<juce::int64> bytesParsed { windowStart + (juce::int64) tokenizer.getPosition() };
+        std::atomic<int> chunksRemaining { (int) chunks.size() };
+        std::atomic<bool> cancelled { false };
+        juce::WaitableEvent allChunksDone;
 
-            // Report progress periodically (every 10 clips)
-            if (progressCallback && clipCount % 10 == 0)
-            {
-                double progress = 0.1 + (0.8 * lineIndex / totalLines);
-                juce::String message = "Importing clip " + juce::String(clipCount) + "...";
-                if (!progressCallback(progress, message))
-                    return false;
-            }
-        }
-        else
+        for (auto& chunk : chunks)
         {
-            NARRATE_LOG_WARNING("importSRT: Failed to parse entry at line " << startLineIndex
-                              << " (skipping malformed entry)");
-            // Skip to next line to avoid infinite loop
-            ++lineIndex;
-        }
-    }
-
-    NARRATE_LOG_INFO("importSRT: Total clips imported: " << clipCount);
-
-    // Report completion
-    if (progressCallback && !progressCallback(1.0, "Import complete!"))
-        return false;
+            pool.addJob([&chunk, format, &bytesParsed, &chunksRemaining, &cancelled, &allChunksDone]
+            {
+                std::vector<juce::String> words;
+                SubtitleTokenizer::Cue cue;
+                size_t reportedPosition = 0;
 
-    return outProject.getNumClips() > 0;
-}
+                chunk.clips.reserve(chunk.tokenizer.getSize() / 64);
 
-// ============================================================================
-// WebVTT Import
-// ============================================================================
+                while (!cancelled.load(std::memory_order_relaxed) && chunk.tokenizer.next(cue))
+                {
+                    chunk.clips.push_back(makeClip(cue, format, words));
 
-bool StandaloneImportFeature::parseWebVTTCue(juce::StringArray& lines, int& lineIndex, SubtitleEntry& outEntry) const
-{
-    // WebVTT Format:
-    // WEBVTT
-    //
-    // 00:00:01.000 --> 00:00:03.500
-    // This is the subtitle text
-    //
-    // Optional cue identifiers:
-    // cue1
-    // 00:00:01.000 --> 00:00:03.500
-    // Text
-
-    if (lineIndex >= lines.size())
-        return false;
+                    // Publish progress in coarse steps to keep the shared counter cold
+                    if (chunk.tokenizer.getPosition() - reportedPosition >= 64 * 1024)
+                    {
+                        bytesParsed += (juce::int64) (chunk.tokenizer.getPosition() - reportedPosition);
+                        reportedPosition = chunk.tokenizer.getPosition();
+                    }
+                }
 
-    // Skip empty lines
-    while (lineIndex < lines.size() && lines[lineIndex].trim().isEmpty())
-        ++lineIndex;
+                bytesParsed += (juce::int64) (chunk.tokenizer.getPosition() - reportedPosition);
 
-    if (lineIndex >= lines.size())
-        return false;
+                if (--chunksRemaining == 0)
+                    allChunksDone.signal();
+            });
+        }
 
-    // Check if this line is a cue identifier or timecode
-    juce::String currentLine = lines[lineIndex].trim();
+        while (!allChunksDone.wait(50))
+        {
+            if (!cancelled && !progress.report(bytesParsed.load()))
+                cancelled = true;
+        }
 
-    // If it doesn't contain -->, it might be a cue identifier
-    if (!currentLine.contains("-->"))
-    {
-        // Skip cue identifier
-        ++lineIndex;
-        if (lineIndex >= lines.size())
+        if (cancelled)
             return false;
-        currentLine = lines[lineIndex].trim();
-    }
-
-    // Parse timecode line
-    juce::StringArray timecodes = juce::StringArray::fromTokens(currentLine, "-->", "");
-    if (timecodes.size() != 2)
-        return false;
 
-    outEntry.startTime = parseTimecode(timecodes[0]);
-    outEntry.endTime = parseTimecode(timecodes[1]);
-    ++lineIndex;
+        size_t numClips = 0;
 
-    if (outEntry.startTime < 0.0 || outEntry.endTime < 0.0)
-        return false;
+        for (const auto& chunk : chunks)
+        {
+            numClips += chunk.clips.size();
+            progress.numSkipped += chunk.tokenizer.getNumSkippedBlocks();
+        }
 
-    // Parse text (can be multiple lines until blank line)
-    juce::String textContent;
-    while (lineIndex < lines.size() && !lines[lineIndex].trim().isEmpty())
-    {
-        if (!textContent.isEmpty())
-            textContent += " ";
-        textContent += lines[lineIndex].trim();
-        ++lineIndex;
+        progress.numItems += (int) numClips;
+        mergeChunks(chunks, batch);
+        return progress.report(bytesParsed.load());
     }
-
-    outEntry.text = textContent;
-
-    return !textContent.isEmpty();
 }
 
-bool StandaloneImportFeature::importWebVTT(const juce::File& file, Narrate::NarrateProject& outProject, ProgressCallback progressCallback)
+bool StandaloneImportFeature::importSubtitles(TextImportSource& source, bool isWebVTT, Narrate::NarrateProject& outProject,
+                                              ProgressCallback progressCallback)
 {
-    if (!file.existsAsFile())
-        return false;
+    const char* formatName = isWebVTT ? "WebVTT" : "SRT";
 
     // Report start
-    if (progressCallback && !progressCallback(0.0, "Loading WebVTT file..."))
+    if (progressCallback && !progressCallback(0.0, juce::String("Loading ") + formatName + " file..."))
         return false;
 
-    juce::String content = file.loadFileAsString();
-    if (content.isEmpty())
+    const int numThreads = maxImportThreads > 0 ? maxImportThreads : juce::SystemStats::getNumCpus();
+    const bool parallel = numThreads > 1 && source.getTotalBytes() >= (juce::int64) parallelImportMinBytes;
+
+    // The file is read in windows of whole cues, so memory follows the project rather than the file.
+    // Parallel windows are larger so that every thread gets a few chunks of each.
+    const size_t windowSize = parallel ? juce::jmax(TextBlockReader::defaultWindowSize, parallelImportMinBytes) * (size_t) numThreads
+                                       : TextBlockReader::defaultWindowSize;
+    source.setWindowSize(windowSize);
+    std::string_view window;
+
+    if (!source.nextWindow(window))
+    {
+        NARRATE_LOG_ERROR("import" << formatName << ": File content is empty");
         return false;
+    }
+
+    NARRATE_LOG_INFO("import" << formatName << ": Streaming " << source.getTotalBytes() << " bytes in windows of "
+                     << (juce::int64) windowSize << " bytes" << (parallel ? " on " + juce::String(numThreads) + " threads" : ""));
+
+    const auto format = isWebVTT ? SubtitleTokenizer::Format::WebVTT : SubtitleTokenizer::Format::SRT;
+    SubtitleTokenizer tokenizer(window, format);
 
     // WebVTT must start with "WEBVTT"
-    if (!content.startsWith("WEBVTT"))
+    if (!tokenizer.hasValidHeader())
         return false;
 
-    // Clear existing project
-    outProject = Narrate::NarrateProject();
-    outProject.setProjectName(file.getFileNameWithoutExtension());
-
-    // Parse WebVTT content
-    juce::StringArray lines = juce::StringArray::fromLines(content);
-    int lineIndex = 1; // Skip "WEBVTT" header
+    // Built on the side, so a cancelled or failed import leaves outProject untouched
+    Narrate::NarrateProject project;
+    project.setProjectName(source.getFile().getFileNameWithoutExtension());
 
-    if (progressCallback && !progressCallback(0.1, "Parsing WebVTT cues..."))
+    if (progressCallback && !progressCallback(0.1, isWebVTT ? "Parsing WebVTT cues..." : "Parsing SRT entries..."))
         return false;
 
-    int clipCount = 0;
-    int totalLines = lines.size();
+    ImportProgress progress(progressCallback, source.getTotalBytes(), isWebVTT ? "cue" : "clip");
+    std::unique_ptr<juce::ThreadPool> pool;
+    if (parallel)
+        pool = std::make_unique<juce::ThreadPool>(numThreads);
 
-    while (lineIndex < lines.size())
     {
-        SubtitleEntry entry;
-        if (parseWebVTTCue(lines, lineIndex, entry))
+        // Sort once at the end; a typical cue is well over 64 bytes, so this rarely over-reserves
+        Narrate::NarrateProject::ClipBatch batch(project, (int) juce::jmin(source.getTotalBytes() / 64, (juce::int64) 1 << 20));
+
+        for (;;)
         {
-            // Create a clip from this entry
-            Narrate::NarrateClip clip;
-            clip.setStartTime(entry.startTime);
-            clip.setEndTime(entry.endTime);
+            const bool parsed = pool != nullptr && window.size() >= parallelImportMinBytes
+                                  ? parseWindowParallel(tokenizer, source.getWindowStart(), *pool, batch, progress)
+                                  : parseWindow(tokenizer, source.getWindowStart(), batch, progress);
 
-            // Split text into words
-            juce::StringArray words = juce::StringArray::fromTokens(entry.text, " ", "");
+            // Stop reading as soon as the import is cancelled
+            if (!parsed)
+                return false;
 
-            // Distribute words evenly across the clip duration
-            double clipDuration = clip.getDuration();
-            int wordCount = words.size();
+            if (!source.nextWindow(window))
+                break;
 
-            if (wordCount > 0)
-            {
-                double timePerWord = clipDuration / wordCount;
+            tokenizer = SubtitleTokenizer(window, format, false);
+        }
 
-                for (int i = 0; i < wordCount; ++i)
-                {
-                    Narrate::NarrateWord word(words[i], i * timePerWord);
-                    clip.addWord(word);
-                }
-            }
+        batch.finish();
+    }
 
-            outProject.addClip(clip);
-            clipCount++;
+    if (progress.numSkipped > 0)
+        NARRATE_LOG_WARNING("import" << formatName << ": Skipped " << progress.numSkipped << " malformed entries");
 
-            // Report progress periodically (every 10 clips)
-            if (progressCallback && clipCount % 10 == 0)
-            {
-                double progress = 0.1 + (0.8 * lineIndex / totalLines);
-                juce::String message = "Importing cue " + juce::String(clipCount) + "...";
-                if (!progressCallback(progress, message))
-                    return false;
-            }
-        }
-    }
+    NARRATE_LOG_INFO("import" << formatName << ": Total clips imported: " << project.getNumClips());
+
+    outProject = std::move(project);
 
     // Report completion
     if (progressCallback && !progressCallback(1.0, "Import complete!"))
@@ -424,116 +396,124 @@ bool StandaloneImportFeature::importWebVTT(const juce::File& file, Narrate::Narr
     return outProject.getNumClips() > 0;
 }
 
+bool StandaloneImportFeature::importSRT(const juce::File& file, Narrate::NarrateProject& outProject, ProgressCallback progressCallback)
+{
+    auto source = TextImportSource::open(file);
+    if (source == nullptr)
+    {
+        NARRATE_LOG_ERROR("importSRT: File is missing or empty: " << file.getFullPathName());
+        return false;
+    }
+
+    return importSubtitles(*source, false, outProject, progressCallback);
+}
+
+bool StandaloneImportFeature::importWebVTT(const juce::File& file, Narrate::NarrateProject& outProject, ProgressCallback progressCallback)
+{
+    auto source = TextImportSource::open(file);
+    if (source == nullptr)
+    {
+        NARRATE_LOG_ERROR("importWebVTT: File is missing or empty: " << file.getFullPathName());
+        return false;
+    }
+
+    return importSubtitles(*source, true, outProject, progressCallback);
+}
+
 // ============================================================================
 // Plain Text Import
 // ============================================================================
 
-double StandaloneImportFeature::estimateDuration(const juce::String& text) const
+double StandaloneImportFeature::estimateDuration(int wordCount) const
 {
     // Estimate reading time based on word count
     // Average reading speed: ~2.5 words per second
-    int wordCount = juce::StringArray::fromTokens(text, " ", "").size();
     return std::max(1.0, wordCount / 2.5);
 }
 
 bool StandaloneImportFeature::importPlainText(const juce::File& file, Narrate::NarrateProject& outProject, ProgressCallback progressCallback)
 {
-    if (!file.existsAsFile())
-        return false;
+    auto source = TextImportSource::open(file);
+    return source != nullptr && importPlainText(*source, outProject, progressCallback);
+}
 
+bool StandaloneImportFeature::importPlainText(TextImportSource& source, Narrate::NarrateProject& outProject, ProgressCallback progressCallback)
+{
     // Report start
     if (progressCallback && !progressCallback(0.0, "Loading text file..."))
         return false;
 
-    juce::String content = file.loadFileAsString();
-    if (content.isEmpty())
-        return false;
+    // Paragraphs are separated by blank lines, so they never straddle two windows
+    std::string_view window;
 
-    // Clear existing project
-    outProject = Narrate::NarrateProject();
-    outProject.setProjectName(file.getFileNameWithoutExtension());
+    if (!source.nextWindow(window))
+        return false;
 
-    // Split into paragraphs (separated by blank lines)
-    juce::StringArray lines = juce::StringArray::fromLines(content);
+    // Built on the side, so a cancelled import leaves outProject untouched
+    Narrate::NarrateProject project;
+    project.setProjectName(source.getFile().getFileNameWithoutExtension());
 
     if (progressCallback && !progressCallback(0.1, "Processing paragraphs..."))
         return false;
 
+    ImportProgress progress(progressCallback, source.getTotalBytes(), "paragraph");
+
+    // Paragraphs are laid out back to back, so clips arrive already in order
+    Narrate::NarrateProject::ClipBatch batch(project);
+
     double currentTime = 0.0;
-    juce::String currentParagraph;
-    int totalLines = lines.size();
-    int lineIndex = 0;
-    int paragraphCount = 0;
+    std::vector<juce::String> words;
 
-    for (const auto& line : lines)
+    auto addParagraph = [&]
     {
-        juce::String trimmedLine = line.trim();
+        if (words.empty())
+            return;
 
-        if (trimmedLine.isEmpty())
-        {
-            // End of paragraph
-            if (!currentParagraph.isEmpty())
-            {
-                Narrate::NarrateClip clip;
-                clip.setStartTime(currentTime);
-                double duration = estimateDuration(currentParagraph);
-                clip.setEndTime(currentTime + duration);
+        Narrate::NarrateClip clip;
+        clip.setStartTime(currentTime);
+        double duration = estimateDuration((int) words.size());
+        clip.setEndTime(currentTime + duration);
 
-                // Split into words
-                juce::StringArray words = juce::StringArray::fromTokens(currentParagraph, " ", "");
-                double timePerWord = duration / words.size();
+        double timePerWord = duration / (double) words.size();
+        clip.reserveWords((int) words.size());
 
-                for (int i = 0; i < words.size(); ++i)
-                {
-                    Narrate::NarrateWord word(words[i], i * timePerWord);
-                    clip.addWord(word);
-                }
+        for (size_t i = 0; i < words.size(); ++i)
+            clip.addWord(Narrate::NarrateWord(std::move(words[i]), (double) i * timePerWord));
 
-                outProject.addClip(clip);
-                currentTime += duration;
-                currentParagraph.clear();
-                paragraphCount++;
+        batch.add(std::move(clip));
+        currentTime += duration;
+        words.clear();
+        progress.numItems++;
+    };
 
-                // Report progress periodically (every 5 paragraphs)
-                if (progressCallback && paragraphCount % 5 == 0)
-                {
-                    double progress = 0.1 + (0.8 * lineIndex / totalLines);
-                    juce::String message = "Processing paragraph " + juce::String(paragraphCount) + "...";
-                    if (!progressCallback(progress, message))
-                        return false;
-                }
-            }
-        }
-        else
+    do
+    {
+        size_t position = 0;
+        std::string_view line;
+
+        while (SubtitleTokenizer::readLine(window, position, line))
         {
-            // Continue building paragraph
-            if (!currentParagraph.isEmpty())
-                currentParagraph += " ";
-            currentParagraph += trimmedLine;
-        }
+            // Plain text has no markup, so its words split like SRT text
+            const size_t wordsBefore = words.size();
+            SubtitleTokenizer::splitWords(line, SubtitleTokenizer::Format::SRT, words);
 
-        lineIndex++;
+            // End of paragraph
+            if (words.size() == wordsBefore && line.find_first_not_of(" \t") == std::string_view::npos)
+            {
+                addParagraph();
+
+                if (!progress.report(source.getWindowStart() + (juce::int64) position))
+                    return false;
+            }
+        }
     }
+    while (source.nextWindow(window));
 
     // Add final paragraph if any
-    if (!currentParagraph.isEmpty())
-    {
-        Narrate::NarrateClip clip;
-        clip.setStartTime(currentTime);
-        double duration = estimateDuration(currentParagraph);
-        clip.setEndTime(currentTime + duration);
+    addParagraph();
 
-        juce::StringArray words = juce::StringArray::fromTokens(currentParagraph, " ", "");
-        double timePerWord = duration / words.size();
-
-        for (int i = 0; i < words.size(); ++i)
-        {
-            Narrate::NarrateWord word(words[i], i * timePerWord);
-            clip.addWord(word);
-        }
-
-        outProject.addClip(clip);
-    }
+    batch.finish();
+    outProject = std::move(project);
 
     // Report completion
     if (progressCallback && !progressCallback(1.0, "Import complete!"))
@@ -555,121 +535,358 @@ juce::Colour StandaloneImportFeature::parseColourFromHex(const juce::String& hex
     return juce::Colour::fromString("FF" + hexStr);  // Add alpha channel
 }
 
-bool StandaloneImportFeature::importJSON(const juce::File& file, Narrate::NarrateProject& outProject, ProgressCallback progressCallback)
+namespace
 {
-    if (!file.existsAsFile())
-        return false;
+    using JsonToken = JsonPullParser::Token;
 
-    // Report start
-    if (progressCallback && !progressCallback(0.0, "Loading JSON file..."))
-        return false;
+    bool readNumber(JsonPullParser& json, double& outValue)
+    {
+        auto token = json.next();
+        if (token == JsonToken::Number)
+            outValue = json.getNumber();
 
-    juce::String content = file.loadFileAsString();
-    if (content.isEmpty())
-        return false;
+        return json.skipValue(token);
+    }
 
-    // Parse JSON
-    juce::var jsonData;
-    auto result = juce::JSON::parse(content, jsonData);
+    // Reads a style index. Anything that isn't a whole number in int range gives -1,
+    // which no palette contains, so the style is ignored.
+    bool readStyleIndex(JsonPullParser& json, int& outIndex)
+    {
+        double value = -1.0;
+        if (!readNumber(json, value))
+            return false;
 
-    if (result.failed() || !jsonData.isObject())
-        return false;
+        const bool isIndex = std::isfinite(value) && value == std::floor(value)
+                             && value >= 0.0 && value <= (double) std::numeric_limits<int>::max();
+        outIndex = isIndex ? (int) value : -1;
+        return true;
+    }
+}
 
-    if (progressCallback && !progressCallback(0.2, "Parsing JSON data..."))
-        return false;
+bool StandaloneImportFeature::readFormatting(JsonPullParser& json, Narrate::TextFormatting& outFormatting) const
+{
+    outFormatting = Narrate::TextFormatting();
 
-    // Clear existing project
-    outProject = Narrate::NarrateProject();
+    for (auto token = json.next(); token != JsonToken::EndObject; token = json.next())
+    {
+        if (token != JsonToken::Key)
+            return false;
 
-    // Extract project metadata
-    auto projectObj = jsonData.getDynamicObject();
-    if (projectObj == nullptr)
-        return false;
+        if (json.isString("bold") || json.isString("italic"))
+        {
+            auto& flag = json.isString("bold") ? outFormatting.bold : outFormatting.italic;
+            auto value = json.next();
+            flag = value == JsonToken::True;
+
+            if (!json.skipValue(value))
+                return false;
+        }
+        else if (json.isString("colour"))
+        {
+            auto value = json.next();
+            if (value == JsonToken::String)
+                outFormatting.colour = parseColourFromHex(json.getJuceString());
 
-    outProject.setProjectName(projectObj->getProperty("projectName").toString());
+            if (!json.skipValue(value))
+                return false;
+        }
+        else if (json.isString("fontSizeMultiplier"))
+        {
+            double multiplier = outFormatting.fontSizeMultiplier;
+            if (!readNumber(json, multiplier))
+                return false;
 
-    // Parse clips array
-    auto clipsArray = projectObj->getProperty("clips");
-    if (!clipsArray.isArray())
-        return false;
+            outFormatting.fontSizeMultiplier = (float) multiplier;
+        }
+        else if (!json.skipValue(json.next()))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
 
-    int clipCount = 0;
-    int totalClips = clipsArray.getArray()->size();
+bool StandaloneImportFeature::readClip(JsonPullParser& json, const Narrate::FormattingPalette& palette, Narrate::NarrateClip& outClip) const
+{
+    double startTime = 0.0, endTime = -1.0, duration = 0.0;
 
-    for (const auto& clipVar : *clipsArray.getArray())
+    for (auto token = json.next(); token != JsonToken::EndObject; token = json.next())
     {
-        if (!clipVar.isObject())
-            continue;
+        if (token != JsonToken::Key)
+            return false;
 
-        auto clipObj = clipVar.getDynamicObject();
+        if (json.isString("id"))
+        {
+            auto value = json.next();
+            if (value == JsonToken::String)
+                outClip.setId(json.getJuceString());
 
-        Narrate::NarrateClip clip;
-        double startTime = clipObj->getProperty("startTime");
-        double duration = clipObj->getProperty("duration");
-        clip.setStartTime(startTime);
-        clip.setEndTime(startTime + duration);
+            if (!json.skipValue(value))
+                return false;
+        }
+        else if (json.isString("startTime"))
+        {
+            if (!readNumber(json, startTime))
+                return false;
+        }
+        else if (json.isString("endTime"))
+        {
+            if (!readNumber(json, endTime))
+                return false;
+        }
+        else if (json.isString("duration"))
+        {
+            if (!readNumber(json, duration))
+                return false;
+        }
+        else if (json.isString("defaultStyle"))
+        {
+            int style = -1;
+            if (!readStyleIndex(json, style))
+                return false;
 
-        // Parse default formatting if present
-        if (clipObj->hasProperty("defaultFormatting"))
+            if (palette.contains(style))
+                outClip.setDefaultFormatting(palette[style]);
+        }
+        else if (json.isString("defaultFormatting"))
         {
-            auto fmtObj = clipObj->getProperty("defaultFormatting").getDynamicObject();
-            if (fmtObj != nullptr)
+            auto value = json.next();
+            Narrate::TextFormatting formatting;
+
+            if (value == JsonToken::BeginObject)
+            {
+                if (!readFormatting(json, formatting))
+                    return false;
+                outClip.setDefaultFormatting(formatting);
+            }
+            else if (!json.skipValue(value))
             {
-                Narrate::TextFormatting fmt;
-                fmt.bold = fmtObj->getProperty("bold");
-                fmt.italic = fmtObj->getProperty("italic");
-                fmt.colour = parseColourFromHex(fmtObj->getProperty("colour").toString());
-                fmt.fontSizeMultiplier = fmtObj->getProperty("fontSizeMultiplier");
-                clip.setDefaultFormatting(fmt);
+                return false;
             }
         }
-
-        // Parse words
-        auto wordsArray = clipObj->getProperty("words");
-        if (wordsArray.isArray())
+        else if (json.isString("words"))
         {
-            for (const auto& wordVar : *wordsArray.getArray())
+            auto value = json.next();
+            if (value != JsonToken::BeginArray)
             {
-                if (!wordVar.isObject())
-                    continue;
+                if (!json.skipValue(value))
+                    return false;
+                continue;
+            }
 
-                auto wordObj = wordVar.getDynamicObject();
+            for (auto wordToken = json.next(); wordToken != JsonToken::EndArray; wordToken = json.next())
+            {
+                if (wordToken != JsonToken::BeginObject)
+                {
+                    if (!json.skipValue(wordToken))
+                        return false;
+                    continue;
+                }
 
-                Narrate::NarrateWord word(wordObj->getProperty("text").toString(),
-                                          wordObj->getProperty("time"));
+                Narrate::NarrateWord word;
+                double relativeTime = 0.0, absoluteTime = -1.0;
+                bool hasRelativeTime = false;
 
-                // Parse word-specific formatting if present
-                if (wordObj->hasProperty("formatting"))
+                for (auto key = json.next(); key != JsonToken::EndObject; key = json.next())
                 {
-                    auto fmtObj = wordObj->getProperty("formatting").getDynamicObject();
-                    if (fmtObj != nullptr)
+                    if (key != JsonToken::Key)
+                        return false;
+
+                    if (json.isString("text"))
+                    {
+                        auto text = json.next();
+                        if (text == JsonToken::String)
+                            word.text = json.getJuceString();
+
+                        if (!json.skipValue(text))
+                            return false;
+                    }
+                    else if (json.isString("relativeTime") || json.isString("time"))
+                    {
+                        // "time" is the key older versions read
+                        hasRelativeTime = true;
+                        if (!readNumber(json, relativeTime))
+                            return false;
+                    }
+                    else if (json.isString("absoluteTime"))
+                    {
+                        if (!readNumber(json, absoluteTime))
+                            return false;
+                    }
+                    else if (json.isString("style"))
+                    {
+                        int style = -1;
+                        if (!readStyleIndex(json, style))
+                            return false;
+
+                        if (palette.contains(style))
+                            word.formatting = palette[style];
+                    }
+                    else if (json.isString("formatting"))
                     {
-                        Narrate::TextFormatting fmt;
-                        fmt.bold = fmtObj->getProperty("bold");
-                        fmt.italic = fmtObj->getProperty("italic");
-                        fmt.colour = parseColourFromHex(fmtObj->getProperty("colour").toString());
-                        fmt.fontSizeMultiplier = fmtObj->getProperty("fontSizeMultiplier");
-                        word.formatting = fmt;
+                        auto formattingToken = json.next();
+                        Narrate::TextFormatting formatting;
+
+                        if (formattingToken == JsonToken::BeginObject)
+                        {
+                            if (!readFormatting(json, formatting))
+                                return false;
+                            word.formatting = formatting;
+                        }
+                        else if (!json.skipValue(formattingToken))
+                        {
+                            return false;
+                        }
+                    }
+                    else if (!json.skipValue(json.next()))
+                    {
+                        return false;
                     }
                 }
 
-                clip.addWord(word);
+                // Files with only absolute word times (startTime precedes "words" in exported files)
+                if (!hasRelativeTime && absoluteTime >= 0.0)
+                    relativeTime = absoluteTime - startTime;
+
+                word.relativeTime = relativeTime;
+                outClip.addWord(std::move(word));
             }
         }
+        else if (!json.skipValue(json.next()))
+        {
+            return false;
+        }
+    }
+
+    // endTime is exact; startTime + duration may be off by rounding
+    outClip.setStartTime(startTime);
+    outClip.setEndTime(endTime >= 0.0 ? endTime : startTime + duration);
+    return true;
+}
+
+bool StandaloneImportFeature::importJSON(const juce::File& file, Narrate::NarrateProject& outProject, ProgressCallback progressCallback)
+{
+    auto source = TextImportSource::open(file);
+    return source != nullptr && importJSON(*source, outProject, progressCallback);
+}
+
+bool StandaloneImportFeature::importJSON(TextImportSource& source, Narrate::NarrateProject& outProject, ProgressCallback progressCallback)
+{
+    // Report start
+    if (progressCallback && !progressCallback(0.0, "Loading JSON file..."))
+        return false;
+
+    // The document is read as a token stream, building clips and words directly
+    auto stream = source.createInputStream();
+    JsonPullParser json(*stream);
 
-        outProject.addClip(clip);
-        clipCount++;
+    if (json.next() != JsonToken::BeginObject)
+    {
+        NARRATE_LOG_ERROR("importJSON: Expected a JSON object. " << json.getErrorMessage());
+        return false;
+    }
 
-        // Report progress periodically (every 10 clips)
-        if (progressCallback && clipCount % 10 == 0)
+    // Built on the side, so a malformed file leaves outProject untouched
+    Narrate::NarrateProject project;
+    Narrate::NarrateProject::ClipBatch batch(project);
+    ImportProgress progress(progressCallback, source.getTotalBytes(), "clip");
+    bool hasClips = false;
+
+    // Shared style palette (clips and words refer to entries by index). The exporter
+    // writes it before the clips; references to styles not yet read are ignored.
+    Narrate::FormattingPalette palette;
+
+    for (auto token = json.next(); token != JsonToken::EndObject; token = json.next())
+    {
+        if (token != JsonToken::Key)
         {
-            double progress = 0.2 + (0.7 * clipCount / totalClips);
-            juce::String message = "Importing clip " + juce::String(clipCount) + "/" + juce::String(totalClips) + "...";
-            if (!progressCallback(progress, message))
-                return false;
+            NARRATE_LOG_ERROR("importJSON: " << json.getErrorMessage());
+            return false;
+        }
+
+        if (json.isString("projectName"))
+        {
+            auto value = json.next();
+            if (value == JsonToken::String)
+                project.setProjectName(json.getJuceString());
+
+            if (!json.skipValue(value))
+                break;
+        }
+        else if (json.isString("styles"))
+        {
+            auto value = json.next();
+            if (value != JsonToken::BeginArray)
+            {
+                if (!json.skipValue(value))
+                    break;
+                continue;
+            }
+
+            for (auto style = json.next(); style != JsonToken::EndArray; style = json.next())
+            {
+                Narrate::TextFormatting formatting;
+
+                if (style == JsonToken::BeginObject ? !readFormatting(json, formatting) : !json.skipValue(style))
+                {
+                    NARRATE_LOG_ERROR("importJSON: " << json.getErrorMessage());
+                    return false;
+                }
+
+                palette.append(formatting);
+            }
+        }
+        else if (json.isString("clips"))
+        {
+            auto value = json.next();
+            if (value != JsonToken::BeginArray)
+            {
+                if (!json.skipValue(value))
+                    break;
+                continue;
+            }
+
+            hasClips = true;
+
+            for (auto clipToken = json.next(); clipToken != JsonToken::EndArray; clipToken = json.next())
+            {
+                if (clipToken != JsonToken::BeginObject)
+                {
+                    if (!json.skipValue(clipToken))
+                        break;
+                    continue;
+                }
+
+                Narrate::NarrateClip clip;
+                if (!readClip(json, palette, clip))
+                {
+                    NARRATE_LOG_ERROR("importJSON: " << json.getErrorMessage());
+                    return false;
+                }
+
+                batch.add(std::move(clip));
+                progress.numItems++;
+
+                if (!progress.report(json.getPosition()))
+                    return false;
+            }
+        }
+        else if (!json.skipValue(json.next()))
+        {
+            break;
         }
     }
 
+    if (json.next() != JsonToken::EndOfDocument || !hasClips)
+    {
+        NARRATE_LOG_ERROR("importJSON: " << (hasClips ? json.getErrorMessage() : juce::String("No clips array")));
+        return false;
+    }
+
+    batch.finish();
+    outProject = std::move(project);
+
     // Report completion
     if (progressCallback && !progressCallback(1.0, "Import complete!"))
         return false;
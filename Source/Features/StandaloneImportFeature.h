@@ -1,6 +1,9 @@
 #pragma once
 
 #include "ImportFeature.h"
+#include "TextImportSource.h"
+
+class JsonPullParser;
 
 /**
  * StandaloneImportFeature - Full implementation of ImportFeature
@@ -16,12 +19,16 @@ public:
 
     // Format detection
     bool detectFormat(const juce::File& file, juce::String& outFormat) const override;
+    std::unique_ptr<ImportSource> openForImport(const juce::File& file) const override;
+    std::unique_ptr<ImportSource> openForImport(std::unique_ptr<juce::InputStream> input, const juce::String& format = {},
+                                                const juce::File& file = {}) const override;
 
     // Import operations
     bool importSRT(const juce::File& file, Narrate::NarrateProject& outProject, ProgressCallback progressCallback = nullptr) override;
     bool importWebVTT(const juce::File& file, Narrate::NarrateProject& outProject, ProgressCallback progressCallback = nullptr) override;
     bool importPlainText(const juce::File& file, Narrate::NarrateProject& outProject, ProgressCallback progressCallback = nullptr) override;
     bool importJSON(const juce::File& file, Narrate::NarrateProject& outProject, ProgressCallback progressCallback = nullptr) override;
+    bool importFromSource(ImportSource& source, Narrate::NarrateProject& outProject, ProgressCallback progressCallback = nullptr) override;
 
     // Format support queries
     bool supportsSRT() const override { return true; }
@@ -29,36 +36,49 @@ public:
     bool supportsPlainText() const override { return true; }
     bool supportsJSON() const override { return true; }
 
-private:
-    // Helper methods for parsing
-    struct SubtitleEntry
-    {
-        int index;
-        double startTime;
-        double endTime;
-        juce::String text;
-    };
-
     /**
-     * Parse a single SRT subtitle entry
-     * Returns true if successfully parsed
+     * Threads used to parse large SRT/WebVTT files (0 = one per CPU core, 1 = single-threaded).
+     * Files under parallelImportMinBytes are always parsed on the calling thread.
      */
-    bool parseSRTEntry(juce::StringArray& lines, int& lineIndex, SubtitleEntry& outEntry) const;
+    void setMaxImportThreads(int numThreads) { maxImportThreads = numThreads; }
+    int getMaxImportThreads() const { return maxImportThreads; }
+
+    static constexpr size_t parallelImportMinBytes = 1024 * 1024;
 
+private:
     /**
-     * Parse a single WebVTT cue
-     * Returns true if successfully parsed
+     * Shared SRT/WebVTT import: streams the file in windows of whole cues and
+     * builds one clip per cue with words spread evenly across the cue duration
      */
-    bool parseWebVTTCue(juce::StringArray& lines, int& lineIndex, SubtitleEntry& outEntry) const;
+    bool importSubtitles(TextImportSource& source, bool isWebVTT, Narrate::NarrateProject& outProject,
+                         ProgressCallback progressCallback);
+
+    // Importers for an already opened source
+    bool importPlainText(TextImportSource& source, Narrate::NarrateProject& outProject, ProgressCallback progressCallback);
+    bool importJSON(TextImportSource& source, Narrate::NarrateProject& outProject, ProgressCallback progressCallback);
 
     /**
      * Parse JSON value for color
      */
     juce::Colour parseColourFromHex(const juce::String& hexStr) const;
 
+    /**
+     * Read a JSON formatting object (colour, bold, italic, fontSizeMultiplier)
+     * whose BeginObject was just returned; missing members keep their defaults
+     */
+    bool readFormatting(JsonPullParser& json, Narrate::TextFormatting& outFormatting) const;
+
+    /**
+     * Read one object of the exported "clips" array whose BeginObject was just
+     * returned; style indices are resolved through the palette
+     */
+    bool readClip(JsonPullParser& json, const Narrate::FormattingPalette& palette, Narrate::NarrateClip& outClip) const;
+
     /**
      * Estimate duration for plain text based on word count
      * Uses typical reading speed of ~2.5 words per second
      */
-    double estimateDuration(const juce::String& text) const;
+    double estimateDuration(int wordCount) const;
+
+    int maxImportThreads = 0;
 };
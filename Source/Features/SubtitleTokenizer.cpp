@@ -0,0 +1,405 @@
+#include "SubtitleTokenizer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    std::string_view trim(std::string_view s)
+    {
+        while (!s.empty() && isSpace(s.front()))
+            s.remove_prefix(1);
+        while (!s.empty() && isSpace(s.back()))
+            s.remove_suffix(1);
+        return s;
+    }
+
+    bool startsWith(std::string_view s, std::string_view prefix)
+    {
+        return s.size() >= prefix.size() && s.compare(0, prefix.size(), prefix) == 0;
+    }
+
+    bool startsWithBytes(std::string_view s, const char* bytes, size_t numBytes)
+    {
+        return s.size() >= numBytes && std::memcmp(s.data(), bytes, numBytes) == 0;
+    }
+
+    // WebVTT comment, style and region blocks carry no cue text
+    bool isWebVTTMetadataBlock(std::string_view firstLine)
+    {
+        if (startsWith(firstLine, "NOTE"))
+            return firstLine.size() == 4 || isSpace(firstLine[4]);
+
+        return firstLine == "STYLE" || firstLine == "REGION";
+    }
+
+    // Decodes a WebVTT character reference at the start of s; returns bytes consumed or 0
+    size_t decodeEntity(std::string_view s, std::string& out)
+    {
+        static const struct { const char* name; const char* utf8; } entities[] =
+        {
+            { "&amp;", "&" }, { "&lt;", "<" }, { "&gt;", ">" },
+            { "&quot;", "\"" }, { "&apos;", "'" }, { "&nbsp;", "\xc2\xa0" }
+        };
+
+        for (const auto& entity : entities)
+        {
+            if (startsWith(s, entity.name))
+            {
+                out += entity.utf8;
+                return std::strlen(entity.name);
+            }
+        }
+
+        return 0;
+    }
+
+    // Slow path for words that contain control characters, zero-width spaces,
+    // byte order marks, or (WebVTT) markup and entities
+    void cleanWord(std::string_view word, bool markup, std::string& out)
+    {
+        out.clear();
+
+        for (size_t i = 0; i < word.size();)
+        {
+            auto c = static_cast<unsigned char>(word[i]);
+            auto rest = word.substr(i);
+
+            if (c < 0x20)
+            {
+                ++i;
+            }
+            else if (startsWithBytes(rest, "\xE2\x80\x8B", 3) || startsWithBytes(rest, "\xEF\xBB\xBF", 3))
+            {
+                i += 3;
+            }
+            else if (markup && c == '<')
+            {
+                auto close = word.find('>', i);
+                i = close == std::string_view::npos ? word.size() : close + 1;
+            }
+            else if (markup && c == '&')
+            {
+                auto consumed = decodeEntity(rest, out);
+                if (consumed == 0)
+                    out += '&';
+                i += consumed == 0 ? 1 : consumed;
+            }
+            else
+            {
+                out += static_cast<char>(c);
+                ++i;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// SubtitleTokenizer
+// ============================================================================
+
+SubtitleTokenizer::SubtitleTokenizer(std::string_view text, Format cueFormat, bool hasHeader)
+    : input(text), format(cueFormat)
+{
+    if (!hasHeader)
+        return;
+
+    if (startsWithBytes(input, "\xEF\xBB\xBF", 3))
+        position = 3;
+
+    if (format == Format::WebVTT)
+    {
+        validHeader = startsWith(input.substr(position), "WEBVTT");
+
+        // The header block runs to the first blank line
+        if (validHeader)
+            skipBlock();
+    }
+}
+
+std::vector<SubtitleTokenizer> SubtitleTokenizer::splitAtBlockBoundaries(int maxChunks) const
+{
+    std::vector<SubtitleTokenizer> chunks;
+    const size_t size = input.size();
+    const size_t targetSize = (size - position) / (size_t) std::max(1, maxChunks) + 1;
+
+    SubtitleTokenizer scanner(input, format, false);
+    size_t chunkStart = position;
+
+    while (chunkStart < size)
+    {
+        size_t chunkEnd = size;
+
+        if (size - chunkStart > targetSize)
+        {
+            // Finish the line the target falls in, then run on to the next blank line
+            scanner.position = chunkStart + targetSize;
+            std::string_view line;
+            scanner.readLine(line);
+
+            while (scanner.readLine(line))
+            {
+                if (trim(line).empty())
+                {
+                    chunkEnd = scanner.position;
+                    break;
+                }
+            }
+        }
+
+        chunks.push_back(SubtitleTokenizer(input.substr(chunkStart, chunkEnd - chunkStart), format, false));
+        chunkStart = chunkEnd;
+    }
+
+    return chunks;
+}
+
+bool SubtitleTokenizer::readLine(std::string_view text, size_t& position, std::string_view& outLine)
+{
+    if (position >= text.size())
+        return false;
+
+    const char* start = text.data() + position;
+    const size_t remaining = text.size() - position;
+    const char* newline = static_cast<const char*>(std::memchr(start, '\n', remaining));
+    size_t length = newline != nullptr ? (size_t) (newline - start) : remaining;
+
+    // Old Mac files break lines with a lone '\r'
+    if (const char* cr = static_cast<const char*>(std::memchr(start, '\r', length)); cr != nullptr && cr + 1 != start + length)
+        length = (size_t) (cr - start);
+
+    outLine = std::string_view(start, length);
+    position += length + (position + length < text.size() ? 1 : 0);
+
+    if (!outLine.empty() && outLine.back() == '\r')
+        outLine.remove_suffix(1);
+
+    return true;
+}
+
+bool SubtitleTokenizer::readLine(std::string_view& outLine)
+{
+    return readLine(input, position, outLine);
+}
+
+void SubtitleTokenizer::skipBlock()
+{
+    std::string_view line;
+    while (readLine(line) && !trim(line).empty())
+    {
+    }
+}
+
+bool SubtitleTokenizer::next(Cue& outCue)
+{
+    std::string_view line;
+
+    for (;;)
+    {
+        // Skip blank lines between blocks
+        do
+        {
+            if (!readLine(line))
+                return false;
+            line = trim(line);
+        }
+        while (line.empty());
+
+        if (format == Format::WebVTT && isWebVTTMetadataBlock(line))
+        {
+            skipBlock();
+            continue;
+        }
+
+        // An SRT index or WebVTT cue identifier comes before the timing line
+        if (line.find("-->") == std::string_view::npos)
+        {
+            if (!readLine(line) || trim(line).empty())
+            {
+                ++numSkippedBlocks;
+                continue;
+            }
+            line = trim(line);
+        }
+
+        auto arrow = line.find("-->");
+        if (arrow == std::string_view::npos)
+        {
+            ++numSkippedBlocks;
+            skipBlock();
+            continue;
+        }
+
+        // WebVTT may follow the end time with cue settings, and SRT with coordinates
+        auto endField = trim(line.substr(arrow + 3));
+        endField = endField.substr(0, std::min(endField.find(' '), endField.find('\t')));
+
+        const bool allowMinutesOnly = format == Format::WebVTT;
+        juce::int64 startMs = 0, endMs = 0;
+
+        if (!parseTimecodeMs(line.substr(0, arrow), startMs, allowMinutesOnly)
+            || !parseTimecodeMs(endField, endMs, allowMinutesOnly))
+        {
+            ++numSkippedBlocks;
+            skipBlock();
+            continue;
+        }
+
+        // Text runs until the next blank line
+        const size_t textStart = position;
+        size_t textEnd = textStart;
+
+        while (readLine(line) && !trim(line).empty())
+            textEnd = (size_t) (line.data() + line.size() - input.data());
+
+        if (textEnd == textStart)
+        {
+            ++numSkippedBlocks;
+            continue;
+        }
+
+        outCue.startTime = (double) startMs / 1000.0;
+        outCue.endTime = (double) endMs / 1000.0;
+        outCue.text = input.substr(textStart, textEnd - textStart);
+        return true;
+    }
+}
+
+void SubtitleTokenizer::splitWords(std::string_view cueText, Format format, std::vector<juce::String>& outWords)
+{
+    // Only WebVTT defines markup; SRT text is taken literally as before
+    const bool markup = format == Format::WebVTT;
+    std::string cleaned;
+
+    size_t i = 0;
+    const size_t size = cueText.size();
+
+    while (i < size)
+    {
+        while (i < size && isSpace(cueText[i]))
+            ++i;
+
+        if (i >= size)
+            break;
+
+        const size_t start = i;
+        bool needsCleaning = false;
+
+        while (i < size && !isSpace(cueText[i]))
+        {
+            auto c = static_cast<unsigned char>(cueText[i]);
+
+            if (c < 0x20 || c == 0xE2 || c == 0xEF || (markup && c == '&'))
+                needsCleaning = true;
+
+            // Tags such as <v Some Speaker> may contain spaces
+            if (markup && c == '<')
+            {
+                needsCleaning = true;
+                auto close = cueText.find('>', i);
+                i = close == std::string_view::npos ? size : close + 1;
+                continue;
+            }
+
+            ++i;
+        }
+
+        auto word = cueText.substr(start, i - start);
+
+        if (!needsCleaning)
+        {
+            outWords.push_back(juce::String::fromUTF8(word.data(), (int) word.size()));
+            continue;
+        }
+
+        cleanWord(word, markup, cleaned);
+        if (!cleaned.empty())
+            outWords.push_back(juce::String::fromUTF8(cleaned.data(), (int) cleaned.size()));
+    }
+}
+
+bool SubtitleTokenizer::parseTimecodeMs(std::string_view text, juce::int64& outMilliseconds, bool allowMinutesOnly)
+{
+    text = trim(text);
+
+    juce::int64 fields[3] = {};
+    int numFields = 0;
+    size_t i = 0;
+
+    for (;;)
+    {
+        if (i >= text.size() || !isDigit(text[i]))
+            return false;
+
+        juce::int64 value = 0;
+        int numDigits = 0;
+
+        while (i < text.size() && isDigit(text[i]))
+        {
+            if (++numDigits > 9)
+                return false;
+            value = value * 10 + (text[i++] - '0');
+        }
+
+        fields[numFields++] = value;
+
+        if (numFields < 3 && i < text.size() && text[i] == ':')
+        {
+            ++i;
+            continue;
+        }
+
+        break;
+    }
+
+    if (numFields < 2 || (numFields == 2 && !allowMinutesOnly))
+        return false;
+
+    // Optional fraction; only millisecond precision is kept
+    juce::int64 milliseconds = 0;
+
+    if (i < text.size() && (text[i] == ',' || text[i] == '.'))
+    {
+        ++i;
+        int numDigits = 0;
+
+        while (i < text.size() && isDigit(text[i]))
+        {
+            if (numDigits < 3)
+                milliseconds = milliseconds * 10 + (text[i] - '0');
+            ++numDigits;
+            ++i;
+        }
+
+        if (numDigits == 0)
+            return false;
+
+        for (int d = numDigits; d < 3; ++d)
+            milliseconds *= 10;
+    }
+
+    if (i != text.size())
+        return false;
+
+    const auto hours = numFields == 3 ? fields[0] : 0;
+    const auto minutes = fields[numFields - 2];
+    const auto seconds = fields[numFields - 1];
+
+    outMilliseconds = ((hours * 60 + minutes) * 60 + seconds) * 1000 + milliseconds;
+    return true;
+}
+
+double SubtitleTokenizer::parseTimecode(std::string_view text, bool allowMinutesOnly)
+{
+    juce::int64 milliseconds = 0;
+    return parseTimecodeMs(text, milliseconds, allowMinutesOnly) ? (double) milliseconds / 1000.0 : -1.0;
+}
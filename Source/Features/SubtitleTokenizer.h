@@ -0,0 +1,105 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <string_view>
+#include <vector>
+
+/**
+ * SubtitleTokenizer - Zero-copy cue reader for SRT and WebVTT text
+ *
+ * Walks UTF-8 text held in memory with std::string_view spans into that memory,
+ * so reading a cue allocates nothing. Timecodes are parsed with integer
+ * arithmetic. The only allocations an import needs are the final word strings
+ * made by splitWords().
+ *
+ * Malformed blocks (no "-->" line, unparseable timecodes, no text) are skipped
+ * and counted, the same way the line-based parsers skipped them.
+ */
+class SubtitleTokenizer
+{
+public:
+    enum class Format
+    {
+        SRT,
+        WebVTT
+    };
+
+    struct Cue
+    {
+        double startTime = 0.0;
+        double endTime = 0.0;
+        std::string_view text;  // Text lines of the cue, including the line breaks between them
+    };
+
+    /**
+     * @param text      UTF-8 text (must outlive the tokenizer and every Cue it returns)
+     * @param format    SRT or WebVTT; for WebVTT the "WEBVTT" header block is skipped
+     * @param hasHeader False for text that continues a file (a later TextBlockReader
+     *                  window or a chunk); no byte order mark or header is expected
+     */
+    SubtitleTokenizer(std::string_view text, Format format, bool hasHeader = true);
+
+    /**
+     * Read the next cue
+     * @return false at the end of the input
+     */
+    bool next(Cue& outCue);
+
+    Format getFormat() const { return format; }
+
+    // False for WebVTT input that does not start with the "WEBVTT" signature
+    bool hasValidHeader() const { return validHeader; }
+
+    // Bytes consumed so far, for progress reporting
+    size_t getPosition() const { return position; }
+    size_t getSize() const { return input.size(); }
+
+    int getNumSkippedBlocks() const { return numSkippedBlocks; }
+
+    /**
+     * Read one line starting at position and move position past its line break.
+     * Handles "\n", "\r\n" and lone "\r" line breaks; the break is not part of outLine.
+     * @return false at the end of text
+     */
+    static bool readLine(std::string_view text, size_t& position, std::string_view& outLine);
+
+    /**
+     * Split the unread input into at most maxChunks tokenizers of roughly equal
+     * size for parsing in parallel. Chunks start on block boundaries (after a
+     * blank line), so reading every chunk in order yields exactly the cues this
+     * tokenizer would have returned. Does not advance this tokenizer.
+     */
+    std::vector<SubtitleTokenizer> splitAtBlockBoundaries(int maxChunks) const;
+
+    /**
+     * Split cue text into words and append them to outWords.
+     * Words are separated by whitespace and line breaks. Control characters,
+     * zero-width spaces and byte order marks are removed. For WebVTT, markup
+     * tags such as <v Name> or <00:00:01.000> are dropped and the basic
+     * character entities are decoded.
+     */
+    static void splitWords(std::string_view cueText, Format format, std::vector<juce::String>& outWords);
+
+    /**
+     * Parse a timecode without allocating.
+     * Accepts HH:MM:SS,mmm and HH:MM:SS.mmm, with an optional fraction of 1-3
+     * digits. With allowMinutesOnly, MM:SS.mmm is also accepted (WebVTT).
+     * Surrounding whitespace is ignored.
+     *
+     * @return true and the time in whole milliseconds, or false if malformed
+     */
+    static bool parseTimecodeMs(std::string_view text, juce::int64& outMilliseconds, bool allowMinutesOnly = false);
+
+    // Same as parseTimecodeMs, in seconds, or -1.0 if malformed
+    static double parseTimecode(std::string_view text, bool allowMinutesOnly = false);
+
+private:
+    bool readLine(std::string_view& outLine);
+    void skipBlock();
+
+    std::string_view input;
+    size_t position = 0;
+    Format format;
+    bool validHeader = true;
+    int numSkippedBlocks = 0;
+};
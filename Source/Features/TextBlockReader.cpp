@@ -0,0 +1,174 @@
+#include "TextBlockReader.h"
+#include "TextSanitizer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    bool startsWithBytes(std::string_view s, const char* bytes, size_t numBytes)
+    {
+        return s.size() >= numBytes && std::memcmp(s.data(), bytes, numBytes) == 0;
+    }
+}
+
+TextBlockReader::TextBlockReader(std::unique_ptr<juce::InputStream> stream, size_t windowSize, std::string_view initialBytes)
+    : input(std::move(stream)), buffer(std::max({ windowSize, initialBytes.size(), (size_t) 4096 }))
+{
+    std::memcpy(buffer.data(), initialBytes.data(), initialBytes.size());
+    dataEnd = initialBytes.size();
+
+    if (input != nullptr)
+        totalLength = input->getTotalLength();
+    else
+        endOfStream = true;
+}
+
+TextBlockReader::TextBlockReader(std::string_view text, size_t windowSize)
+    : memoryText(text), memoryWindowSize(std::max(windowSize, (size_t) 4096)), inMemory(true)
+{
+    dataEnd = text.size();
+    totalLength = (juce::int64) text.size();
+    endOfStream = true;
+}
+
+size_t TextBlockReader::findLastBlockBoundary(const char* data, size_t start, size_t end)
+{
+    // Walk back over line breaks looking for a line that holds only whitespace.
+    // A break in the last byte is ignored: it may be the '\r' of a "\r\n" split by the read.
+    for (size_t i = end - 1; i > start; --i)
+    {
+        const char c = data[i - 1];
+        if (c != '\n' && c != '\r')
+            continue;
+
+        const size_t lineEnd = i - 1;
+        size_t j = lineEnd;
+
+        // Both characters of "\r\n" end the same line
+        if (c == '\n' && j > start && data[j - 1] == '\r')
+            --j;
+
+        while (j > start && (data[j - 1] == ' ' || data[j - 1] == '\t'))
+            --j;
+
+        if (j == start || data[j - 1] == '\n' || data[j - 1] == '\r')
+            return lineEnd + 1;
+    }
+
+    return 0;
+}
+
+bool TextBlockReader::readNextWindow(std::string_view& outWindow)
+{
+    if (utf16)
+        return false;
+
+    if (inMemory)
+        return readNextMemoryWindow(outWindow);
+
+    // Keep the unfinished block from the previous window
+    if (dataStart > 0)
+    {
+        std::memmove(buffer.data(), buffer.data() + dataStart, dataEnd - dataStart);
+        dataEnd -= dataStart;
+        dataStart = 0;
+    }
+
+    for (;;)
+    {
+        while (!endOfStream && dataEnd < buffer.size())
+        {
+            const int bytesRead = input->read(buffer.data() + dataEnd, (int) std::min(buffer.size() - dataEnd, (size_t) 1 << 30));
+
+            if (bytesRead <= 0)
+                endOfStream = true;
+            else
+                dataEnd += (size_t) bytesRead;
+        }
+
+        if (startOfStream && (dataEnd >= 2 || endOfStream))
+        {
+            startOfStream = false;
+            const std::string_view head(buffer.data(), dataEnd);
+
+            if (startsWithBytes(head, "\xFF\xFE", 2) || startsWithBytes(head, "\xFE\xFF", 2))
+            {
+                utf16 = true;
+                return false;
+            }
+
+            if (startsWithBytes(head, "\xEF\xBB\xBF", 3))
+            {
+                dataStart = 3;
+                bytesConsumed = 3;
+            }
+        }
+
+        if (dataStart == dataEnd)
+            return false;
+
+        size_t windowEnd = endOfStream ? dataEnd : findLastBlockBoundary(buffer.data(), dataStart, dataEnd);
+
+        if (windowEnd > dataStart)
+        {
+            // Windows end after a line break, so no UTF-8 sequence is cut in two
+            size_t windowSize = windowEnd - dataStart;
+            if (sanitizeText)
+                windowSize = TextSanitizer::sanitize(buffer.data() + dataStart, windowSize);
+
+            outWindow = std::string_view(buffer.data() + dataStart, windowSize);
+            windowStart = bytesConsumed;
+            bytesConsumed += (juce::int64) (windowEnd - dataStart);
+            dataStart = windowEnd;
+            return true;
+        }
+
+        // One block fills the whole buffer; make room for the rest of it
+        buffer.resize(buffer.size() * 2);
+    }
+}
+
+bool TextBlockReader::readNextMemoryWindow(std::string_view& outWindow)
+{
+    if (startOfStream)
+    {
+        startOfStream = false;
+
+        if (startsWithBytes(memoryText, "\xFF\xFE", 2) || startsWithBytes(memoryText, "\xFE\xFF", 2))
+        {
+            utf16 = true;
+            return false;
+        }
+
+        if (startsWithBytes(memoryText, "\xEF\xBB\xBF", 3))
+        {
+            dataStart = 3;
+            bytesConsumed = 3;
+        }
+    }
+
+    if (dataStart == dataEnd)
+        return false;
+
+    // Cut the window back to the last block boundary, doubling it while one block fills it all
+    size_t windowEnd = 0;
+    for (size_t span = memoryWindowSize; windowEnd <= dataStart; span *= 2)
+    {
+        const size_t end = dataEnd - dataStart <= span ? dataEnd : dataStart + span;
+        windowEnd = end == dataEnd ? dataEnd : findLastBlockBoundary(memoryText.data(), dataStart, end);
+    }
+
+    outWindow = memoryText.substr(dataStart, windowEnd - dataStart);
+
+    // The text may be read-only; copy only a window that sanitizing would change
+    if (sanitizeText && !TextSanitizer::isClean(outWindow.data(), outWindow.size()))
+    {
+        buffer.assign(outWindow.begin(), outWindow.end());
+        outWindow = std::string_view(buffer.data(), TextSanitizer::sanitize(buffer.data(), buffer.size()));
+    }
+
+    windowStart = bytesConsumed;
+    bytesConsumed += (juce::int64) (windowEnd - dataStart);
+    dataStart = windowEnd;
+    return true;
+}
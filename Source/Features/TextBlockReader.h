@@ -0,0 +1,86 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * TextBlockReader - Reads a text stream in bounded windows of whole blocks
+ *
+ * A block is a run of lines ended by a blank line: an SRT entry, a WebVTT cue
+ * or a plain text paragraph. Each window holds only complete blocks, so it can
+ * be tokenized on its own, and the reader's memory stays at about windowSize
+ * however large the stream is. A window grows past windowSize only to fit a
+ * single block that is larger than that.
+ *
+ * A UTF-8 byte order mark is skipped. UTF-16 input is not split (see isUTF16()).
+ * With setSanitizeText(), each window is run through TextSanitizer before it
+ * is returned, so it may be shorter than the bytes it was read from.
+ *
+ * Text already in memory (a mapped file) is not copied: its windows point
+ * straight into it, and only a window that sanitizing changes is copied first.
+ */
+class TextBlockReader
+{
+public:
+    static constexpr size_t defaultWindowSize = 1024 * 1024;
+
+    /**
+     * @param stream       Source of the text (may be null, giving no windows)
+     * @param windowSize   Bytes read per window
+     * @param initialBytes Bytes already read from the start of the stream (e.g. for format detection)
+     */
+    explicit TextBlockReader(std::unique_ptr<juce::InputStream> stream, size_t windowSize = defaultWindowSize,
+                             std::string_view initialBytes = {});
+
+    /**
+     * Read text already in memory, such as a mapped file
+     * @param text       Must outlive the reader and every window it returns
+     * @param windowSize Bytes per window
+     */
+    explicit TextBlockReader(std::string_view text, size_t windowSize = defaultWindowSize);
+
+    /**
+     * Read the next window of whole blocks
+     * @param outWindow Valid until the next call
+     * @return false at the end of the stream, or straight away for UTF-16 input
+     */
+    bool readNextWindow(std::string_view& outWindow);
+
+    // Strip control characters, zero-width spaces and malformed UTF-8 from each window
+    void setSanitizeText(bool shouldSanitize) { sanitizeText = shouldSanitize; }
+
+    // True once the first read found a UTF-16 byte order mark; read such input with TextImportSource::readAll()
+    bool isUTF16() const { return utf16; }
+
+    // Stream bytes handed out in windows so far (plus any byte order mark), for progress reporting
+    juce::int64 getBytesConsumed() const { return bytesConsumed; }
+
+    // Stream offset of the last window returned
+    juce::int64 getWindowStart() const { return windowStart; }
+
+    // Stream length, or -1 if unknown
+    juce::int64 getTotalLength() const { return totalLength; }
+
+private:
+    static size_t findLastBlockBoundary(const char* data, size_t start, size_t end);
+    bool readNextMemoryWindow(std::string_view& outWindow);
+
+    std::unique_ptr<juce::InputStream> input;
+    std::string_view memoryText;
+    size_t memoryWindowSize = 0;
+    bool inMemory = false;
+    std::vector<char> buffer;
+    size_t dataStart = 0;
+    size_t dataEnd = 0;
+    juce::int64 bytesConsumed = 0;
+    juce::int64 windowStart = 0;
+    juce::int64 totalLength = -1;
+    bool startOfStream = true;
+    bool endOfStream = false;
+    bool utf16 = false;
+    bool sanitizeText = false;
+
+    JUCE_DECLARE_NON_COPYABLE(TextBlockReader)
+};
@@ -0,0 +1,252 @@
+#include "TextImportSource.h"
+#include "PrefixedInputStream.h"
+#include "SubtitleTokenizer.h"
+#include "TextSanitizer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    std::string_view trim(std::string_view s)
+    {
+        while (!s.empty() && isSpace(s.front()))
+            s.remove_prefix(1);
+        while (!s.empty() && isSpace(s.back()))
+            s.remove_suffix(1);
+        return s;
+    }
+
+    bool startsWith(std::string_view s, std::string_view prefix)
+    {
+        return s.size() >= prefix.size() && s.compare(0, prefix.size(), prefix) == 0;
+    }
+
+    bool startsWithBytes(std::string_view s, const char* bytes, size_t numBytes)
+    {
+        return s.size() >= numBytes && std::memcmp(s.data(), bytes, numBytes) == 0;
+    }
+
+    bool hasUTF16ByteOrderMark(std::string_view s)
+    {
+        return startsWithBytes(s, "\xFF\xFE", 2) || startsWithBytes(s, "\xFE\xFF", 2);
+    }
+
+    juce::String detectFormatOf(std::string_view prefix, bool utf16)
+    {
+        // Sniff UTF-16 through JUCE's decoder; the signatures we look for are all ASCII
+        return utf16 ? TextImportSource::detectFormat(juce::String::createStringFromData(prefix.data(), (int) prefix.size()).toStdString())
+                     : TextImportSource::detectFormat(prefix);
+    }
+}
+
+TextImportSource::TextImportSource(const juce::File& file, const juce::String& format, std::unique_ptr<juce::InputStream> input,
+                                   std::string initialBytes, bool isUTF16)
+    : ImportSource(file, format), stream(std::move(input)), prefix(std::move(initialBytes)), utf16(isUTF16)
+{
+    totalBytes = juce::jmax((juce::int64) prefix.size(), stream->getTotalLength());
+}
+
+TextImportSource::TextImportSource(const juce::File& file, const juce::String& format, std::unique_ptr<juce::MemoryMappedFile> mapping,
+                                   bool isUTF16)
+    : ImportSource(file, format), mappedFile(std::move(mapping)), utf16(isUTF16)
+{
+    totalBytes = (juce::int64) mappedFile->getSize();
+}
+
+std::unique_ptr<TextImportSource> TextImportSource::open(const juce::File& file)
+{
+    if (!file.existsAsFile())
+        return nullptr;
+
+    // Map the file and read it in place; fall back to a stream where mapping fails
+    auto mapping = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+
+    if (mapping->getData() != nullptr && mapping->getSize() > 0)
+    {
+        const std::string_view text(static_cast<const char*>(mapping->getData()), mapping->getSize());
+        const auto prefix = text.substr(0, detectionPrefixSize);
+        const bool utf16 = hasUTF16ByteOrderMark(prefix);
+        const auto format = detectFormatOf(prefix, utf16);
+
+        return std::unique_ptr<TextImportSource>(new TextImportSource(file, format, std::move(mapping), utf16));
+    }
+
+    return open(file.createInputStream(), {}, file);
+}
+
+std::unique_ptr<TextImportSource> TextImportSource::open(std::unique_ptr<juce::InputStream> stream, const juce::String& format,
+                                                         const juce::File& file)
+{
+    if (stream == nullptr)
+        return nullptr;
+
+    if (format.isNotEmpty() && !juce::StringArray { "srt", "vtt", "json", "txt" }.contains(format))
+        return nullptr;
+
+    auto prefix = readPrefix(*stream, detectionPrefixSize);
+    if (prefix.empty())
+        return nullptr;
+
+    const bool utf16 = hasUTF16ByteOrderMark(prefix);
+    const auto detectedFormat = format.isNotEmpty() ? format : detectFormatOf(prefix, utf16);
+
+    return std::unique_ptr<TextImportSource>(new TextImportSource(file, detectedFormat, std::move(stream), std::move(prefix), utf16));
+}
+
+std::string TextImportSource::readPrefix(juce::InputStream& stream, size_t maxBytes)
+{
+    // Pipes can return short reads, so keep reading until the prefix is full or the stream ends
+    std::string prefix(maxBytes, '\0');
+    size_t numRead = 0;
+
+    while (numRead < prefix.size())
+    {
+        const int bytesRead = stream.read(prefix.data() + numRead, (int) (prefix.size() - numRead));
+        if (bytesRead <= 0)
+            break;
+        numRead += (size_t) bytesRead;
+    }
+
+    prefix.resize(numRead);
+    return prefix;
+}
+
+juce::String TextImportSource::detectFormat(std::string_view prefix)
+{
+    if (startsWithBytes(prefix, "\xEF\xBB\xBF", 3))
+        prefix.remove_prefix(3);
+
+    // Check for WebVTT signature
+    if (startsWith(prefix, "WEBVTT"))
+        return "vtt";
+
+    // Check for JSON format (the exporter writes projectName first)
+    auto firstNonSpace = prefix.find_first_not_of(" \t\r\n");
+    if (firstNonSpace != std::string_view::npos && prefix[firstNonSpace] == '{'
+        && prefix.find("\"projectName\"") != std::string_view::npos)
+        return "json";
+
+    // Check for SRT format (numeric index followed by timecode)
+    size_t position = 0;
+    std::string_view indexLine, timingLine;
+
+    if (SubtitleTokenizer::readLine(prefix, position, indexLine) && SubtitleTokenizer::readLine(prefix, position, timingLine))
+    {
+        indexLine = trim(indexLine);
+
+        if (!indexLine.empty() && std::all_of(indexLine.begin(), indexLine.end(), isDigit)
+            && timingLine.find("-->") != std::string_view::npos)
+            return "srt";
+    }
+
+    // Default to plain text
+    return "txt";
+}
+
+bool TextImportSource::nextWindow(std::string_view& outWindow)
+{
+    // UTF-16 can't be split as bytes; convert it all and hand it out once
+    if (utf16)
+    {
+        if (convertedTextRead)
+            return false;
+
+        convertedText = readAll();
+        convertedText.resize(TextSanitizer::sanitize(convertedText.data(), convertedText.size()));
+        convertedTextRead = true;
+        totalBytes = (juce::int64) convertedText.size();
+        windowStart = 0;
+        outWindow = convertedText;
+        return !outWindow.empty();
+    }
+
+    if (reader == nullptr)
+    {
+        if (mappedFile != nullptr)
+            reader = std::make_unique<TextBlockReader>(getMappedText(), windowSize);
+        else
+            reader = std::make_unique<TextBlockReader>(std::move(stream), windowSize, prefix);
+
+        reader->setSanitizeText(true);
+        prefix = {};
+    }
+
+    if (!reader->readNextWindow(outWindow))
+        return false;
+
+    windowStart = reader->getWindowStart();
+    return true;
+}
+
+std::unique_ptr<juce::InputStream> TextImportSource::createInputStream()
+{
+    // UTF-16 is converted up front; the stream reads the converted text in place
+    if (utf16)
+    {
+        convertedText = readAll();
+        return std::make_unique<juce::MemoryInputStream>(convertedText.data(), convertedText.size(), false);
+    }
+
+    if (mappedFile != nullptr)
+    {
+        auto text = getMappedText();
+        if (startsWithBytes(text, "\xEF\xBB\xBF", 3))
+            text.remove_prefix(3);
+
+        return std::make_unique<juce::MemoryInputStream>(text.data(), text.size(), false);
+    }
+
+    if (startsWithBytes(prefix, "\xEF\xBB\xBF", 3))
+        prefix.erase(0, 3);
+
+    return std::make_unique<PrefixedInputStream>(std::move(prefix), std::move(stream));
+}
+
+std::string TextImportSource::readAll()
+{
+    if (mappedFile != nullptr)
+    {
+        auto text = getMappedText();
+
+        if (utf16)
+            return juce::String::createStringFromData(text.data(), (int) text.size()).toStdString();
+
+        if (startsWithBytes(text, "\xEF\xBB\xBF", 3))
+            text.remove_prefix(3);
+
+        return std::string(text);
+    }
+
+    juce::MemoryBlock data(prefix.data(), prefix.size());
+    prefix = {};
+
+    if (stream != nullptr)
+    {
+        stream->readIntoMemoryBlock(data);
+        stream.reset();
+    }
+
+    if (utf16)
+        return juce::String::createStringFromData(data.getData(), (int) data.getSize()).toStdString();
+
+    std::string_view text(static_cast<const char*>(data.getData()), data.getSize());
+    if (startsWithBytes(text, "\xEF\xBB\xBF", 3))
+        text.remove_prefix(3);
+
+    return std::string(text);
+}
+
+std::string_view TextImportSource::getMappedText() const
+{
+    return { static_cast<const char*>(mappedFile->getData()), mappedFile->getSize() };
+}
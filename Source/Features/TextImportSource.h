@@ -0,0 +1,101 @@
+#pragma once
+
+#include "ImportFeature.h"
+#include "TextBlockReader.h"
+#include <juce_core/juce_core.h>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * TextImportSource - ImportSource for the text formats (SRT, WebVTT, JSON, plain text)
+ *
+ * open() reads at most detectionPrefixSize bytes to detect the format and keeps
+ * them; the importer then continues from there with nextWindow() (whole blocks,
+ * bounded memory), createInputStream() (formats parsed as a stream) or readAll().
+ * UTF-16 files are converted to UTF-8 in memory and returned as one window.
+ * Windows are sanitized (see TextSanitizer) before they are returned.
+ *
+ * Files are memory-mapped where possible; their windows and input streams then
+ * read the mapping in place rather than copying the file through a buffer.
+ */
+class TextImportSource : public ImportSource
+{
+public:
+    static constexpr size_t detectionPrefixSize = 4096;
+
+    /**
+     * Open a file and detect its format. The file is mapped if it can be,
+     * and read as a stream otherwise.
+     * @return nullptr if the file is missing, empty or can't be read
+     */
+    static std::unique_ptr<TextImportSource> open(const juce::File& file);
+
+    /**
+     * Open a stream that may not be seekable or know its length (a pipe, stdin)
+     * @param format "srt", "vtt", "json" or "txt" to skip detection; empty to detect
+     * @param file   The file the stream reads, if any (names the imported project)
+     * @return nullptr if the stream is null or empty, or the format is unknown
+     */
+    static std::unique_ptr<TextImportSource> open(std::unique_ptr<juce::InputStream> stream, const juce::String& format = {},
+                                                  const juce::File& file = {});
+
+    // Read up to maxBytes from the start of a stream, allowing for short reads from pipes
+    static std::string readPrefix(juce::InputStream& stream, size_t maxBytes);
+
+    /**
+     * Detect a format from the start of a file, already decoded to UTF-8
+     * (a UTF-8 byte order mark is skipped)
+     * @return "vtt", "json", "srt" or "txt"
+     */
+    static juce::String detectFormat(std::string_view prefix);
+
+    // Bytes per window; set before the first call to nextWindow()
+    void setWindowSize(size_t newWindowSize) { windowSize = newWindowSize; }
+
+    /**
+     * Read the next window of whole blocks (see TextBlockReader)
+     * @param outWindow Valid until the next call
+     * @return false at the end of the file
+     */
+    bool nextWindow(std::string_view& outWindow);
+
+    // The rest of the file as UTF-8, byte order mark removed, not sanitized. Don't mix with nextWindow().
+    std::string readAll();
+
+    /**
+     * The rest of the file as a UTF-8 stream, starting with the detection prefix
+     * (byte order mark removed, not sanitized). Only one of nextWindow(), readAll()
+     * and createInputStream() can be used; the stream must not outlive this source.
+     */
+    std::unique_ptr<juce::InputStream> createInputStream();
+
+    // Offset of the current window in the file, for progress reporting
+    juce::int64 getWindowStart() const { return windowStart; }
+    juce::int64 getTotalBytes() const { return totalBytes; }
+
+    bool isUTF16() const { return utf16; }
+
+    // True if the file is read through a memory mapping rather than a stream
+    bool isMapped() const { return mappedFile != nullptr; }
+
+private:
+    TextImportSource(const juce::File& file, const juce::String& format, std::unique_ptr<juce::InputStream> stream,
+                     std::string prefix, bool isUTF16);
+    TextImportSource(const juce::File& file, const juce::String& format, std::unique_ptr<juce::MemoryMappedFile> mapping,
+                     bool isUTF16);
+
+    std::string_view getMappedText() const;
+
+    std::unique_ptr<juce::InputStream> stream;
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    std::string prefix;
+    bool utf16;
+
+    std::unique_ptr<TextBlockReader> reader;
+    std::string convertedText;
+    bool convertedTextRead = false;
+    size_t windowSize = TextBlockReader::defaultWindowSize;
+    juce::int64 windowStart = 0;
+    juce::int64 totalBytes = 0;
+};
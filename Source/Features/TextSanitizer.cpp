@@ -0,0 +1,281 @@
+#include "TextSanitizer.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define NARRATE_SANITIZER_SSE2 1
+ #define NARRATE_SANITIZER_AVX2 1
+ #include <immintrin.h>
+#else
+ #define NARRATE_SANITIZER_SSE2 0
+ #define NARRATE_SANITIZER_AVX2 0
+#endif
+
+// GCC and Clang only emit AVX2 instructions in functions marked for it; the kernel is picked at runtime
+#if defined(__GNUC__) || defined(__clang__)
+ #define NARRATE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+ #define NARRATE_TARGET_AVX2
+#endif
+
+namespace
+{
+    using Byte = unsigned char;
+
+    bool isContinuation(const Byte* s, size_t remaining, size_t index)
+    {
+        return index < remaining && (s[index] & 0xC0) == 0x80;
+    }
+
+    // Length of the well-formed UTF-8 sequence at s, or 0 if it is malformed
+    // (overlong forms, surrogates and code points above U+10FFFF are malformed)
+    size_t sequenceLength(const Byte* s, size_t remaining)
+    {
+        const Byte c = s[0];
+
+        if (c < 0x80)
+            return 1;
+
+        if (c >= 0xC2 && c <= 0xDF)
+            return isContinuation(s, remaining, 1) ? 2 : 0;
+
+        if (c >= 0xE0 && c <= 0xEF)
+        {
+            if (!isContinuation(s, remaining, 1) || !isContinuation(s, remaining, 2))
+                return 0;
+            if ((c == 0xE0 && s[1] < 0xA0) || (c == 0xED && s[1] >= 0xA0))
+                return 0;
+            return 3;
+        }
+
+        if (c >= 0xF0 && c <= 0xF4)
+        {
+            if (!isContinuation(s, remaining, 1) || !isContinuation(s, remaining, 2) || !isContinuation(s, remaining, 3))
+                return 0;
+            if ((c == 0xF0 && s[1] < 0x90) || (c == 0xF4 && s[1] >= 0x90))
+                return 0;
+            return 4;
+        }
+
+        return 0;
+    }
+
+    bool shouldRemove(const Byte* s, size_t length)
+    {
+        switch (length)
+        {
+            case 1:  return s[0] < 0x20 && s[0] != '\t' && s[0] != '\n' && s[0] != '\r';
+            case 2:  return s[0] == 0xC2 && s[1] < 0xA0;                                   // C1 controls
+            case 3:  return (s[0] == 0xE2 && s[1] == 0x80 && s[2] == 0x8B)                 // zero-width space
+                         || (s[0] == 0xEF && s[1] == 0xBB && s[2] == 0xBF);                // byte order mark
+            default: return false;
+        }
+    }
+
+    /**
+     * Scalar kernel over the sequences starting in [read, end).
+     * A sequence may run past end; read is left at the first byte not consumed.
+     * Writing never overtakes reading, so this works in place.
+     */
+    size_t sanitizeRange(Byte* text, size_t& read, size_t end, size_t size, size_t write)
+    {
+        while (read < end)
+        {
+            const Byte c = text[read];
+
+            if (c >= 0x20 && c < 0x80)
+            {
+                text[write++] = c;
+                ++read;
+                continue;
+            }
+
+            const size_t length = sequenceLength(text + read, size - read);
+
+            // Drop a malformed byte on its own; the decoder resynchronises on the next one
+            if (length == 0)
+            {
+                ++read;
+                continue;
+            }
+
+            if (!shouldRemove(text + read, length))
+                for (size_t i = 0; i < length; ++i)
+                    text[write++] = text[read + i];
+
+            read += length;
+        }
+
+        return write;
+    }
+
+    // Read-only counterpart of sanitizeRange(): false at the first sequence it would change
+    bool isCleanRange(const Byte* text, size_t& read, size_t end, size_t size)
+    {
+        while (read < end)
+        {
+            const Byte c = text[read];
+
+            if (c >= 0x20 && c < 0x80)
+            {
+                ++read;
+                continue;
+            }
+
+            const size_t length = sequenceLength(text + read, size - read);
+            if (length == 0 || shouldRemove(text + read, length))
+                return false;
+
+            read += length;
+        }
+
+        return true;
+    }
+
+   #if NARRATE_SANITIZER_SSE2
+    size_t sanitizeSSE2(char* text, size_t size)
+    {
+        auto* bytes = reinterpret_cast<Byte*>(text);
+        size_t read = 0, write = 0;
+
+        const __m128i lastControl = _mm_set1_epi8(0x1F);
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i lineFeed = _mm_set1_epi8('\n');
+        const __m128i carriageReturn = _mm_set1_epi8('\r');
+
+        while (read + 16 <= size)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + read));
+
+            // Signed compare: 0x20-0x7F pass, control bytes and non-ASCII (negative) bytes fail
+            __m128i keep = _mm_cmpgt_epi8(block, lastControl);
+            keep = _mm_or_si128(keep, _mm_cmpeq_epi8(block, tab));
+            keep = _mm_or_si128(keep, _mm_cmpeq_epi8(block, lineFeed));
+            keep = _mm_or_si128(keep, _mm_cmpeq_epi8(block, carriageReturn));
+
+            if (_mm_movemask_epi8(keep) == 0xFFFF)
+            {
+                if (write != read)
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + write), block);
+
+                read += 16;
+                write += 16;
+                continue;
+            }
+
+            write = sanitizeRange(bytes, read, read + 16, size, write);
+        }
+
+        return sanitizeRange(bytes, read, size, size, write);
+    }
+   #endif
+
+   #if NARRATE_SANITIZER_AVX2
+    NARRATE_TARGET_AVX2 size_t sanitizeAVX2(char* text, size_t size)
+    {
+        auto* bytes = reinterpret_cast<Byte*>(text);
+        size_t read = 0, write = 0;
+
+        const __m256i lastControl = _mm256_set1_epi8(0x1F);
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i lineFeed = _mm256_set1_epi8('\n');
+        const __m256i carriageReturn = _mm256_set1_epi8('\r');
+
+        while (read + 32 <= size)
+        {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + read));
+
+            __m256i keep = _mm256_cmpgt_epi8(block, lastControl);
+            keep = _mm256_or_si256(keep, _mm256_cmpeq_epi8(block, tab));
+            keep = _mm256_or_si256(keep, _mm256_cmpeq_epi8(block, lineFeed));
+            keep = _mm256_or_si256(keep, _mm256_cmpeq_epi8(block, carriageReturn));
+
+            if (_mm256_movemask_epi8(keep) == -1)
+            {
+                if (write != read)
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(bytes + write), block);
+
+                read += 32;
+                write += 32;
+                continue;
+            }
+
+            write = sanitizeRange(bytes, read, read + 32, size, write);
+        }
+
+        return sanitizeRange(bytes, read, size, size, write);
+    }
+   #endif
+
+    struct Kernel
+    {
+        size_t (*function)(char*, size_t);
+        const char* name;
+    };
+
+    const Kernel& getKernel()
+    {
+        static const Kernel kernel = []() -> Kernel
+        {
+           #if NARRATE_SANITIZER_AVX2
+            if (juce::SystemStats::hasAVX2())
+                return { sanitizeAVX2, "avx2" };
+           #endif
+           #if NARRATE_SANITIZER_SSE2
+            return { sanitizeSSE2, "sse2" };
+           #else
+            return { TextSanitizer::sanitizeScalar, "scalar" };
+           #endif
+        }();
+
+        return kernel;
+    }
+}
+
+size_t TextSanitizer::sanitize(char* text, size_t size)
+{
+    return getKernel().function(text, size);
+}
+
+size_t TextSanitizer::sanitizeScalar(char* text, size_t size)
+{
+    size_t read = 0;
+    return sanitizeRange(reinterpret_cast<Byte*>(text), read, size, size, 0);
+}
+
+bool TextSanitizer::isClean(const char* text, size_t size)
+{
+    const auto* bytes = reinterpret_cast<const Byte*>(text);
+    size_t read = 0;
+
+   #if NARRATE_SANITIZER_SSE2
+    const __m128i lastControl = _mm_set1_epi8(0x1F);
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i lineFeed = _mm_set1_epi8('\n');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+
+    while (read + 16 <= size)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + read));
+
+        __m128i keep = _mm_cmpgt_epi8(block, lastControl);
+        keep = _mm_or_si128(keep, _mm_cmpeq_epi8(block, tab));
+        keep = _mm_or_si128(keep, _mm_cmpeq_epi8(block, lineFeed));
+        keep = _mm_or_si128(keep, _mm_cmpeq_epi8(block, carriageReturn));
+
+        if (_mm_movemask_epi8(keep) == 0xFFFF)
+        {
+            read += 16;
+            continue;
+        }
+
+        if (!isCleanRange(bytes, read, read + 16, size))
+            return false;
+    }
+   #endif
+
+    return isCleanRange(bytes, read, size, size);
+}
+
+const char* TextSanitizer::getKernelName()
+{
+    return getKernel().name;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cstddef>
+
+/**
+ * TextSanitizer - Single-pass UTF-8 validate-and-strip kernel for imported text
+ *
+ * Removes, in place:
+ * - C0 control characters other than tab, line feed and carriage return
+ * - C1 control characters (U+0080 - U+009F)
+ * - zero-width spaces (U+200B) and byte order marks (U+FEFF)
+ * - bytes that are not part of a well-formed UTF-8 sequence
+ *
+ * Runs of plain ASCII are checked 32 bytes at a time with AVX2 or 16 at a time
+ * with SSE2 (whichever the CPU supports), and only blocks that contain a
+ * control or non-ASCII byte go through the scalar decoder. On other targets
+ * the scalar kernel does all the work.
+ */
+class TextSanitizer
+{
+public:
+    /**
+     * Sanitize text in place
+     * @return The new length; bytes after it are left unspecified
+     */
+    static size_t sanitize(char* text, size_t size);
+
+    // The portable kernel, same output as sanitize(); exposed for testing and benchmarks
+    static size_t sanitizeScalar(char* text, size_t size);
+
+    // True if sanitize() would leave the text unchanged; reads only, so it works on read-only memory
+    static bool isClean(const char* text, size_t size);
+
+    // Name of the kernel sanitize() uses on this machine ("avx2", "sse2" or "scalar")
+    static const char* getKernelName();
+};
@@ -107,8 +107,8 @@ std::vector<KaraokeRenderStrategy::LineInfo> KaraokeRenderStrategy::calculateLin
 
     for (int wordIndex = 0; wordIndex < words.size(); ++wordIndex)
     {
-        const auto& word = words[wordIndex];
-        auto formatting = word.getEffectiveFormatting (clip.getDefaultFormatting());
+        const auto& word = words.getReference (wordIndex);
+        const auto& formatting = word.getEffectiveFormatting (clip.getDefaultFormatting());
 
         // Calculate word width
         auto fontHeight = baseFontSize * formatting.fontSizeMultiplier;
@@ -157,10 +157,13 @@ void KaraokeRenderStrategy::renderLine (juce::Graphics& g, const RenderContext&
     float areaWidth = static_cast<float>(context.bounds.getWidth());
     float x = calculateLineStartX (areaWidth, line.totalWidth);
 
+    // Only a running timeline that has not passed the end highlights words
+    const bool playbackActive = context.isRunning && context.currentTime < context.project.getTotalDuration();
+
     for (int wordIndex = line.startWordIndex; wordIndex <= line.endWordIndex; ++wordIndex)
     {
-        const auto& word = words[wordIndex];
-        auto formatting = word.getEffectiveFormatting (clip.getDefaultFormatting());
+        const auto& word = words.getReference (wordIndex);
+        const auto& formatting = word.getEffectiveFormatting (clip.getDefaultFormatting());
 
         // Set font with formatting
         auto fontHeight = baseFontSize * formatting.fontSizeMultiplier;
@@ -176,8 +179,7 @@ void KaraokeRenderStrategy::renderLine (juce::Graphics& g, const RenderContext&
 
         // Determine if this word should be highlighted
         bool isCurrentWord = (wordIndex == context.wordIndex) && !isDimmed && !isPreview;
-        bool shouldHighlight = isCurrentWord && context.isRunning &&
-                               context.currentTime < context.project.getTotalDuration();
+        bool shouldHighlight = isCurrentWord && playbackActive && context.highlightActive;
 
         if (shouldHighlight)
         {
@@ -227,28 +229,10 @@ float KaraokeRenderStrategy::calculateLineStartX (float areaWidth, float lineWid
     return (areaWidth / 2.0f) - (lineWidth / 2.0f);
 }
 
-int KaraokeRenderStrategy::findCurrentWordIndex (const Narrate::NarrateClip& clip, double currentTime) const
+int KaraokeRenderStrategy::findCurrentWordIndex (const Narrate::NarrateProject& project, int clipIndex, double currentTime) const
 {
-    const auto& words = clip.getWords();
-    double clipStartTime = clip.getStartTime();
-
-    for (int i = 0; i < words.size(); ++i)
-    {
-        double wordAbsoluteTime = clipStartTime + words[i].relativeTime;
-
-        // Find the next word's time to determine current word's duration
-        double wordEndTime;
-        if (i < words.size() - 1)
-            wordEndTime = clipStartTime + words[i + 1].relativeTime;
-        else
-            wordEndTime = clip.getEndTime();
-
-        // Check if current time falls within this word's duration
-        if (currentTime >= wordAbsoluteTime && currentTime < wordEndTime)
-            return i;
-    }
-
-    return -1; // No word found
+    // Binary search over the project's time index (falls back to a scan if word times are unordered)
+    return project.getWordIndexAtTime (clipIndex, currentTime);
 }
 
 juce::String KaraokeRenderStrategy::getName() const
@@ -30,7 +30,7 @@ public:
 
 private:
     // Helper to find which word is at the center of current playback
-    int findCurrentWordIndex (const Narrate::NarrateClip& clip, double currentTime) const;
+    int findCurrentWordIndex (const Narrate::NarrateProject& project, int clipIndex, double currentTime) const;
 
     // Line information structure
     struct LineInfo
@@ -0,0 +1,460 @@
+#include "NarrateBinaryFormat.h"
+
+#include <string_view>
+#include <unordered_map>
+
+namespace Narrate
+{
+
+namespace
+{
+    constexpr char signature[8] = { 'N', 'A', 'R', 'R', 'B', 'I', 'N', '\0' };
+
+    constexpr size_t headerSize = 128;
+    constexpr size_t clipRecordSize = 40;
+    constexpr size_t wordTimeSize = 8;
+    constexpr size_t wordRecordSize = 12;
+    constexpr size_t styleRecordSize = 16;
+
+    // Header field offsets
+    enum HeaderField : size_t
+    {
+        hdrVersion          = 8,
+        hdrHeaderSize       = 12,
+        hdrNumClips         = 16,
+        hdrNumWords         = 20,
+        hdrNumStyles        = 24,
+        hdrFlags            = 28,
+        hdrClipTable        = 32,
+        hdrWordTimes        = 40,
+        hdrWordTable        = 48,
+        hdrStyleTable       = 56,
+        hdrStringPool       = 64,
+        hdrStringPoolSize   = 72,
+        hdrDefaultFontSize  = 80,
+        hdrDefaultTextColour = 84,
+        hdrHighlightColour  = 88,
+        hdrRenderStrategy   = 92,
+        hdrProjectName      = 96,
+        hdrAudioPath        = 104
+    };
+
+    constexpr juce::uint8 styleBold = 1;
+    constexpr juce::uint8 styleItalic = 2;
+
+    size_t padTo8 (size_t size) { return (size + 7) & ~(size_t) 7; }
+
+    juce::uint32 readU32 (const juce::uint8* p) { return juce::ByteOrder::littleEndianInt (p); }
+    juce::uint64 readU64 (const juce::uint8* p) { return juce::ByteOrder::littleEndianInt64 (p); }
+
+    double readF64 (const juce::uint8* p)
+    {
+        auto bits = readU64 (p);
+        double value;
+        std::memcpy (&value, &bits, sizeof (value));
+        return value;
+    }
+
+    float readF32 (const juce::uint8* p)
+    {
+        auto bits = readU32 (p);
+        float value;
+        std::memcpy (&value, &bits, sizeof (value));
+        return value;
+    }
+
+    //==============================================================================
+    /** (offset, length) reference into the string pool */
+    struct PooledString
+    {
+        juce::uint32 offset = 0;
+        juce::uint32 length = 0;
+    };
+
+    /** Collects UTF-8 strings, storing each distinct string once */
+    class StringPoolBuilder
+    {
+    public:
+        PooledString add (const juce::String& text)
+        {
+            return add (std::string_view (text.toRawUTF8(), text.getNumBytesAsUTF8()));
+        }
+
+        PooledString add (std::string_view text)
+        {
+            const auto numBytes = text.size();
+            if (numBytes == 0)
+                return {};
+
+            std::string key (text);
+            auto found = offsets.find (key);
+            if (found != offsets.end())
+                return { found->second, (juce::uint32) numBytes };
+
+            auto offset = (juce::uint32) data.getDataSize();
+            data.write (key.data(), key.size());
+            offsets.emplace (std::move (key), offset);
+            return { offset, (juce::uint32) numBytes };
+        }
+
+        const void* getData() const { return data.getData(); }
+        size_t getSize() const { return data.getDataSize(); }
+
+    private:
+        juce::MemoryOutputStream data;
+        std::unordered_map<std::string, juce::uint32> offsets;
+    };
+
+    bool writePadding (juce::OutputStream& out, size_t unpaddedSize)
+    {
+        auto padding = padTo8 (unpaddedSize) - unpaddedSize;
+        return padding == 0 || out.writeRepeatedByte (0, padding);
+    }
+
+    bool writeString (juce::OutputStream& out, PooledString s)
+    {
+        return out.writeInt ((int) s.offset) && out.writeInt ((int) s.length);
+    }
+}
+
+//==============================================================================
+// NarrateBinaryFormat
+//==============================================================================
+
+bool NarrateBinaryFormat::isBinaryProject (const void* data, size_t size)
+{
+    return data != nullptr && size >= headerSize && std::memcmp (data, signature, sizeof (signature)) == 0;
+}
+
+bool NarrateBinaryFormat::isBinaryProjectFile (const juce::File& file)
+{
+    juce::FileInputStream stream (file);
+    if (!stream.openedOk())
+        return false;
+
+    char header[headerSize];
+    return stream.read (header, (int) headerSize) == (int) headerSize
+        && isBinaryProject (header, headerSize);
+}
+
+bool NarrateBinaryFormat::write (const NarrateProject& project, juce::OutputStream& out)
+{
+    const int numClips = project.getNumClips();
+    const auto totalWords = (size_t) project.getTotalNumWords();
+
+    // Styles are written in the project palette's order, so its indices are the file's
+    const auto& palette = project.getFormattingPalette();
+    const auto& styles = palette.getStyles();
+
+    // First pass: intern strings, lay out the tables
+    StringPoolBuilder strings;
+
+    auto projectName = strings.add (project.getProjectName());
+    auto audioPath = strings.add (project.getBackgroundAudioFile().getFullPathName());
+
+    struct ClipRecord
+    {
+        double startTime, endTime;
+        PooledString id;
+        juce::uint32 firstWord, numWords, style;
+    };
+
+    struct WordRecord
+    {
+        PooledString text;
+        juce::uint32 style;
+    };
+
+    std::vector<ClipRecord> clipRecords;
+    std::vector<double> wordTimes;
+    std::vector<WordRecord> wordRecords;
+    clipRecords.reserve ((size_t) numClips);
+    wordTimes.reserve (totalWords);
+    wordRecords.reserve (totalWords);
+
+    for (int i = 0; i < numClips; ++i)
+    {
+        const auto& clip = project.getClip (i);
+
+        clipRecords.push_back ({ clip.getStartTime(), clip.getEndTime(), strings.add (clip.getId()),
+                                 (juce::uint32) wordTimes.size(), (juce::uint32) clip.getNumWords(),
+                                 (juce::uint32) palette.indexOf (clip.getDefaultFormatting()) });
+
+        for (const auto& word : clip.getWords())
+        {
+            wordTimes.push_back (word.relativeTime);
+            wordRecords.push_back ({ strings.add (word.text),
+                                     word.formatting.has_value() ? (juce::uint32) palette.indexOf (*word.formatting) : noStyle });
+        }
+    }
+
+    const juce::uint64 clipTableOffset = headerSize;
+    const juce::uint64 wordTimesOffset = clipTableOffset + padTo8 (clipRecords.size() * clipRecordSize);
+    const juce::uint64 wordTableOffset = wordTimesOffset + wordTimes.size() * wordTimeSize;
+    const juce::uint64 styleTableOffset = wordTableOffset + padTo8 (wordRecords.size() * wordRecordSize);
+    const juce::uint64 stringPoolOffset = styleTableOffset + styles.size() * styleRecordSize;
+
+    // Header
+    bool ok = out.write (signature, sizeof (signature))
+           && out.writeInt ((int) currentVersion)
+           && out.writeInt ((int) headerSize)
+           && out.writeInt ((int) clipRecords.size())
+           && out.writeInt ((int) wordRecords.size())
+           && out.writeInt ((int) styles.size())
+           && out.writeInt (0)
+           && out.writeInt64 ((juce::int64) clipTableOffset)
+           && out.writeInt64 ((juce::int64) wordTimesOffset)
+           && out.writeInt64 ((juce::int64) wordTableOffset)
+           && out.writeInt64 ((juce::int64) styleTableOffset)
+           && out.writeInt64 ((juce::int64) stringPoolOffset)
+           && out.writeInt64 ((juce::int64) strings.getSize())
+           && out.writeFloat (project.getDefaultFontSize())
+           && out.writeInt ((int) project.getDefaultTextColour().getARGB())
+           && out.writeInt ((int) project.getHighlightColour().getARGB())
+           && out.writeInt (static_cast<int> (project.getRenderStrategy()))
+           && writeString (out, projectName)
+           && writeString (out, audioPath)
+           && out.writeRepeatedByte (0, headerSize - 112);
+
+    // Clip table
+    for (const auto& clip : clipRecords)
+    {
+        ok = ok && out.writeDouble (clip.startTime)
+                && out.writeDouble (clip.endTime)
+                && writeString (out, clip.id)
+                && out.writeInt ((int) clip.firstWord)
+                && out.writeInt ((int) clip.numWords)
+                && out.writeInt ((int) clip.style)
+                && out.writeInt (0);
+    }
+
+    ok = ok && writePadding (out, clipRecords.size() * clipRecordSize);
+
+    // Packed word times
+    for (auto time : wordTimes)
+        ok = ok && out.writeDouble (time);
+
+    // Word table
+    for (const auto& word : wordRecords)
+        ok = ok && writeString (out, word.text) && out.writeInt ((int) word.style);
+
+    ok = ok && writePadding (out, wordRecords.size() * wordRecordSize);
+
+    // Formatting palette
+    for (const auto& style : styles)
+    {
+        auto flags = (juce::uint8) ((style.bold ? styleBold : 0) | (style.italic ? styleItalic : 0));
+
+        ok = ok && out.writeInt ((int) style.colour.getARGB())
+                && out.writeFloat (style.fontSizeMultiplier)
+                && out.writeByte ((char) flags)
+                && out.writeRepeatedByte (0, 7);
+    }
+
+    // String pool
+    return ok && (strings.getSize() == 0 || out.write (strings.getData(), strings.getSize()));
+}
+
+bool NarrateBinaryFormat::writeToFile (const NarrateProject& project, const juce::File& file)
+{
+    juce::FileOutputStream stream (file);
+    if (!stream.openedOk())
+        return false;
+
+    stream.setPosition (0);
+    stream.truncate();
+
+    if (!write (project, stream))
+        return false;
+
+    stream.flush();
+    return stream.getStatus().wasOk();
+}
+
+bool NarrateBinaryFormat::read (const void* data, size_t size, NarrateProject& outProject)
+{
+    NarrateBinaryProjectView view (data, size);
+    return view.loadInto (outProject);
+}
+
+bool NarrateBinaryFormat::readFromFile (const juce::File& file, NarrateProject& outProject)
+{
+    NarrateBinaryProjectView view (file);
+    return view.loadInto (outProject);
+}
+
+//==============================================================================
+// NarrateBinaryProjectView
+//==============================================================================
+
+NarrateBinaryProjectView::NarrateBinaryProjectView (const juce::File& file)
+{
+    mappedFile = std::make_unique<juce::MemoryMappedFile> (file, juce::MemoryMappedFile::readOnly);
+    open (mappedFile->getData(), mappedFile->getSize());
+}
+
+NarrateBinaryProjectView::NarrateBinaryProjectView (const void* data, size_t size)
+{
+    open (data, size);
+}
+
+void NarrateBinaryProjectView::open (const void* data, size_t size)
+{
+    if (!NarrateBinaryFormat::isBinaryProject (data, size))
+        return;
+
+    base = static_cast<const juce::uint8*> (data);
+    totalSize = size;
+
+    version = readU32 (base + hdrVersion);
+    if (version == 0 || version > NarrateBinaryFormat::currentVersion || readU32 (base + hdrHeaderSize) < headerSize)
+        return;
+
+    numClips = readU32 (base + hdrNumClips);
+    numWords = readU32 (base + hdrNumWords);
+    numStyles = readU32 (base + hdrNumStyles);
+
+    clipTableOffset = readU64 (base + hdrClipTable);
+    wordTimesOffset = readU64 (base + hdrWordTimes);
+    wordTableOffset = readU64 (base + hdrWordTable);
+    styleTableOffset = readU64 (base + hdrStyleTable);
+    stringPoolOffset = readU64 (base + hdrStringPool);
+    stringPoolSize = readU64 (base + hdrStringPoolSize);
+
+    // Every section must lie inside the data; individual records are checked on access
+    auto sectionFits = [size] (juce::uint64 offset, juce::uint64 length)
+    {
+        return offset <= size && length <= size - offset;
+    };
+
+    valid = sectionFits (clipTableOffset, (juce::uint64) numClips * clipRecordSize)
+         && sectionFits (wordTimesOffset, (juce::uint64) numWords * wordTimeSize)
+         && sectionFits (wordTableOffset, (juce::uint64) numWords * wordRecordSize)
+         && sectionFits (styleTableOffset, (juce::uint64) numStyles * styleRecordSize)
+         && sectionFits (stringPoolOffset, stringPoolSize);
+}
+
+juce::String NarrateBinaryProjectView::getString (const juce::uint8* reference) const
+{
+    auto offset = readU32 (reference);
+    auto length = readU32 (reference + 4);
+
+    if (length == 0 || (juce::uint64) offset + length > stringPoolSize)
+        return {};
+
+    return juce::String::fromUTF8 (reinterpret_cast<const char*> (base + stringPoolOffset + offset), (int) length);
+}
+
+const juce::uint8* NarrateBinaryProjectView::clipRecord (int clipIndex) const
+{
+    jassert (valid && juce::isPositiveAndBelow (clipIndex, (int) numClips));
+    return base + clipTableOffset + (size_t) clipIndex * clipRecordSize;
+}
+
+const juce::uint8* NarrateBinaryProjectView::wordRecord (int wordIndex) const
+{
+    jassert (valid && juce::isPositiveAndBelow (wordIndex, (int) numWords));
+    return base + wordTableOffset + (size_t) wordIndex * wordRecordSize;
+}
+
+//==============================================================================
+juce::String NarrateBinaryProjectView::getProjectName() const         { return getString (base + hdrProjectName); }
+juce::String NarrateBinaryProjectView::getBackgroundAudioPath() const { return getString (base + hdrAudioPath); }
+float NarrateBinaryProjectView::getDefaultFontSize() const            { return readF32 (base + hdrDefaultFontSize); }
+juce::Colour NarrateBinaryProjectView::getDefaultTextColour() const   { return juce::Colour (readU32 (base + hdrDefaultTextColour)); }
+juce::Colour NarrateBinaryProjectView::getHighlightColour() const     { return juce::Colour (readU32 (base + hdrHighlightColour)); }
+
+NarrateProject::RenderStrategy NarrateBinaryProjectView::getRenderStrategy() const
+{
+    return static_cast<NarrateProject::RenderStrategy> ((int) readU32 (base + hdrRenderStrategy));
+}
+
+//==============================================================================
+juce::String NarrateBinaryProjectView::getClipId (int clipIndex) const  { return getString (clipRecord (clipIndex) + 16); }
+double NarrateBinaryProjectView::getClipStartTime (int clipIndex) const { return readF64 (clipRecord (clipIndex)); }
+double NarrateBinaryProjectView::getClipEndTime (int clipIndex) const   { return readF64 (clipRecord (clipIndex) + 8); }
+int NarrateBinaryProjectView::getClipFirstWord (int clipIndex) const    { return (int) readU32 (clipRecord (clipIndex) + 24); }
+int NarrateBinaryProjectView::getClipNumWords (int clipIndex) const     { return (int) readU32 (clipRecord (clipIndex) + 28); }
+int NarrateBinaryProjectView::getClipStyleIndex (int clipIndex) const   { return (int) readU32 (clipRecord (clipIndex) + 32); }
+
+double NarrateBinaryProjectView::getWordRelativeTime (int wordIndex) const
+{
+    jassert (valid && juce::isPositiveAndBelow (wordIndex, (int) numWords));
+    return readF64 (base + wordTimesOffset + (size_t) wordIndex * wordTimeSize);
+}
+
+juce::String NarrateBinaryProjectView::getWordText (int wordIndex) const       { return getString (wordRecord (wordIndex)); }
+juce::uint32 NarrateBinaryProjectView::getWordStyleIndex (int wordIndex) const { return readU32 (wordRecord (wordIndex) + 8); }
+
+TextFormatting NarrateBinaryProjectView::getStyle (int styleIndex) const
+{
+    TextFormatting formatting;
+
+    if (!valid || !juce::isPositiveAndBelow (styleIndex, (int) numStyles))
+        return formatting;
+
+    auto* record = base + styleTableOffset + (size_t) styleIndex * styleRecordSize;
+    formatting.colour = juce::Colour (readU32 (record));
+    formatting.fontSizeMultiplier = readF32 (record + 4);
+    formatting.bold = (record[8] & styleBold) != 0;
+    formatting.italic = (record[8] & styleItalic) != 0;
+
+    return formatting;
+}
+
+NarrateClip NarrateBinaryProjectView::getClip (int clipIndex) const
+{
+    NarrateClip clip (getClipId (clipIndex), getClipStartTime (clipIndex), getClipEndTime (clipIndex));
+    clip.setDefaultFormatting (getStyle (getClipStyleIndex (clipIndex)));
+
+    auto firstWord = (juce::uint64) getClipFirstWord (clipIndex);
+    auto wordCount = (juce::uint64) getClipNumWords (clipIndex);
+
+    // A corrupt word range yields a clip without words rather than reading out of bounds
+    if (firstWord + wordCount > numWords)
+        return clip;
+
+    clip.reserveWords ((int) wordCount);
+
+    for (auto w = (int) firstWord; w < (int) (firstWord + wordCount); ++w)
+    {
+        NarrateWord word (getWordText (w), getWordRelativeTime (w));
+
+        auto style = getWordStyleIndex (w);
+        if (style != NarrateBinaryFormat::noStyle)
+            word.formatting = getStyle ((int) style);
+
+        clip.addWord (word);
+    }
+
+    return clip;
+}
+
+bool NarrateBinaryProjectView::loadInto (NarrateProject& outProject) const
+{
+    if (!valid)
+        return false;
+
+    NarrateProject project;
+    project.setProjectName (getProjectName());
+    project.setDefaultFontSize (getDefaultFontSize());
+    project.setDefaultTextColour (getDefaultTextColour());
+    project.setHighlightColour (getHighlightColour());
+    project.setRenderStrategy (getRenderStrategy());
+
+    auto audioPath = getBackgroundAudioPath();
+    if (audioPath.isNotEmpty())
+        project.setBackgroundAudioFile (juce::File (audioPath));
+
+    {
+        NarrateProject::ClipBatch batch (project, (int) numClips);
+
+        for (int i = 0; i < (int) numClips; ++i)
+            batch.add (getClip (i));
+    }
+
+    outProject = std::move (project);
+    return true;
+}
+
+} // namespace Narrate
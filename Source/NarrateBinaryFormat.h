@@ -0,0 +1,116 @@
+#pragma once
+
+#include "NarrateDataModel.h"
+
+namespace Narrate
+{
+
+//==============================================================================
+/**
+    Versioned binary container for NarrateProject.
+
+    XML remains the interchange format; this is the fast native format for large
+    projects. Everything is little-endian and every section starts on an 8-byte
+    boundary, so a memory-mapped file can be read in place without parsing.
+
+    Layout:
+        Header        (128 bytes)  magic, version, counts, section offsets, settings
+        Clip table    (40 bytes per clip)   start, end, id, word range, default style
+        Word times    (8 bytes per word)    packed relative times, in clip order
+        Word table    (12 bytes per word)   text reference, style index
+        Style palette (16 bytes per style)  de-duplicated TextFormatting values
+        String pool   UTF-8 bytes, identical strings are stored once
+
+    Strings are referenced by (offset, length) into the pool. A word style index
+    of noStyle means the word uses its clip's default formatting.
+*/
+class NarrateBinaryFormat
+{
+public:
+    static constexpr juce::uint32 currentVersion = 1;
+    static constexpr juce::uint32 noStyle = 0xffffffffu;
+
+    // Returns true if the data starts with the binary project signature
+    static bool isBinaryProject (const void* data, size_t size);
+    static bool isBinaryProjectFile (const juce::File& file);
+
+    // Writing
+    static bool write (const NarrateProject& project, juce::OutputStream& out);
+    static bool writeToFile (const NarrateProject& project, const juce::File& file);
+
+    // Reading (maps the file and materialises the whole project)
+    static bool read (const void* data, size_t size, NarrateProject& outProject);
+    static bool readFromFile (const juce::File& file, NarrateProject& outProject);
+};
+
+//==============================================================================
+/**
+    Read-only, lazy view over a binary project.
+
+    Opening a view only validates the header and section bounds; clips, words and
+    strings are decoded on demand straight from the mapped memory. Use this when
+    only part of a project is needed, or call loadInto() to build a full project.
+*/
+class NarrateBinaryProjectView
+{
+public:
+    // Memory-maps the file for the lifetime of the view
+    explicit NarrateBinaryProjectView (const juce::File& file);
+
+    // Views existing memory (which must outlive the view)
+    NarrateBinaryProjectView (const void* data, size_t size);
+
+    bool isValid() const { return valid; }
+    juce::uint32 getVersion() const { return version; }
+
+    // Project settings
+    juce::String getProjectName() const;
+    juce::String getBackgroundAudioPath() const;
+    float getDefaultFontSize() const;
+    juce::Colour getDefaultTextColour() const;
+    juce::Colour getHighlightColour() const;
+    NarrateProject::RenderStrategy getRenderStrategy() const;
+
+    // Clip table
+    int getNumClips() const { return (int) numClips; }
+    juce::String getClipId (int clipIndex) const;
+    double getClipStartTime (int clipIndex) const;
+    double getClipEndTime (int clipIndex) const;
+    int getClipFirstWord (int clipIndex) const;
+    int getClipNumWords (int clipIndex) const;
+    int getClipStyleIndex (int clipIndex) const;
+
+    // Word table (indices are project-wide, see getClipFirstWord)
+    int getNumWords() const { return (int) numWords; }
+    double getWordRelativeTime (int wordIndex) const;
+    juce::String getWordText (int wordIndex) const;
+    juce::uint32 getWordStyleIndex (int wordIndex) const;
+
+    // Formatting palette
+    int getNumStyles() const { return (int) numStyles; }
+    TextFormatting getStyle (int styleIndex) const;
+
+    // Decode a single clip, or the whole project
+    NarrateClip getClip (int clipIndex) const;
+    bool loadInto (NarrateProject& outProject) const;
+
+private:
+    void open (const void* data, size_t size);
+    juce::String getString (const juce::uint8* reference) const;
+    const juce::uint8* clipRecord (int clipIndex) const;
+    const juce::uint8* wordRecord (int wordIndex) const;
+
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    const juce::uint8* base = nullptr;
+    size_t totalSize = 0;
+    bool valid = false;
+
+    juce::uint32 version = 0;
+    juce::uint32 numClips = 0, numWords = 0, numStyles = 0;
+    juce::uint64 clipTableOffset = 0, wordTimesOffset = 0, wordTableOffset = 0;
+    juce::uint64 styleTableOffset = 0, stringPoolOffset = 0, stringPoolSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (NarrateBinaryProjectView)
+};
+
+} // namespace Narrate
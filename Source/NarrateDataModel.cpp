@@ -1,4 +1,9 @@
 #include "NarrateDataModel.h"
+#include "NarrateBinaryFormat.h"
+#include "NarrateXmlReader.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 
 namespace Narrate
 {
@@ -31,25 +36,92 @@ std::unique_ptr<juce::XmlElement> TextFormatting::toXml (const juce::String& ele
     return xml;
 }
 
+//==============================================================================
+// FormattingPalette
+//==============================================================================
+
+FormattingPalette::Key FormattingPalette::makeKey (const TextFormatting& formatting)
+{
+    juce::uint32 sizeBits;
+    std::memcpy (&sizeBits, &formatting.fontSizeMultiplier, sizeof (sizeBits));
+    return { formatting.colour.getARGB(), sizeBits, formatting.bold, formatting.italic };
+}
+
+int FormattingPalette::add (const TextFormatting& formatting)
+{
+    auto [position, inserted] = lookup.try_emplace (makeKey (formatting), size());
+    if (inserted)
+        styles.push_back (formatting);
+    return position->second;
+}
+
+int FormattingPalette::append (const TextFormatting& formatting)
+{
+    auto index = size();
+    lookup.try_emplace (makeKey (formatting), index);
+    styles.push_back (formatting);
+    return index;
+}
+
+int FormattingPalette::indexOf (const TextFormatting& formatting) const
+{
+    auto found = lookup.find (makeKey (formatting));
+    return found != lookup.end() ? found->second : -1;
+}
+
+void FormattingPalette::addClipStyles (const NarrateClip& clip)
+{
+    add (clip.getDefaultFormatting());
+
+    for (const auto& word : clip.getWords())
+        if (word.formatting.has_value())
+            add (*word.formatting);
+}
+
+FormattingPalette FormattingPalette::fromXml (const juce::XmlElement& xml)
+{
+    FormattingPalette palette;
+
+    // Indices are positional, so a duplicate entry still takes a slot
+    for (auto* styleXml : xml.getChildWithTagNameIterator ("Style"))
+        palette.append (TextFormatting::fromXml (*styleXml));
+
+    return palette;
+}
+
+std::unique_ptr<juce::XmlElement> FormattingPalette::toXml() const
+{
+    auto xml = std::make_unique<juce::XmlElement> ("Styles");
+
+    for (const auto& style : styles)
+        xml->addChildElement (style.toXml ("Style").release());
+
+    return xml;
+}
+
 //==============================================================================
 // NarrateWord
 //==============================================================================
 
-NarrateWord NarrateWord::fromXml (const juce::XmlElement& xml)
+NarrateWord NarrateWord::fromXml (const juce::XmlElement& xml, const FormattingPalette* palette)
 {
     NarrateWord word;
 
     word.text = xml.getStringAttribute ("text");
     word.relativeTime = xml.getDoubleAttribute ("relativeTime", 0.0);
 
-    // Check for optional formatting
-    if (auto* formattingXml = xml.getChildByName ("Formatting"))
+    // Check for optional formatting, either a palette reference or a full <Formatting> element
+    auto styleIndex = xml.getIntAttribute ("style", -1);
+
+    if (palette != nullptr && palette->contains (styleIndex))
+        word.formatting = (*palette)[styleIndex];
+    else if (auto* formattingXml = xml.getChildByName ("Formatting"))
         word.formatting = TextFormatting::fromXml (*formattingXml);
 
     return word;
 }
 
-std::unique_ptr<juce::XmlElement> NarrateWord::toXml() const
+std::unique_ptr<juce::XmlElement> NarrateWord::toXml (const FormattingPalette* palette) const
 {
     auto xml = std::make_unique<juce::XmlElement> ("Word");
 
@@ -58,7 +130,14 @@ std::unique_ptr<juce::XmlElement> NarrateWord::toXml() const
 
     // Add formatting if it's set
     if (formatting.has_value())
-        xml->addChildElement (formatting->toXml ("Formatting").release());
+    {
+        auto styleIndex = palette != nullptr ? palette->indexOf (*formatting) : -1;
+
+        if (styleIndex >= 0)
+            xml->setAttribute ("style", styleIndex);
+        else
+            xml->addChildElement (formatting->toXml ("Formatting").release());
+    }
 
     return xml;
 }
@@ -67,7 +146,7 @@ std::unique_ptr<juce::XmlElement> NarrateWord::toXml() const
 // NarrateClip
 //==============================================================================
 
-NarrateClip NarrateClip::fromXml (const juce::XmlElement& xml)
+NarrateClip NarrateClip::fromXml (const juce::XmlElement& xml, const FormattingPalette* palette)
 {
     NarrateClip clip;
 
@@ -76,23 +155,29 @@ NarrateClip NarrateClip::fromXml (const juce::XmlElement& xml)
     clip.endTime = xml.getDoubleAttribute ("endTime", 0.0);
 
     // Load default formatting
-    if (auto* formattingXml = xml.getChildByName ("DefaultFormatting"))
+    auto styleIndex = xml.getIntAttribute ("defaultStyle", -1);
+
+    if (palette != nullptr && palette->contains (styleIndex))
+        clip.defaultFormatting = (*palette)[styleIndex];
+    else if (auto* formattingXml = xml.getChildByName ("DefaultFormatting"))
         clip.defaultFormatting = TextFormatting::fromXml (*formattingXml);
 
     // Load words
     if (auto* wordsXml = xml.getChildByName ("Words"))
     {
+        clip.words.ensureStorageAllocated (wordsXml->getNumChildElements());
+
         for (auto* wordXml : wordsXml->getChildIterator())
         {
             if (wordXml->hasTagName ("Word"))
-                clip.words.add (NarrateWord::fromXml (*wordXml));
+                clip.words.add (NarrateWord::fromXml (*wordXml, palette));
         }
     }
 
     return clip;
 }
 
-std::unique_ptr<juce::XmlElement> NarrateClip::toXml() const
+std::unique_ptr<juce::XmlElement> NarrateClip::toXml (const FormattingPalette* palette) const
 {
     auto xml = std::make_unique<juce::XmlElement> ("Clip");
 
@@ -101,16 +186,139 @@ std::unique_ptr<juce::XmlElement> NarrateClip::toXml() const
     xml->setAttribute ("endTime", endTime);
 
     // Add default formatting
-    xml->addChildElement (defaultFormatting.toXml ("DefaultFormatting").release());
+    auto styleIndex = palette != nullptr ? palette->indexOf (defaultFormatting) : -1;
+
+    if (styleIndex >= 0)
+        xml->setAttribute ("defaultStyle", styleIndex);
+    else
+        xml->addChildElement (defaultFormatting.toXml ("DefaultFormatting").release());
 
     // Add words
     auto wordsXml = xml->createNewChildElement ("Words");
     for (const auto& word : words)
-        wordsXml->addChildElement (word.toXml().release());
+        wordsXml->addChildElement (word.toXml (palette).release());
 
     return xml;
 }
 
+//==============================================================================
+// ClipTimeIndex
+//==============================================================================
+
+void ClipTimeIndex::build (const juce::Array<NarrateClip>& clips)
+{
+    const auto numClips = (size_t) clips.size();
+
+    startTimes.resize (numClips);
+    endTimes.resize (numClips);
+    maxEndTimes.resize (numClips);
+    wordsInTimeOrder.resize (numClips);
+
+    double maxEnd = std::numeric_limits<double>::lowest();
+    startsInOrder = true;
+
+    for (size_t i = 0; i < numClips; ++i)
+    {
+        const auto& clip = clips.getReference ((int) i);
+
+        startTimes[i] = clip.getStartTime();
+        startsInOrder = startsInOrder && (i == 0 || startTimes[i - 1] <= startTimes[i]);
+        endTimes[i] = clip.getEndTime();
+        maxEnd = juce::jmax (maxEnd, endTimes[i]);
+        maxEndTimes[i] = maxEnd;
+
+        const auto& words = clip.getWords();
+        bool inOrder = true;
+
+        for (int w = 1; w < words.size() && inOrder; ++w)
+            inOrder = words.getReference (w - 1).relativeTime <= words.getReference (w).relativeTime;
+
+        wordsInTimeOrder[i] = inOrder;
+    }
+}
+
+void ClipTimeIndex::clear()
+{
+    startTimes.clear();
+    endTimes.clear();
+    maxEndTimes.clear();
+    wordsInTimeOrder.clear();
+    startsInOrder = true;
+}
+
+std::pair<int, int> ClipTimeIndex::getCandidateRange (double time) const
+{
+    // A clip edited in place can leave the array unsorted until the next sort - scan everything then
+    if (!startsInOrder)
+        return { 0, (int) startTimes.size() };
+
+    // Clips before 'first' all end at or before time; clips from 'last' on all start after it
+    auto first = std::upper_bound (maxEndTimes.begin(), maxEndTimes.end(), time) - maxEndTimes.begin();
+    auto last = std::upper_bound (startTimes.begin(), startTimes.end(), time) - startTimes.begin();
+
+    return { (int) first, (int) last };
+}
+
+int ClipTimeIndex::findFirstClipAt (double time) const
+{
+    auto [first, last] = getCandidateRange (time);
+
+    for (int i = first; i < last; ++i)
+        if (time >= startTimes[(size_t) i] && time < endTimes[(size_t) i])
+            return i;
+
+    return -1;
+}
+
+int ClipTimeIndex::findClipsAt (double time, juce::Array<int>& result) const
+{
+    result.clearQuick();
+
+    auto [first, last] = getCandidateRange (time);
+
+    for (int i = first; i < last; ++i)
+        if (time >= startTimes[(size_t) i] && time < endTimes[(size_t) i])
+            result.add (i);
+
+    return result.size();
+}
+
+int ClipTimeIndex::findWordAt (const NarrateClip& clip, int clipIndex, double time) const
+{
+    const auto& words = clip.getWords();
+    const int numWords = words.size();
+    const double clipStart = clip.getStartTime();
+
+    auto wordStart = [&] (int i) { return clipStart + words.getReference (i).relativeTime; };
+    auto wordEnd = [&] (int i) { return i < numWords - 1 ? wordStart (i + 1) : clip.getEndTime(); };
+
+    if (juce::isPositiveAndBelow (clipIndex, (int) wordsInTimeOrder.size()) && wordsInTimeOrder[(size_t) clipIndex])
+    {
+        // Last word starting at or before time (binary search over absolute start times)
+        int low = 0, high = numWords;
+
+        while (low < high)
+        {
+            auto mid = low + (high - low) / 2;
+
+            if (wordStart (mid) <= time)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        auto candidate = low - 1;
+        return (candidate >= 0 && time < wordEnd (candidate)) ? candidate : -1;
+    }
+
+    // Words were edited out of order - fall back to a scan
+    for (int i = 0; i < numWords; ++i)
+        if (time >= wordStart (i) && time < wordEnd (i))
+            return i;
+
+    return -1;
+}
+
 //==============================================================================
 // NarrateProject
 //==============================================================================
@@ -124,21 +332,26 @@ bool NarrateProject::saveToFile (const juce::File& file)
     return xml->writeTo (file, juce::XmlElement::TextFormat().singleLine());
 }
 
+bool NarrateProject::saveToBinaryFile (const juce::File& file) const
+{
+    return NarrateBinaryFormat::writeToFile (*this, file);
+}
+
 bool NarrateProject::loadFromFile (const juce::File& file)
 {
-    auto xml = juce::XmlDocument::parse (file);
-    if (xml == nullptr)
-        return false;
+    // Binary projects are recognised by their signature, whatever the extension
+    if (NarrateBinaryFormat::isBinaryProjectFile (file))
+        return NarrateBinaryFormat::readFromFile (file, *this);
 
-    *this = fromXml (*xml);
-    return true;
+    // Stream the XML straight into clips and words instead of building a DOM first
+    return NarrateXmlReader::readFromFile (file, *this);
 }
 
 std::unique_ptr<juce::XmlElement> NarrateProject::toXml() const
 {
     auto xml = std::make_unique<juce::XmlElement> ("NarrateProject");
 
-    xml->setAttribute ("version", "1.0");
+    xml->setAttribute ("version", "1.1");
     xml->setAttribute ("projectName", projectName);
 
     // Global settings
@@ -155,10 +368,14 @@ std::unique_ptr<juce::XmlElement> NarrateProject::toXml() const
         audioXml->setAttribute ("path", backgroundAudioFile.getFullPathName());
     }
 
+    // Formatting palette, written once before the clips that refer to it
+    const auto& palette = getFormattingPalette();
+    xml->addChildElement (palette.toXml().release());
+
     // Clips
     auto clipsXml = xml->createNewChildElement ("Clips");
     for (const auto& clip : clips)
-        clipsXml->addChildElement (clip.toXml().release());
+        clipsXml->addChildElement (clip.toXml (&palette).release());
 
     return xml;
 }
@@ -188,21 +405,132 @@ NarrateProject NarrateProject::fromXml (const juce::XmlElement& xml)
         project.backgroundAudioFile = juce::File (path);
     }
 
-    // Load clips
+    // Load the formatting palette (absent in version 1.0 projects, which store formatting inline)
+    FormattingPalette palette;
+    if (auto* stylesXml = xml.getChildByName ("Styles"))
+        palette = FormattingPalette::fromXml (*stylesXml);
+
+    // Load clips (saved projects are already in start-time order, so the batch normally skips the sort)
     if (auto* clipsXml = xml.getChildByName ("Clips"))
     {
+        ClipBatch batch (project, clipsXml->getNumChildElements());
+
         for (auto* clipXml : clipsXml->getChildIterator())
         {
             if (clipXml->hasTagName ("Clip"))
-                project.clips.add (NarrateClip::fromXml (*clipXml));
+                batch.add (NarrateClip::fromXml (*clipXml, &palette));
         }
-    }
 
-    project.sortClips();
+        batch.finish();
+    }
 
     return project;
 }
 
+//==============================================================================
+// NarrateProject::ClipBatch
+//==============================================================================
+
+NarrateProject::ClipBatch::ClipBatch (NarrateProject& targetProject, int expectedNumClips)
+    : project (targetProject)
+{
+    if (expectedNumClips > 0)
+        project.reserveClips (project.clips.size() + expectedNumClips);
+
+    if (!project.clips.isEmpty())
+        lastStartTime = project.clips.getReference (project.clips.size() - 1).getStartTime();
+}
+
+NarrateProject::ClipBatch::~ClipBatch()
+{
+    finish();
+}
+
+void NarrateProject::ClipBatch::add (const NarrateClip& clip)
+{
+    noteStartTime (clip.getStartTime());
+    project.clips.add (clip);
+}
+
+void NarrateProject::ClipBatch::add (NarrateClip&& clip)
+{
+    noteStartTime (clip.getStartTime());
+    project.clips.add (std::move (clip));
+}
+
+void NarrateProject::ClipBatch::noteStartTime (double startTime)
+{
+    // The first clip only needs checking against clips that were already in the project
+    if ((numAdded > 0 || !project.clips.isEmpty()) && startTime < lastStartTime)
+        needsSort = true;
+
+    lastStartTime = startTime;
+    finished = false;
+    ++numAdded;
+    project.clipsChanged();
+}
+
+void NarrateProject::ClipBatch::finish()
+{
+    if (finished)
+        return;
+
+    // New clips change the layout, so the layout id moves on once per batch rather than per clip
+    if (needsSort)
+    {
+        project.sortClips();
+        lastStartTime = project.clips.getReference (project.clips.size() - 1).getStartTime();
+    }
+    else if (numAdded > 0)
+    {
+        project.clipLayoutChanged();
+    }
+
+    needsSort = false;
+    finished = true;
+}
+
+//==============================================================================
+void NarrateProject::rebuildCache() const
+{
+    cache.timeIndex.build (clips);
+
+    double maxEnd = 0.0;
+    int numWords = 0;
+    bool overlapping = false;
+
+    for (int i = 0; i < clips.size(); ++i)
+    {
+        const auto& clip = clips.getReference (i);
+
+        maxEnd = juce::jmax (maxEnd, clip.getEndTime());
+        numWords += clip.getNumWords();
+
+        if (i + 1 < clips.size() && clip.getEndTime() > clips.getReference (i + 1).getStartTime())
+            overlapping = true;
+    }
+
+    cache.totalDuration = maxEnd;
+    cache.totalNumWords = numWords;
+    cache.hasOverlappingClips = overlapping;
+}
+
+const FormattingPalette& NarrateProject::getFormattingPalette() const
+{
+    if (formattingPalette == nullptr)
+    {
+        auto palette = std::make_shared<FormattingPalette>();
+
+        for (const auto& clip : clips)
+            palette->addClipStyles (clip);
+
+        formattingPalette = std::move (palette);
+    }
+
+    return *formattingPalette;
+}
+
+//==============================================================================
 void NarrateProject::recalculateTimeline()
 {
     if (clips.isEmpty())
@@ -225,4 +553,46 @@ void NarrateProject::recalculateTimeline()
     sortClips();
 }
 
+int NarrateProject::setClipTimes (int index, double startTime, double endTime)
+{
+    auto& clip = clips.getReference (index);
+    clip.setStartTime (startTime);
+    clip.setEndTime (endTime);
+
+    // The other clips are still in order, so the clip's place is a binary search on the side
+    // it moved towards. Clips sharing its start time stay on the side they were on.
+    const auto startsBefore = [] (const NarrateClip& a, double time) { return a.getStartTime() < time; };
+    const auto startsAfter = [] (double time, const NarrateClip& a) { return time < a.getStartTime(); };
+    auto* const begin = clips.begin();
+    auto* const end = clips.end();
+    auto* const current = begin + index;
+    int newIndex = index;
+
+    if (index > 0 && startTime < (current - 1)->getStartTime())
+    {
+        auto* const target = std::upper_bound (begin, current, startTime, startsAfter);
+        std::rotate (target, current, current + 1);
+        newIndex = (int) (target - begin);
+    }
+    else if (index + 1 < clips.size() && (current + 1)->getStartTime() < startTime)
+    {
+        auto* const target = std::lower_bound (current + 1, end, startTime, startsBefore);
+        std::rotate (current, current + 1, target);
+        newIndex = (int) (target - begin) - 1;
+    }
+
+    if (newIndex != index)
+        clipLayoutChanged();
+    else
+        clipsChanged();
+
+    return newIndex;
+}
+
+uint64_t NarrateProject::createClipLayoutId()
+{
+    static std::atomic<uint64_t> nextId { 1 };
+    return nextId.fetch_add (1, std::memory_order_relaxed);
+}
+
 } // namespace Narrate
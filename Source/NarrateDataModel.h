@@ -2,10 +2,17 @@
 
 #include <juce_core/juce_core.h>
 #include <juce_graphics/juce_graphics.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
 
 namespace Narrate
 {
 
+class NarrateClip;
+
 //==============================================================================
 /** Formatting options that can be applied to text */
 struct TextFormatting
@@ -17,6 +24,8 @@ struct TextFormatting
 
     TextFormatting() = default;
 
+    bool operator== (const TextFormatting&) const = default;
+
     // Create from XML
     static TextFormatting fromXml (const juce::XmlElement& xml);
 
@@ -24,6 +33,52 @@ struct TextFormatting
     std::unique_ptr<juce::XmlElement> toXml (const juce::String& elementName) const;
 };
 
+//==============================================================================
+/**
+    Interned table of distinct TextFormatting values.
+
+    Projects use a handful of styles across thousands of words, so serialized
+    projects refer to styles by their index in a palette instead of repeating
+    the full formatting per word.
+
+    The palette is used for saving and loading only. In memory, words and clips
+    keep their own TextFormatting, and loaders resolve style indices back into it.
+*/
+class FormattingPalette
+{
+public:
+    // Returns the index of an equal style, adding it first if needed
+    int add (const TextFormatting& formatting);
+
+    // Adds a style at the next index even if an equal one exists, so loaded palettes keep their indices
+    int append (const TextFormatting& formatting);
+
+    // Index of an equal style, or -1
+    int indexOf (const TextFormatting& formatting) const;
+
+    // Adds a clip's default formatting, then the formatting of each word that has its own
+    void addClipStyles (const NarrateClip& clip);
+
+    const TextFormatting& operator[] (int index) const { return styles[(size_t) index]; }
+    bool contains (int index) const { return juce::isPositiveAndBelow (index, size()); }
+    int size() const { return (int) styles.size(); }
+    bool isEmpty() const { return styles.empty(); }
+    void clear() { styles.clear(); lookup.clear(); }
+
+    const std::vector<TextFormatting>& getStyles() const { return styles; }
+
+    // <Styles> element with one <Style> child per entry, in index order
+    static FormattingPalette fromXml (const juce::XmlElement& xml);
+    std::unique_ptr<juce::XmlElement> toXml() const;
+
+private:
+    using Key = std::tuple<juce::uint32, juce::uint32, bool, bool>;
+    static Key makeKey (const TextFormatting& formatting);
+
+    std::vector<TextFormatting> styles;
+    std::map<Key, int> lookup;
+};
+
 //==============================================================================
 /** Individual word with timing and formatting */
 struct NarrateWord
@@ -39,16 +94,16 @@ struct NarrateWord
         : text (wordText), relativeTime (time) {}
 
     // Get effective formatting (uses word formatting if set, otherwise clip default)
-    TextFormatting getEffectiveFormatting (const TextFormatting& clipDefault) const
+    const TextFormatting& getEffectiveFormatting (const TextFormatting& clipDefault) const
     {
-        return formatting.has_value() ? formatting.value() : clipDefault;
+        return formatting.has_value() ? *formatting : clipDefault;
     }
 
-    // Create from XML
-    static NarrateWord fromXml (const juce::XmlElement& xml);
+    // Create from XML (a "style" attribute is resolved through the palette, if given)
+    static NarrateWord fromXml (const juce::XmlElement& xml, const FormattingPalette* palette = nullptr);
 
-    // Convert to XML
-    std::unique_ptr<juce::XmlElement> toXml() const;
+    // Convert to XML (with a palette, formatting is written as a "style" index)
+    std::unique_ptr<juce::XmlElement> toXml (const FormattingPalette* palette = nullptr) const;
 };
 
 //==============================================================================
@@ -69,15 +124,18 @@ public:
     const TextFormatting& getDefaultFormatting() const { return defaultFormatting; }
 
     // Setters
+    void setId (const juce::String& newId) { id = newId; }
     void setStartTime (double time) { startTime = time; }
     void setEndTime (double time) { endTime = time; }
     void setDefaultFormatting (const TextFormatting& formatting) { defaultFormatting = formatting; }
 
     // Word management
     void addWord (const NarrateWord& word) { words.add (word); }
+    void addWord (NarrateWord&& word) { words.add (std::move (word)); }
     void insertWord (int index, const NarrateWord& word) { words.insert (index, word); }
     void removeWord (int index) { words.remove (index); }
     void clearWords() { words.clear(); }
+    void reserveWords (int numWords) { words.ensureStorageAllocated (numWords); }
     NarrateWord& getWord (int index) { return words.getReference (index); }
     const NarrateWord& getWord (int index) const { return words.getReference (index); }
     int getNumWords() const { return words.size(); }
@@ -108,11 +166,11 @@ public:
         return startTime;
     }
 
-    // Create from XML
-    static NarrateClip fromXml (const juce::XmlElement& xml);
+    // Create from XML (style indices are resolved through the palette, if given)
+    static NarrateClip fromXml (const juce::XmlElement& xml, const FormattingPalette* palette = nullptr);
 
-    // Convert to XML
-    std::unique_ptr<juce::XmlElement> toXml() const;
+    // Convert to XML (with a palette, formatting is written as style indices)
+    std::unique_ptr<juce::XmlElement> toXml (const FormattingPalette* palette = nullptr) const;
 
 private:
     juce::String id;
@@ -124,6 +182,45 @@ private:
     JUCE_LEAK_DETECTOR (NarrateClip)
 };
 
+//==============================================================================
+/**
+    Time lookup structure over a start-time-sorted clip array.
+
+    Stores the clip start and end times contiguously plus a running maximum of the
+    end times. Because the running maximum never decreases, every clip before the
+    first index whose running maximum exceeds t has already ended, and every clip
+    from the first start time after t onwards has not started yet. Both bounds are
+    binary searches, which makes "which clips are active at t" O(log n) plus the
+    clips inside that window, and overlapping clips are handled naturally.
+
+    NarrateProject owns one of these and rebuilds it lazily after edits.
+*/
+class ClipTimeIndex
+{
+public:
+    void build (const juce::Array<NarrateClip>& clips);
+    void clear();
+
+    // First clip (in clip order) with start <= time < end, or -1
+    int findFirstClipAt (double time) const;
+
+    // All clips with start <= time < end, in clip order. Returns the number found.
+    int findClipsAt (double time, juce::Array<int>& result) const;
+
+    // Word whose span [word start, next word start or clip end) contains time, or -1
+    int findWordAt (const NarrateClip& clip, int clipIndex, double time) const;
+
+private:
+    // Range of clips that could be active at time: [first, last)
+    std::pair<int, int> getCandidateRange (double time) const;
+
+    std::vector<double> startTimes;
+    std::vector<double> endTimes;
+    std::vector<double> maxEndTimes;        // maxEndTimes[i] = max (endTimes[0..i])
+    std::vector<bool> wordsInTimeOrder;     // Per clip: word times never decrease
+    bool startsInOrder = true;
+};
+
 //==============================================================================
 /** The complete project containing all clips and settings */
 class NarrateProject
@@ -163,57 +260,113 @@ public:
 
     // Clip management
     void addClip (const NarrateClip& clip) { clips.add (clip); sortClips(); }
+    void addClip (NarrateClip&& clip) { clips.add (std::move (clip)); sortClips(); }
     void insertClip (int index, const NarrateClip& clip) { clips.insert (index, clip); sortClips(); }
-    void removeClip (int index) { clips.remove (index); }
-    void clearClips() { clips.clear(); }
+    void removeClip (int index) { clips.remove (index); clipLayoutChanged(); }
+    void clearClips() { clips.clear(); clipLayoutChanged(); }
+    void reserveClips (int numClips) { clips.ensureStorageAllocated (numClips); }
+
+    //==============================================================================
+    /**
+        Appends many clips and restores start-time order once at the end.
+
+        addClip() re-sorts the whole project on every call, which makes importing
+        N clips O(N^2 log N). A ClipBatch appends without sorting, remembers whether
+        the appended clips arrived in order, and on finish() either does nothing
+        (already sorted - the common case for subtitle files) or sorts once.
+
+        The batch finishes automatically when it goes out of scope.
+
+        Usage:
+            NarrateProject::ClipBatch batch (project, expectedNumClips);
+            batch.add (std::move (clip));
+            ...
+            batch.finish();
+    */
+    class ClipBatch
+    {
+    public:
+        explicit ClipBatch (NarrateProject& targetProject, int expectedNumClips = 0);
+        ~ClipBatch();
+
+        void add (const NarrateClip& clip);
+        void add (NarrateClip&& clip);
+
+        // Restore start-time order (only sorts if the appended clips were out of order)
+        void finish();
+
+        int getNumAdded() const { return numAdded; }
+
+    private:
+        void noteStartTime (double startTime);
+
+        NarrateProject& project;
+        int numAdded = 0;
+        double lastStartTime = 0.0;
+        bool needsSort = false;
+        bool finished = false;
+
+        JUCE_DECLARE_NON_COPYABLE (ClipBatch)
+    };
 
     // Recalculate timeline to remove gaps between clips
     void recalculateTimeline();
 
-    NarrateClip& getClip (int index) { return clips.getReference (index); }
+    /**
+        Sets a clip's start and end time, then moves it to keep the clips in start-time order
+        (where sortClips() would put it). Only the clips between its old and new place move.
+        @return The clip's new index
+    */
+    int setClipTimes (int index, double startTime, double endTime);
+
+    /**
+        Identifies the current order of the clips. It changes whenever clips are added, removed
+        or reordered, and no two layouts share one, even across projects; copies keep it.
+        Editing a clip in place keeps it, so anything indexed by clip (a compiled timeline)
+        can tell whether its indices are still valid.
+    */
+    uint64_t getClipLayoutId() const { return clipLayoutId; }
+
+    // Non-const access assumes the clip is about to be edited and invalidates the time index.
+    // If you keep the reference and edit it after a later time query, call clipsChanged().
+    NarrateClip& getClip (int index) { clipsChanged(); return clips.getReference (index); }
     const NarrateClip& getClip (int index) const { return clips.getReference (index); }
     int getNumClips() const { return clips.size(); }
 
-    // Get clip at a specific time
-    int getClipIndexAtTime (double time) const
-    {
-        for (int i = 0; i < clips.size(); ++i)
-        {
-            const auto& clip = clips.getReference (i);
-            if (time >= clip.getStartTime() && time < clip.getEndTime())
-                return i;
-        }
-        return -1;
-    }
+    // Mark cached time data and aggregates as stale after editing clips or words in place
+    void clipsChanged() { cacheValid = false; formattingPalette.reset(); }
 
-    // Get total duration (end time of last clip)
-    double getTotalDuration() const
-    {
-        if (clips.isEmpty())
-            return 0.0;
+    // Distinct formatting used by the clips and words, in first-use order, for the writers.
+    // Built on first use after clipsChanged() in one pass over the formatting alone.
+    const FormattingPalette& getFormattingPalette() const;
 
-        double maxEnd = 0.0;
-        for (const auto& clip : clips)
-            maxEnd = juce::jmax (maxEnd, clip.getEndTime());
+    // Get clip at a specific time (first in clip order if several overlap) - O(log n)
+    int getClipIndexAtTime (double time) const { return getTimeIndex().findFirstClipAt (time); }
 
-        return maxEnd;
-    }
+    // Get every clip active at a specific time, including overlapping ones
+    int getClipIndicesAtTime (double time, juce::Array<int>& result) const { return getTimeIndex().findClipsAt (time, result); }
 
-    // Validation - check for overlapping clips
-    bool hasOverlappingClips() const
+    // Get the word of a clip that is active at a specific time, or -1
+    int getWordIndexAtTime (int clipIndex, double time) const
     {
-        for (int i = 0; i < clips.size() - 1; ++i)
-        {
-            const auto& current = clips.getReference (i);
-            const auto& next = clips.getReference (i + 1);
-            if (current.getEndTime() > next.getStartTime())
-                return true;
-        }
-        return false;
+        if (!juce::isPositiveAndBelow (clipIndex, clips.size()))
+            return -1;
+
+        return getTimeIndex().findWordAt (clips.getReference (clipIndex), clipIndex, time);
     }
 
-    // Serialization
+    // Get total duration (latest clip end time) - cached, O(1) between edits
+    double getTotalDuration() const { return getCache().totalDuration; }
+
+    // Total number of words across all clips - cached, O(1) between edits
+    int getTotalNumWords() const { return getCache().totalNumWords; }
+
+    // Validation - check for overlapping clips (any clip ending after the next one starts) - cached
+    bool hasOverlappingClips() const { return getCache().hasOverlappingClips; }
+
+    // Serialization (saveToFile writes XML, loadFromFile accepts XML or binary)
     bool saveToFile (const juce::File& file);
+    bool saveToBinaryFile (const juce::File& file) const;
     bool loadFromFile (const juce::File& file);
 
     std::unique_ptr<juce::XmlElement> toXml() const;
@@ -230,12 +383,50 @@ private:
     juce::Colour highlightColour = juce::Colours::yellow;
     RenderStrategy renderStrategy = RenderStrategy::Scrolling;
 
-    // Keep clips sorted by start time
+    uint64_t clipLayoutId = createClipLayoutId();
+
+    // Derived data, rebuilt in one pass on first use after clipsChanged()
+    struct Cache
+    {
+        ClipTimeIndex timeIndex;
+        double totalDuration = 0.0;
+        int totalNumWords = 0;
+        bool hasOverlappingClips = false;
+    };
+
+    mutable Cache cache;
+    mutable bool cacheValid = false;
+
+    // Built separately from the cache, since only saving and exporting need it.
+    // Immutable once built, so copies of the project can share it.
+    mutable std::shared_ptr<const FormattingPalette> formattingPalette;
+
+    const Cache& getCache() const
+    {
+        if (!cacheValid)
+        {
+            rebuildCache();
+            cacheValid = true;
+        }
+
+        return cache;
+    }
+
+    const ClipTimeIndex& getTimeIndex() const { return getCache().timeIndex; }
+    void rebuildCache() const;
+
+    static uint64_t createClipLayoutId();
+
+    // Clips were added, removed or reordered
+    void clipLayoutChanged() { clipLayoutId = createClipLayoutId(); clipsChanged(); }
+
+    // Keep clips sorted by start time (stable, so clips sharing a start time keep insertion order)
     void sortClips()
     {
-        std::sort (clips.begin(), clips.end(),
-                   [] (const NarrateClip& a, const NarrateClip& b)
-                   { return a.getStartTime() < b.getStartTime(); });
+        std::stable_sort (clips.begin(), clips.end(),
+                          [] (const NarrateClip& a, const NarrateClip& b)
+                          { return a.getStartTime() < b.getStartTime(); });
+        clipLayoutChanged();
     }
 
     JUCE_LEAK_DETECTOR (NarrateProject)
@@ -0,0 +1,676 @@
+#include "NarrateXmlReader.h"
+
+namespace Narrate
+{
+
+namespace
+{
+    bool isXmlWhitespace (int c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    void appendUTF8 (std::string& dest, juce::uint32 c)
+    {
+        if (c < 0x80)
+        {
+            dest += (char) c;
+        }
+        else if (c < 0x800)
+        {
+            dest += (char) (0xc0 | (c >> 6));
+            dest += (char) (0x80 | (c & 0x3f));
+        }
+        else if (c < 0x10000)
+        {
+            dest += (char) (0xe0 | (c >> 12));
+            dest += (char) (0x80 | ((c >> 6) & 0x3f));
+            dest += (char) (0x80 | (c & 0x3f));
+        }
+        else
+        {
+            dest += (char) (0xf0 | (c >> 18));
+            dest += (char) (0x80 | ((c >> 12) & 0x3f));
+            dest += (char) (0x80 | ((c >> 6) & 0x3f));
+            dest += (char) (0x80 | (c & 0x3f));
+        }
+    }
+
+    // Same rules as juce::Colour::fromString: hex digits accumulate, anything else is ignored
+    juce::uint32 parseHex32 (const std::string& text)
+    {
+        juce::uint32 result = 0;
+
+        for (auto c : text)
+        {
+            auto digit = juce::CharacterFunctions::getHexDigitValue ((juce::juce_wchar) (unsigned char) c);
+            if (digit >= 0)
+                result = (result << 4) | (juce::uint32) digit;
+        }
+
+        return result;
+    }
+}
+
+//==============================================================================
+// XmlPullParser
+//==============================================================================
+
+XmlPullParser::XmlPullParser (juce::InputStream& source, size_t bufferSize)
+    : input (source), buffer (juce::jmax ((size_t) 4, bufferSize))
+{
+    // Skip a UTF-8 byte order mark
+    if (peekChar() == 0xef)
+    {
+        if (bufferEnd - bufferPos >= 3
+             && (unsigned char) buffer[bufferPos + 1] == 0xbb
+             && (unsigned char) buffer[bufferPos + 2] == 0xbf)
+            bufferPos += 3;
+    }
+}
+
+bool XmlPullParser::refill()
+{
+    if (endOfInput)
+        return false;
+
+    auto numRead = input.read (buffer.data(), (int) buffer.size());
+    bufferPos = 0;
+    bufferEnd = (size_t) juce::jmax (0, numRead);
+
+    if (bufferEnd == 0)
+        endOfInput = true;
+
+    return bufferEnd > 0;
+}
+
+int XmlPullParser::peekChar()
+{
+    if (bufferPos >= bufferEnd && !refill())
+        return -1;
+
+    return (unsigned char) buffer[bufferPos];
+}
+
+int XmlPullParser::readChar()
+{
+    if (bufferPos >= bufferEnd && !refill())
+        return -1;
+
+    return (unsigned char) buffer[bufferPos++];
+}
+
+void XmlPullParser::skipWhitespace()
+{
+    while (isXmlWhitespace (peekChar()))
+        ++bufferPos;
+}
+
+bool XmlPullParser::skipPast (const char* terminator)
+{
+    const auto length = std::strlen (terminator);
+    size_t matched = 0;
+
+    while (matched < length)
+    {
+        auto c = readChar();
+        if (c < 0)
+            return false;
+
+        if (c == terminator[matched])
+            ++matched;
+        else
+            matched = (c == terminator[0]) ? 1 : 0;
+    }
+
+    return true;
+}
+
+bool XmlPullParser::readName (std::string& name)
+{
+    name.clear();
+
+    for (;;)
+    {
+        auto c = peekChar();
+        if (c < 0 || isXmlWhitespace (c) || c == '=' || c == '/' || c == '>' || c == '?')
+            break;
+
+        name += (char) c;
+        ++bufferPos;
+    }
+
+    return !name.empty();
+}
+
+bool XmlPullParser::readEntity (std::string& value)
+{
+    char entity[12];
+    size_t length = 0;
+
+    for (;;)
+    {
+        auto c = readChar();
+        if (c < 0)
+            return false;
+
+        if (c == ';')
+            break;
+
+        if (length == sizeof (entity) - 1)
+            return false;
+
+        entity[length++] = (char) c;
+    }
+
+    entity[length] = 0;
+
+    if (std::strcmp (entity, "amp") == 0)        value += '&';
+    else if (std::strcmp (entity, "lt") == 0)    value += '<';
+    else if (std::strcmp (entity, "gt") == 0)    value += '>';
+    else if (std::strcmp (entity, "quot") == 0)  value += '"';
+    else if (std::strcmp (entity, "apos") == 0)  value += '\'';
+    else if (entity[0] == '#')
+    {
+        juce::uint32 code = 0;
+        const bool isHex = entity[1] == 'x' || entity[1] == 'X';
+
+        for (size_t i = isHex ? 2 : 1; i < length; ++i)
+        {
+            auto digit = isHex ? juce::CharacterFunctions::getHexDigitValue ((juce::juce_wchar) entity[i])
+                               : (entity[i] >= '0' && entity[i] <= '9' ? entity[i] - '0' : -1);
+            if (digit < 0)
+                return false;
+
+            code = code * (isHex ? 16u : 10u) + (juce::uint32) digit;
+        }
+
+        if (code == 0 || code > 0x10ffff)
+            return false;
+
+        appendUTF8 (value, code);
+    }
+    else
+    {
+        // Unknown named entities are kept verbatim
+        value += '&';
+        value.append (entity, length);
+        value += ';';
+    }
+
+    return true;
+}
+
+bool XmlPullParser::readAttributeValue (std::string& value)
+{
+    value.clear();
+
+    auto quote = readChar();
+    if (quote != '"' && quote != '\'')
+        return false;
+
+    for (;;)
+    {
+        auto c = readChar();
+        if (c < 0)
+            return false;
+
+        if (c == quote)
+            return true;
+
+        if (c == '&')
+        {
+            if (!readEntity (value))
+                return false;
+        }
+        else
+        {
+            value += (char) c;
+        }
+    }
+}
+
+XmlPullParser::Token XmlPullParser::fail (const juce::String& message)
+{
+    errorMessage = message;
+    return Token::Error;
+}
+
+XmlPullParser::Token XmlPullParser::next()
+{
+    if (pendingEndElement)
+    {
+        pendingEndElement = false;
+        elementName = openElements.back();
+        openElements.pop_back();
+        numAttributes = 0;
+        return Token::EndElement;
+    }
+
+    for (;;)
+    {
+        // Skip text content up to the next tag
+        int c;
+        while ((c = readChar()) >= 0 && c != '<') {}
+
+        if (c < 0)
+            return openElements.empty() ? Token::EndOfDocument
+                                        : fail ("Unexpected end of document inside <" + juce::String (openElements.back()) + ">");
+
+        c = peekChar();
+
+        if (c == '?')
+        {
+            if (!skipPast ("?>"))
+                return fail ("Unterminated processing instruction");
+            continue;
+        }
+
+        if (c == '!')
+        {
+            ++bufferPos;
+
+            if (peekChar() == '-')
+            {
+                if (!skipPast ("-->"))
+                    return fail ("Unterminated comment");
+            }
+            else if (peekChar() == '[')
+            {
+                if (!skipPast ("]]>"))
+                    return fail ("Unterminated CDATA section");
+            }
+            else
+            {
+                // DOCTYPE, possibly with an internal subset in brackets
+                int bracketDepth = 0;
+                for (;;)
+                {
+                    c = readChar();
+                    if (c < 0)
+                        return fail ("Unterminated DOCTYPE");
+                    if (c == '[') ++bracketDepth;
+                    else if (c == ']') --bracketDepth;
+                    else if (c == '>' && bracketDepth <= 0) break;
+                }
+            }
+            continue;
+        }
+
+        if (c == '/')
+        {
+            ++bufferPos;
+
+            if (!readName (elementName))
+                return fail ("Missing end tag name");
+
+            skipWhitespace();
+            if (readChar() != '>')
+                return fail ("Malformed end tag </" + juce::String (elementName) + ">");
+
+            if (openElements.empty() || openElements.back() != elementName)
+                return fail ("Unexpected end tag </" + juce::String (elementName) + ">");
+
+            openElements.pop_back();
+            numAttributes = 0;
+            return Token::EndElement;
+        }
+
+        // Start tag
+        if (!readName (elementName))
+            return fail ("Missing tag name");
+
+        numAttributes = 0;
+
+        for (;;)
+        {
+            skipWhitespace();
+            c = peekChar();
+
+            if (c == '>')
+            {
+                ++bufferPos;
+                openElements.push_back (elementName);
+                return Token::StartElement;
+            }
+
+            if (c == '/')
+            {
+                ++bufferPos;
+                if (readChar() != '>')
+                    return fail ("Malformed tag <" + juce::String (elementName) + ">");
+
+                openElements.push_back (elementName);
+                pendingEndElement = true;
+                return Token::StartElement;
+            }
+
+            // Reuse attribute strings from previous tags to avoid reallocating
+            if (numAttributes == attributes.size())
+                attributes.emplace_back();
+
+            auto& attribute = attributes[numAttributes];
+
+            if (!readName (attribute.first))
+                return fail ("Malformed attribute in <" + juce::String (elementName) + ">");
+
+            skipWhitespace();
+            if (readChar() != '=')
+                return fail ("Missing '=' after attribute " + juce::String (attribute.first));
+
+            skipWhitespace();
+            if (!readAttributeValue (attribute.second))
+                return fail ("Malformed value for attribute " + juce::String (attribute.first));
+
+            ++numAttributes;
+        }
+    }
+}
+
+bool XmlPullParser::skipElement()
+{
+    const auto targetDepth = openElements.size() - 1;
+
+    for (;;)
+    {
+        auto token = next();
+
+        if (token == Token::Error || token == Token::EndOfDocument)
+            return false;
+
+        if (token == Token::EndElement && openElements.size() == targetDepth)
+            return true;
+    }
+}
+
+//==============================================================================
+const std::string* XmlPullParser::findAttribute (const char* name) const
+{
+    for (size_t i = 0; i < numAttributes; ++i)
+        if (attributes[i].first == name)
+            return &attributes[i].second;
+
+    return nullptr;
+}
+
+juce::String XmlPullParser::getStringAttribute (const char* name, const juce::String& defaultValue) const
+{
+    if (auto* value = findAttribute (name))
+        return juce::String::fromUTF8 (value->data(), (int) value->size());
+
+    return defaultValue;
+}
+
+double XmlPullParser::getDoubleAttribute (const char* name, double defaultValue) const
+{
+    if (auto* value = findAttribute (name))
+        return juce::CharacterFunctions::getDoubleValue (juce::CharPointer_UTF8 (value->c_str()));
+
+    return defaultValue;
+}
+
+int XmlPullParser::getIntAttribute (const char* name, int defaultValue) const
+{
+    if (auto* value = findAttribute (name))
+        return juce::CharacterFunctions::getIntValue<int> (juce::CharPointer_UTF8 (value->c_str()));
+
+    return defaultValue;
+}
+
+bool XmlPullParser::getBoolAttribute (const char* name, bool defaultValue) const
+{
+    // Same rules as juce::XmlElement::getBoolAttribute
+    if (auto* value = findAttribute (name))
+    {
+        for (auto c : *value)
+        {
+            if (!isXmlWhitespace (c))
+                return c == '1' || c == 't' || c == 'y' || c == 'T' || c == 'Y';
+        }
+
+        return false;
+    }
+
+    return defaultValue;
+}
+
+juce::Colour XmlPullParser::getColourAttribute (const char* name, juce::Colour defaultValue) const
+{
+    if (auto* value = findAttribute (name))
+        return juce::Colour (parseHex32 (*value));
+
+    return defaultValue;
+}
+
+//==============================================================================
+// NarrateXmlReader
+//==============================================================================
+
+namespace
+{
+    using Token = XmlPullParser::Token;
+
+    TextFormatting readFormatting (const XmlPullParser& parser)
+    {
+        TextFormatting formatting;
+        formatting.colour = parser.getColourAttribute ("colour", juce::Colours::white);
+        formatting.bold = parser.getBoolAttribute ("bold", false);
+        formatting.italic = parser.getBoolAttribute ("italic", false);
+        formatting.fontSizeMultiplier = (float) parser.getDoubleAttribute ("fontSizeMultiplier", 1.0);
+        return formatting;
+    }
+
+    // Each reader is entered just after its element's StartElement and returns after
+    // the matching EndElement. Only the first child with a given name is used, to
+    // match XmlElement::getChildByName in the DOM loader.
+
+    bool readStyles (XmlPullParser& parser, FormattingPalette& palette)
+    {
+        for (;;)
+        {
+            auto token = parser.next();
+            if (token == Token::EndElement)
+                return true;
+            if (token != Token::StartElement)
+                return false;
+
+            if (parser.hasTagName ("Style"))
+                palette.append (readFormatting (parser));
+
+            if (!parser.skipElement())
+                return false;
+        }
+    }
+
+    bool readWord (XmlPullParser& parser, NarrateWord& word, const FormattingPalette& palette)
+    {
+        word.text = parser.getStringAttribute ("text");
+        word.relativeTime = parser.getDoubleAttribute ("relativeTime", 0.0);
+
+        auto styleIndex = parser.getIntAttribute ("style", -1);
+        if (palette.contains (styleIndex))
+            word.formatting = palette[styleIndex];
+
+        for (;;)
+        {
+            auto token = parser.next();
+            if (token == Token::EndElement)
+                return true;
+            if (token != Token::StartElement)
+                return false;
+
+            if (parser.hasTagName ("Formatting") && !word.formatting.has_value())
+                word.formatting = readFormatting (parser);
+
+            if (!parser.skipElement())
+                return false;
+        }
+    }
+
+    bool readWords (XmlPullParser& parser, NarrateClip& clip, const FormattingPalette& palette)
+    {
+        for (;;)
+        {
+            auto token = parser.next();
+            if (token == Token::EndElement)
+                return true;
+            if (token != Token::StartElement)
+                return false;
+
+            if (parser.hasTagName ("Word"))
+            {
+                NarrateWord word;
+                if (!readWord (parser, word, palette))
+                    return false;
+
+                clip.addWord (std::move (word));
+            }
+            else if (!parser.skipElement())
+            {
+                return false;
+            }
+        }
+    }
+
+    bool readClip (XmlPullParser& parser, NarrateClip& clip, const FormattingPalette& palette)
+    {
+        clip = NarrateClip (parser.getStringAttribute ("id"),
+                            parser.getDoubleAttribute ("startTime", 0.0),
+                            parser.getDoubleAttribute ("endTime", 0.0));
+
+        auto styleIndex = parser.getIntAttribute ("defaultStyle", -1);
+        bool haveFormatting = palette.contains (styleIndex), haveWords = false;
+
+        if (haveFormatting)
+            clip.setDefaultFormatting (palette[styleIndex]);
+
+        for (;;)
+        {
+            auto token = parser.next();
+            if (token == Token::EndElement)
+                return true;
+            if (token != Token::StartElement)
+                return false;
+
+            if (parser.hasTagName ("DefaultFormatting") && !haveFormatting)
+            {
+                clip.setDefaultFormatting (readFormatting (parser));
+                haveFormatting = true;
+            }
+            else if (parser.hasTagName ("Words") && !haveWords)
+            {
+                haveWords = true;
+                if (!readWords (parser, clip, palette))
+                    return false;
+                continue;
+            }
+
+            if (!parser.skipElement())
+                return false;
+        }
+    }
+
+    bool readClips (XmlPullParser& parser, NarrateProject& project, const FormattingPalette& palette)
+    {
+        NarrateProject::ClipBatch batch (project);
+
+        for (;;)
+        {
+            auto token = parser.next();
+            if (token == Token::EndElement)
+                return true;
+            if (token != Token::StartElement)
+                return false;
+
+            if (parser.hasTagName ("Clip"))
+            {
+                NarrateClip clip;
+                if (!readClip (parser, clip, palette))
+                    return false;
+
+                batch.add (std::move (clip));
+            }
+            else if (!parser.skipElement())
+            {
+                return false;
+            }
+        }
+    }
+
+    bool readProject (XmlPullParser& parser, NarrateProject& project)
+    {
+        project.setProjectName (parser.getStringAttribute ("projectName"));
+
+        bool haveSettings = false, haveAudio = false, haveStyles = false, haveClips = false;
+        FormattingPalette palette;
+
+        for (;;)
+        {
+            auto token = parser.next();
+            if (token == Token::EndElement)
+                return true;
+            if (token != Token::StartElement)
+                return false;
+
+            if (parser.hasTagName ("Settings") && !haveSettings)
+            {
+                haveSettings = true;
+                project.setDefaultFontSize ((float) parser.getDoubleAttribute ("defaultFontSize", 24.0f));
+                project.setDefaultTextColour (parser.getColourAttribute ("defaultTextColour", juce::Colours::white));
+                project.setHighlightColour (parser.getColourAttribute ("highlightColour", juce::Colours::yellow));
+                project.setRenderStrategy (static_cast<NarrateProject::RenderStrategy> (parser.getIntAttribute ("renderStrategy", 0)));
+            }
+            else if (parser.hasTagName ("BackgroundAudio") && !haveAudio)
+            {
+                haveAudio = true;
+                project.setBackgroundAudioFile (juce::File (parser.getStringAttribute ("path")));
+            }
+            else if (parser.hasTagName ("Styles") && !haveStyles)
+            {
+                // Style references are resolved as clips stream in, so only a palette
+                // that precedes the clips is used (toXml always writes it first)
+                haveStyles = true;
+                if (!readStyles (parser, palette))
+                    return false;
+                continue;
+            }
+            else if (parser.hasTagName ("Clips") && !haveClips)
+            {
+                haveClips = true;
+                if (!readClips (parser, project, palette))
+                    return false;
+                continue;
+            }
+
+            if (!parser.skipElement())
+                return false;
+        }
+    }
+}
+
+bool NarrateXmlReader::read (juce::InputStream& input, NarrateProject& outProject)
+{
+    XmlPullParser parser (input);
+    NarrateProject project;
+
+    if (parser.next() != Token::StartElement)
+        return false;
+
+    // Like NarrateProject::fromXml, a well-formed document with another root gives an empty project
+    bool ok = parser.hasTagName ("NarrateProject") ? readProject (parser, project)
+                                                   : parser.skipElement();
+
+    if (!ok || parser.next() != Token::EndOfDocument)
+        return false;
+
+    outProject = std::move (project);
+    return true;
+}
+
+bool NarrateXmlReader::readFromFile (const juce::File& file, NarrateProject& outProject)
+{
+    juce::FileInputStream stream (file);
+    if (!stream.openedOk())
+        return false;
+
+    return read (stream, outProject);
+}
+
+} // namespace Narrate
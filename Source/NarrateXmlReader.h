@@ -0,0 +1,92 @@
+#pragma once
+
+#include "NarrateDataModel.h"
+#include <string>
+#include <vector>
+
+namespace Narrate
+{
+
+//==============================================================================
+/**
+    Minimal pull parser for the XML written by NarrateProject::toXml().
+
+    Reads from an InputStream through a fixed-size buffer, so temporary memory is
+    bounded by the buffer plus the largest single tag, not by the document size.
+    Handles the XML declaration, comments, CDATA, DOCTYPE, self-closing tags and
+    the predefined and numeric character entities. Text content is skipped, since
+    the project schema stores everything in attributes.
+*/
+class XmlPullParser
+{
+public:
+    enum class Token
+    {
+        StartElement,
+        EndElement,     // Also reported straight after a self-closing tag
+        EndOfDocument,
+        Error
+    };
+
+    explicit XmlPullParser (juce::InputStream& source, size_t bufferSize = 64 * 1024);
+
+    // Advance to the next start or end tag
+    Token next();
+
+    // Name of the element from the last StartElement/EndElement token
+    const std::string& getElementName() const { return elementName; }
+    bool hasTagName (const char* name) const { return elementName == name; }
+
+    // Attributes of the last StartElement token (values are already entity-decoded UTF-8)
+    const std::string* findAttribute (const char* name) const;
+    juce::String getStringAttribute (const char* name, const juce::String& defaultValue = {}) const;
+    double getDoubleAttribute (const char* name, double defaultValue = 0.0) const;
+    int getIntAttribute (const char* name, int defaultValue = 0) const;
+    bool getBoolAttribute (const char* name, bool defaultValue = false) const;
+    juce::Colour getColourAttribute (const char* name, juce::Colour defaultValue) const;
+
+    // Skip the rest of the element whose StartElement was just returned
+    bool skipElement();
+
+    int getDepth() const { return (int) openElements.size(); }
+    const juce::String& getErrorMessage() const { return errorMessage; }
+
+private:
+    int peekChar();
+    int readChar();
+    bool refill();
+    bool skipPast (const char* terminator);
+    void skipWhitespace();
+    bool readName (std::string& name);
+    bool readAttributeValue (std::string& value);
+    bool readEntity (std::string& value);
+    Token fail (const juce::String& message);
+
+    juce::InputStream& input;
+    std::vector<char> buffer;
+    size_t bufferPos = 0, bufferEnd = 0;
+    bool endOfInput = false;
+
+    std::string elementName;
+    std::vector<std::pair<std::string, std::string>> attributes;
+    size_t numAttributes = 0;
+    std::vector<std::string> openElements;
+    bool pendingEndElement = false;
+    juce::String errorMessage;
+};
+
+//==============================================================================
+/**
+    Builds a NarrateProject directly from an XML byte stream in a single pass.
+
+    Accepts exactly what NarrateProject::fromXml accepts, without building a DOM.
+    Returns false (leaving outProject untouched) if the document is malformed.
+*/
+class NarrateXmlReader
+{
+public:
+    static bool read (juce::InputStream& input, NarrateProject& outProject);
+    static bool readFromFile (const juce::File& file, NarrateProject& outProject);
+};
+
+} // namespace Narrate
@@ -37,6 +37,10 @@ NarrateAudioProcessorEditor::NarrateAudioProcessorEditor (NarrateAudioProcessor&
     editorView.onPreviewClicked = [this] { switchToRunningView(); };
     runningView.onStopClicked = [this] { switchToEditorView(); };
 
+    // Splice clip edits into the running view's timeline as they are made
+    editorView.onClipEdited = [this] (int clipIndex) { runningView.clipEdited (editorView.getProject(), clipIndex); };
+    editorView.onProjectChanged = [this] { runningView.projectChanged(); };
+
     // Setup waveform position update callback for running view
     runningView.onPositionChanged = [this]
     {
@@ -20,8 +20,9 @@ public:
         int currentClipIndex;
         bool isRunning;
         juce::Rectangle<int> bounds;
-        int clipIndex;      // From getCurrentDisplayState()
-        int wordIndex;      // From getCurrentDisplayState()
+        int clipIndex;      // From TimelineEventManager::getDisplayStateAt()
+        int wordIndex;      // From TimelineEventManager::getDisplayStateAt()
+        bool highlightActive;  // The current word's highlight hasn't ended yet
     };
 
     virtual ~RenderStrategy() = default;
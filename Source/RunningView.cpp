@@ -48,7 +48,7 @@ void RunningView::paint (juce::Graphics& g)
         return;
     }
 
-    // Create render context with event-based indices
+    // Create render context from the timeline's display state at the current time
     RenderStrategy::RenderContext context {
         project,
         currentTime,
@@ -56,7 +56,8 @@ void RunningView::paint (juce::Graphics& g)
         isRunning,
         getLocalBounds(),
         currentClipIndex,  // clipIndex for rendering (same as currentClipIndex)
-        currentWordIndex   // wordIndex from events
+        displayState.wordIndex,
+        displayState.highlightActive
     };
 
     // Delegate to the strategy
@@ -89,33 +90,18 @@ void RunningView::start (const Narrate::NarrateProject& newProject)
 {
     project = newProject;
     currentTime = 0.0;
-    previousTime = 0.0;
     isRunning = true;
-    currentClipIndex = 0;
-    currentWordIndex = -1;
 
-    // Setup event callbacks on the event manager
-    eventManager.onClipStart = [this] (int clipIndex)
+    // Build the timeline of events with current highlight settings, unless clip edits
+    // since the last build have already been spliced into it. The layout id check catches
+    // a change to the clips that wasn't reported through projectChanged().
+    if (! timelineUpToDate || project.getClipLayoutId() != eventManager.getClipLayoutId())
     {
-        currentClipIndex = clipIndex;
-        repaint();
-    };
-
-    eventManager.onWordStart = [this] (int clipIndex, int wordIndex)
-    {
-        currentWordIndex = wordIndex;
-        repaint();
-    };
-
-    eventManager.onHighlightEnd = [this] (int clipIndex, int wordIndex)
-    {
-        // Highlight ended - just trigger repaint to update visual state
-        // Don't clear currentWordIndex - it should remain until next word starts
-        repaint();
-    };
+        eventManager.buildTimeline (project, highlightSettings);
+        timelineUpToDate = true;
+    }
 
-    // Build the timeline of events with current highlight settings
-    eventManager.buildTimeline (project, highlightSettings);
+    updateDisplayState();
 
 #if NARRATE_ENABLE_AUDIO_PLAYBACK
     // Standalone-only: Start audio playback if loaded
@@ -147,6 +133,34 @@ void RunningView::stop()
     repaint();
 }
 
+void RunningView::clipEdited (const Narrate::NarrateProject& editedProject, int clipIndex)
+{
+    if (! timelineUpToDate)
+        return;
+
+    if (editedProject.getClipLayoutId() == project.getClipLayoutId())
+    {
+        // Same clips in the same order, so only the edited one needs copying
+        project.getClip (clipIndex) = editedProject.getClip (clipIndex);
+    }
+    else
+    {
+        // The edit moved the clip past others, so their indices changed too and
+        // rebuildClip() falls back to a full build anyway
+        project = editedProject;
+    }
+
+    eventManager.rebuildClip (project, clipIndex);
+
+    if (isRunning)
+        updateDisplayState();
+}
+
+void RunningView::projectChanged()
+{
+    timelineUpToDate = false;
+}
+
 void RunningView::setRenderStrategy (std::unique_ptr<RenderStrategy> strategy)
 {
     renderStrategy = std::move (strategy);
@@ -157,10 +171,15 @@ void RunningView::setHighlightSettings (const HighlightSettings& newSettings)
 {
     highlightSettings = newSettings;
 
-    // Rebuild timeline if project is loaded
+    // Rebuild timeline if project is loaded, otherwise on the next start()
     if (project.getNumClips() > 0 && isRunning)
     {
         eventManager.buildTimeline (project, highlightSettings);
+        updateDisplayState();
+    }
+    else
+    {
+        timelineUpToDate = false;
     }
 }
 
@@ -169,9 +188,6 @@ void RunningView::timerCallback()
     if (!isRunning)
         return;
 
-    // Store previous time for event detection
-    previousTime = currentTime;
-
 #if NARRATE_ENABLE_AUDIO_PLAYBACK
     // Standalone-only: Sync time from audio position if audio is playing
     if (audioProcessor && audioProcessor->isAudioPlaying())
@@ -188,9 +204,7 @@ void RunningView::timerCallback()
     currentTime += timerIntervalMs / 1000.0;  // Convert ms to seconds
 #endif
 
-    // Process events with look-ahead from settings to compensate for render latency
-    double lookAheadTime = currentTime + (highlightSettings.lookAheadMs / 1000.0);
-    eventManager.processEvents (previousTime, lookAheadTime);
+    updateDisplayState();
 
     // Check if we've finished
     if (currentTime >= project.getTotalDuration())
@@ -204,42 +218,49 @@ void RunningView::timerCallback()
     repaint();
 }
 
-void RunningView::previousClipClicked()
+void RunningView::seekTo (double newTime)
 {
-    if (!isRunning || currentClipIndex <= 0)
-        return;
+    currentTime = newTime;
 
-    // Jump to the previous clip
-    currentClipIndex--;
+    // The display state is a function of time alone, so it's right straight away
+    updateDisplayState();
 
-    // Set time to the start of the previous clip
-    if (currentClipIndex >= 0 && currentClipIndex < project.getNumClips())
+#if NARRATE_ENABLE_AUDIO_PLAYBACK
+    // Update audio position if audio is loaded
+    if (audioProcessor && audioProcessor->hasAudioLoaded())
     {
-        auto& clip = project.getClip(currentClipIndex);
-        currentTime = clip.getStartTime();
-        currentWordIndex = -1;  // Reset word index
+        audioProcessor->setAudioPosition (currentTime);
+    }
+#endif
 
-        // Seek event manager to new time position
-        eventManager.seekToTime(currentTime);
+    // Trigger waveform position update callback
+    if (onPositionChanged)
+        onPositionChanged();
 
-        // Update previousTime to enable proper event processing
-        // Set it slightly before currentTime so processEvents will fire
-        previousTime = juce::jmax(0.0, currentTime - 0.001);
+    repaint();
+}
 
-#if NARRATE_ENABLE_AUDIO_PLAYBACK
-        // Update audio position if audio is loaded
-        if (audioProcessor && audioProcessor->hasAudioLoaded())
-        {
-            audioProcessor->setAudioPosition(currentTime);
-        }
-#endif
+void RunningView::jumpToClip (int clipIndex)
+{
+    // A quantized clip start can fall after the clip's own start time; land on whichever is later
+    const double clipStart = std::as_const (project).getClip (clipIndex).getStartTime();
+    seekTo (highlightSettings.quantizeEnabled ? juce::jmax (clipStart, highlightSettings.quantizeTime (clipStart))
+                                              : clipStart);
+}
 
-        // Trigger waveform position update callback
-        if (onPositionChanged)
-            onPositionChanged();
+void RunningView::updateDisplayState()
+{
+    // Look ahead from settings to compensate for render latency
+    displayState = eventManager.getDisplayStateAt (currentTime + (highlightSettings.lookAheadMs / 1000.0));
+    currentClipIndex = juce::jmax (0, displayState.clipIndex);
+}
 
-        repaint();
-    }
+void RunningView::previousClipClicked()
+{
+    if (!isRunning || currentClipIndex <= 0)
+        return;
+
+    jumpToClip (juce::jmin (currentClipIndex, project.getNumClips()) - 1);
 }
 
 void RunningView::nextClipClicked()
@@ -247,37 +268,7 @@ void RunningView::nextClipClicked()
     if (!isRunning || currentClipIndex >= project.getNumClips() - 1)
         return;
 
-    // Jump to the next clip
-    currentClipIndex++;
-
-    // Set time to the start of the next clip
-    if (currentClipIndex >= 0 && currentClipIndex < project.getNumClips())
-    {
-        auto& clip = project.getClip(currentClipIndex);
-        currentTime = clip.getStartTime();
-        currentWordIndex = -1;  // Reset word index
-
-        // Seek event manager to new time position
-        eventManager.seekToTime(currentTime);
-
-        // Update previousTime to enable proper event processing
-        // Set it slightly before currentTime so processEvents will fire
-        previousTime = juce::jmax(0.0, currentTime - 0.001);
-
-#if NARRATE_ENABLE_AUDIO_PLAYBACK
-        // Update audio position if audio is loaded
-        if (audioProcessor && audioProcessor->hasAudioLoaded())
-        {
-            audioProcessor->setAudioPosition(currentTime);
-        }
-#endif
-
-        // Trigger waveform position update callback
-        if (onPositionChanged)
-            onPositionChanged();
-
-        repaint();
-    }
+    jumpToClip (currentClipIndex + 1);
 }
 
 void RunningView::jumpBackClicked()
@@ -287,40 +278,7 @@ void RunningView::jumpBackClicked()
 
     // Jump back 5 seconds
     constexpr double jumpAmount = 5.0;
-    currentTime = juce::jmax(0.0, currentTime - jumpAmount);
-
-    // Seek event manager to new time position
-    eventManager.seekToTime(currentTime);
-
-    // Update previousTime to enable proper event processing
-    // Set it slightly before currentTime so processEvents will fire
-    previousTime = juce::jmax(0.0, currentTime - 0.001);
-
-#if NARRATE_ENABLE_AUDIO_PLAYBACK
-    // Update audio position if audio is loaded
-    if (audioProcessor && audioProcessor->hasAudioLoaded())
-    {
-        audioProcessor->setAudioPosition(currentTime);
-    }
-#endif
-
-    // Update clip index based on new time
-    for (int i = 0; i < project.getNumClips(); ++i)
-    {
-        auto& clip = project.getClip(i);
-        if (currentTime >= clip.getStartTime() && currentTime < clip.getEndTime())
-        {
-            currentClipIndex = i;
-            currentWordIndex = -1;  // Reset word index
-            break;
-        }
-    }
-
-    // Trigger waveform position update callback
-    if (onPositionChanged)
-        onPositionChanged();
-
-    repaint();
+    seekTo (juce::jmax (0.0, currentTime - jumpAmount));
 }
 
 void RunningView::jumpForwardClicked()
@@ -330,39 +288,5 @@ void RunningView::jumpForwardClicked()
 
     // Jump forward 5 seconds
     constexpr double jumpAmount = 5.0;
-    double totalDuration = project.getTotalDuration();
-    currentTime = juce::jmin(totalDuration, currentTime + jumpAmount);
-
-    // Seek event manager to new time position
-    eventManager.seekToTime(currentTime);
-
-    // Update previousTime to enable proper event processing
-    // Set it slightly before currentTime so processEvents will fire
-    previousTime = juce::jmax(0.0, currentTime - 0.001);
-
-#if NARRATE_ENABLE_AUDIO_PLAYBACK
-    // Update audio position if audio is loaded
-    if (audioProcessor && audioProcessor->hasAudioLoaded())
-    {
-        audioProcessor->setAudioPosition(currentTime);
-    }
-#endif
-
-    // Update clip index based on new time
-    for (int i = 0; i < project.getNumClips(); ++i)
-    {
-        auto& clip = project.getClip(i);
-        if (currentTime >= clip.getStartTime() && currentTime < clip.getEndTime())
-        {
-            currentClipIndex = i;
-            currentWordIndex = -1;  // Reset word index
-            break;
-        }
-    }
-
-    // Trigger waveform position update callback
-    if (onPositionChanged)
-        onPositionChanged();
-
-    repaint();
+    seekTo (juce::jmin (project.getTotalDuration(), currentTime + jumpAmount));
 }
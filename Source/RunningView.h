@@ -26,6 +26,11 @@ public:
     // Stop the playback
     void stop();
 
+    // Keep the timeline in step with the editor: an edited clip is spliced into the
+    // compiled timeline, while any other change recompiles it on the next start()
+    void clipEdited (const Narrate::NarrateProject& editedProject, int clipIndex);
+    void projectChanged();
+
     // Set the rendering strategy
     void setRenderStrategy (std::unique_ptr<RenderStrategy> strategy);
 
@@ -42,6 +47,13 @@ public:
 
 private:
     void timerCallback() override;
+
+    // Move the playhead; the display state follows from the new time
+    void seekTo (double newTime);
+    // Query the timeline for the clip, word and highlight at currentTime (plus look-ahead)
+    void updateDisplayState();
+    void jumpToClip (int clipIndex);
+
     void previousClipClicked();
     void nextClipClicked();
     void jumpBackClicked();
@@ -56,16 +68,16 @@ private:
     Narrate::NarrateProject project;
 
     double currentTime = 0.0;  // Current playback time in seconds
-    double previousTime = 0.0;  // Previous time (for event detection)
     bool isRunning = false;
     int currentClipIndex = 0;  // Index of the currently active clip
-    int currentWordIndex = -1;  // Index of the currently active word (event-based)
+    TimelineEventManager::DisplayState displayState;  // Clip, word and highlight shown at currentTime
 
     // Timer runs at 60fps for smooth updates
     static constexpr int timerIntervalMs = 16;  // ~60fps
 
     // Time event system
     TimelineEventManager eventManager;
+    bool timelineUpToDate = false;  // eventManager was compiled from project as it is now
 
     // Rendering strategy
     std::unique_ptr<RenderStrategy> renderStrategy;
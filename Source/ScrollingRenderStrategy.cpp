@@ -86,8 +86,8 @@ std::vector<ScrollingRenderStrategy::LineInfo> ScrollingRenderStrategy::calculat
 
     for (int wordIndex = 0; wordIndex < words.size(); ++wordIndex)
     {
-        const auto& word = words[wordIndex];
-        auto formatting = word.getEffectiveFormatting (clip.getDefaultFormatting());
+        const auto& word = words.getReference (wordIndex);
+        const auto& formatting = word.getEffectiveFormatting (clip.getDefaultFormatting());
 
         // Calculate word width
         auto fontHeight = baseFontSize * formatting.fontSizeMultiplier;
@@ -134,10 +134,13 @@ void ScrollingRenderStrategy::renderLine (juce::Graphics& g, const RenderContext
     const auto& words = clip.getWords();
     float x = calculateLineStartX (area, line.totalWidth);
 
+    // Playback state is the same for every word on this line
+    const bool playbackActive = context.isRunning && context.currentTime < context.project.getTotalDuration();
+
     for (int wordIndex = line.startWordIndex; wordIndex <= line.endWordIndex; ++wordIndex)
     {
-        const auto& word = words[wordIndex];
-        auto formatting = word.getEffectiveFormatting (clip.getDefaultFormatting());
+        const auto& word = words.getReference (wordIndex);
+        const auto& formatting = word.getEffectiveFormatting (clip.getDefaultFormatting());
 
         // Set font with formatting
         auto fontHeight = baseFontSize * formatting.fontSizeMultiplier;
@@ -154,8 +157,7 @@ void ScrollingRenderStrategy::renderLine (juce::Graphics& g, const RenderContext
         // Determine if this word should be highlighted
         bool isCurrentClip = (clipIndex == context.clipIndex);
         bool isCurrentWord = isCurrentClip && (wordIndex == context.wordIndex);
-        bool shouldHighlight = isCurrentWord && context.isRunning &&
-                               context.currentTime < context.project.getTotalDuration();
+        bool shouldHighlight = isCurrentWord && playbackActive && context.highlightActive;
 
         if (shouldHighlight)
         {
@@ -119,8 +119,8 @@ std::vector<TeleprompterRenderStrategy::LineInfo> TeleprompterRenderStrategy::ca
 
     for (int wordIndex = 0; wordIndex < words.size(); ++wordIndex)
     {
-        const auto& word = words[wordIndex];
-        auto formatting = word.getEffectiveFormatting (clip.getDefaultFormatting());
+        const auto& word = words.getReference (wordIndex);
+        const auto& formatting = word.getEffectiveFormatting (clip.getDefaultFormatting());
 
         // Calculate word width
         auto fontHeight = baseFontSize * formatting.fontSizeMultiplier;
@@ -211,10 +211,12 @@ void TeleprompterRenderStrategy::renderLine (juce::Graphics& g, const RenderCont
     float areaWidth = static_cast<float>(context.bounds.getWidth());
     float x = (areaWidth / 2.0f) - (line.totalWidth / 2.0f);
 
+    const bool playbackActive = context.isRunning && context.currentTime < context.project.getTotalDuration();
+
     for (int wordIndex = line.startWordIndex; wordIndex <= line.endWordIndex; ++wordIndex)
     {
-        const auto& word = words[wordIndex];
-        auto formatting = word.getEffectiveFormatting (clip.getDefaultFormatting());
+        const auto& word = words.getReference (wordIndex);
+        const auto& formatting = word.getEffectiveFormatting (clip.getDefaultFormatting());
 
         // Set font with formatting
         auto fontHeight = baseFontSize * formatting.fontSizeMultiplier;
@@ -231,8 +233,7 @@ void TeleprompterRenderStrategy::renderLine (juce::Graphics& g, const RenderCont
         // Determine if this word should be highlighted
         bool isCurrentClip = (line.clipIndex == context.clipIndex);
         bool isCurrentWord = isCurrentClip && (wordIndex == context.wordIndex);
-        bool shouldHighlight = isCurrentWord && context.isRunning &&
-                               context.currentTime < context.project.getTotalDuration();
+        bool shouldHighlight = isCurrentWord && playbackActive && context.highlightActive;
 
         if (shouldHighlight)
         {
@@ -1,6 +1,145 @@
 #include "TimelineEventManager.h"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <limits>
+#include <memory>
+
+namespace
+{
+    // Words compiled per block: the scratch columns of a block stay in cache
+    constexpr size_t wordsPerBlock = 2048;
+
+    // Rounding without libm calls or branches, so the loops below can vectorize. Adding and
+    // subtracting 2^52 rounds to the nearest integer (ties to even) for magnitudes under 2^52;
+    // anything larger is already whole. Relies on strict IEEE arithmetic (no fast-math).
+    constexpr double twoTo52 = 4503599627370496.0;
+
+    // Same result as std::round: halves round away from zero
+    inline double roundHalfAway (double x)
+    {
+        const double magnitude = std::abs (x);
+        double rounded = (magnitude + twoTo52) - twoTo52;
+        rounded = magnitude - rounded == 0.5 ? rounded + 1.0 : rounded;
+        rounded = magnitude < twoTo52 ? rounded : magnitude;
+        return std::copysign (rounded, x);
+    }
+
+    // Same result as std::ceil
+    inline double roundUp (double x)
+    {
+        const double nearest = roundHalfAway (x);
+        return std::copysign (nearest < x ? nearest + 1.0 : nearest, x);
+    }
+
+    // HighlightSettings::quantizeTime() over a column
+    void quantizeTimes (double* times, size_t count, double snapInterval)
+    {
+        for (size_t i = 0; i < count; ++i)
+            times[i] = roundHalfAway (times[i] / snapInterval) * snapInterval;
+    }
+
+    // Highlight durations for every word of a block, one branch-free loop per duration mode
+    void computeHighlightDurations (const HighlightSettings& settings, const double* starts, const double* durations,
+                                    double* highlights, size_t count)
+    {
+        using DurationMode = HighlightSettings::DurationMode;
+        const double snapInterval = settings.getSnapInterval();
+
+        switch (settings.durationMode)
+        {
+            case DurationMode::Minimum:
+            {
+                // Use at least the minimum duration
+                const double minimum = settings.minimumDuration;
+                for (size_t i = 0; i < count; ++i)
+                    highlights[i] = durations[i] < minimum ? minimum : durations[i];
+                return;
+            }
+
+            case DurationMode::Fixed:
+                // Use fixed duration for all words
+                std::fill (highlights, highlights + count, settings.fixedDuration);
+                return;
+
+            case DurationMode::GridBased:
+                // Highlight until the next grid position after the word starts
+                if (snapInterval > 0.0)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        double nextGridTime = roundUp (starts[i] / snapInterval) * snapInterval;
+                        nextGridTime = nextGridTime <= starts[i] ? nextGridTime + snapInterval : nextGridTime;
+                        highlights[i] = nextGridTime - starts[i];
+                    }
+                    return;
+                }
+                // Fall back to original if no valid grid
+                break;
+
+            case DurationMode::Original:
+            default:
+                break;
+        }
+
+        // Use original word duration
+        std::copy (durations, durations + count, highlights);
+    }
+
+    using ClipRange = std::pair<int, int>;
+
+    // Run job over every range of clips, on the pool if there is one, and wait for all of them
+    template <typename Job>
+    void forEachRange (juce::ThreadPool* pool, const std::vector<ClipRange>& ranges, const Job& job)
+    {
+        if (pool == nullptr || ranges.size() < 2)
+        {
+            for (const auto& [beginClip, endClip] : ranges)
+                job (beginClip, endClip);
+            return;
+        }
+
+        std::atomic<int> rangesRemaining { (int) ranges.size() };
+        juce::WaitableEvent allRangesDone;
+
+        for (const auto& [beginClip, endClip] : ranges)
+        {
+            pool->addJob ([&job, beginClip = beginClip, endClip = endClip, &rangesRemaining, &allRangesDone]
+            {
+                job (beginClip, endClip);
+
+                if (--rangesRemaining == 0)
+                    allRangesDone.signal();
+            });
+        }
+
+        allRangesDone.wait();
+    }
+
+    // Stable sort for one clip's events, which are nearly sorted as generated
+    template <typename Event>
+    void sortRun (Event* begin, Event* end)
+    {
+        const auto byTick = [] (const Event& a, const Event& b) { return a.tick < b.tick; };
+
+        if (end - begin > 64)
+        {
+            std::stable_sort (begin, end, byTick);
+            return;
+        }
+
+        for (auto* i = begin + 1; i < end; ++i)
+        {
+            const auto event = *i;
+            auto* j = i;
+
+            for (; j > begin && byTick (event, *(j - 1)); --j)
+                *j = *(j - 1);
+
+            *j = event;
+        }
+    }
+}
 
 TimelineEventManager::TimelineEventManager()
 {
@@ -13,173 +152,497 @@ TimelineEventManager::~TimelineEventManager()
 void TimelineEventManager::buildTimeline (const Narrate::NarrateProject& project,
                                           const HighlightSettings& settings)
 {
-    timeline.clear();
+    timelineSettings = settings;
+    clipLayoutId = project.getClipLayoutId();
 
-    // Get quantization interval if enabled
-    double snapInterval = settings.getSnapInterval();
+    const int numClips = project.getNumClips();
 
-    // Build a sorted list of all time events in the project
-    for (int clipIndex = 0; clipIndex < project.getNumClips(); ++clipIndex)
+    clipNumWords.resize ((size_t) numClips);
+    clipFirstWords.resize ((size_t) numClips + 1);
+    clipFirstWords[0] = 0;
+
+    for (int c = 0; c < numClips; ++c)
     {
-        const auto& clip = project.getClip (clipIndex);
+        clipNumWords[(size_t) c] = project.getClip (c).getNumWords();
+        clipFirstWords[(size_t) c + 1] = clipFirstWords[(size_t) c] + clipNumWords[(size_t) c];
+    }
 
-        // Quantize clip start time if enabled
-        double clipStartTime = clip.getStartTime();
-        if (settings.quantizeEnabled)
-            clipStartTime = settings.quantizeTime (clipStartTime);
+    const int numWords = clipFirstWords.back();
+    wordClips.resize ((size_t) numWords);
+    wordHighlightEnds.resize ((size_t) numWords);
 
-        // Add clip start event
-        timeline.push_back ({clipStartTime, EventType::ClipStart, clipIndex, -1});
+    // Every clip's run has a known size, so the runs share one buffer and ranges of clips
+    // can be compiled independently into their own slices. It's left uninitialised, so its
+    // pages are first touched by the threads compiling into them.
+    const size_t numEvents = getRunOffset (numClips);
+    juce::HeapBlock<RunEvent> runEvents (numEvents);
 
-        // Track the current time for quantization
-        double currentTime = clipStartTime;
+    const int numThreads = maxBuildThreads > 0 ? maxBuildThreads : juce::SystemStats::getNumCpus();
+    juce::ThreadPool* pool = nullptr;
+    std::vector<ClipRange> ranges;
 
-        // Add word events
-        for (int wordIndex = 0; wordIndex < clip.getNumWords(); ++wordIndex)
+    if (numThreads > 1 && numWords >= parallelBuildMinWords)
+    {
+        pool = &getBuildPool (numThreads);
+
+        // A few ranges per thread, of about the same number of events, evens out slow ones
+        const int numRanges = juce::jmin (numClips, numThreads * 4);
+        int beginClip = 0;
+
+        for (int range = 1; range <= numRanges && beginClip < numClips; ++range)
         {
-            const auto& word = clip.getWords()[wordIndex];
-            double wordAbsoluteTime = clip.getStartTime() + word.relativeTime;
+            const size_t target = numEvents * (size_t) range / (size_t) numRanges;
+            int endClip = beginClip + 1;
 
-            // Quantize word start time if enabled
-            if (settings.quantizeEnabled)
-            {
-                wordAbsoluteTime = settings.quantizeTime (wordAbsoluteTime);
-                // Ensure word doesn't start before current time
-                if (wordAbsoluteTime < currentTime)
-                    wordAbsoluteTime = currentTime;
-            }
+            while (endClip < numClips && getRunOffset (endClip) < target)
+                ++endClip;
 
-            // Add word start event
-            timeline.push_back ({wordAbsoluteTime, EventType::WordStart, clipIndex, wordIndex});
+            ranges.push_back ({ beginClip, endClip });
+            beginClip = endClip;
+        }
+    }
+    else if (numClips > 0)
+    {
+        ranges.push_back ({ 0, numClips });
+    }
 
-            // Calculate original word duration
-            double wordDuration;
-            if (wordIndex < clip.getNumWords() - 1)
-            {
-                const auto& nextWord = clip.getWords()[wordIndex + 1];
-                wordDuration = (clip.getStartTime() + nextWord.relativeTime) - wordAbsoluteTime;
-            }
-            else
-            {
-                wordDuration = clip.getEndTime() - wordAbsoluteTime;
-            }
+    forEachRange (pool, ranges, [this, &project, &runEvents] (int beginClip, int endClip)
+    {
+        compileClips (project, beginClip, endClip, runEvents + getRunOffset (beginClip),
+                      wordHighlightEnds.data() + clipFirstWords[(size_t) beginClip]);
 
-            // Calculate highlight duration based on settings
-            double highlightDuration = calculateHighlightDuration (wordDuration, wordAbsoluteTime, settings);
+        for (int clipIndex = beginClip; clipIndex < endClip; ++clipIndex)
+            std::fill (wordClips.begin() + clipFirstWords[(size_t) clipIndex],
+                       wordClips.begin() + clipFirstWords[(size_t) clipIndex + 1], clipIndex);
+    });
 
-            // Add highlight end event (when highlight should disappear)
-            timeline.push_back ({wordAbsoluteTime + highlightDuration, EventType::HighlightEnd, clipIndex, wordIndex});
+    // The earliest event of each clip's run and of every run after it, which bounds what the
+    // merge can still be waiting for
+    std::vector<Tick> laterRunsFirstTick ((size_t) numClips + 1, std::numeric_limits<Tick>::max());
+    clipFirstTicks.resize ((size_t) numClips);
+    clipLastTicks.resize ((size_t) numClips);
 
-            // Calculate word end time (for data tracking)
-            double wordEndTime = wordAbsoluteTime + wordDuration;
+    for (int c = numClips - 1; c >= 0; --c)
+    {
+        clipFirstTicks[(size_t) c] = runEvents[getRunOffset (c)].tick;
+        clipLastTicks[(size_t) c] = runEvents[getRunOffset (c + 1) - 1].tick;
+        laterRunsFirstTick[(size_t) c] = std::min (laterRunsFirstTick[(size_t) c + 1], clipFirstTicks[(size_t) c]);
+    }
 
-            // Add word end event
-            timeline.push_back ({wordEndTime, EventType::WordEnd, clipIndex, wordIndex});
+    // Runs can be merged in independent segments split where every earlier run has ended
+    // by the time every later one starts. Keep the ranges' boundaries that allow it.
+    std::vector<ClipRange> segments;
+    Tick earlierRunsLastTick = std::numeric_limits<Tick>::min();
+    int segmentBegin = 0;
 
-            // Update current time for next word
-            currentTime = wordEndTime;
-        }
+    for (const auto& [beginClip, endClip] : ranges)
+    {
+        for (int c = beginClip; c < endClip; ++c)
+            earlierRunsLastTick = std::max (earlierRunsLastTick, clipLastTicks[(size_t) c]);
 
-        // Add clip end event
-        timeline.push_back ({clip.getEndTime(), EventType::ClipEnd, clipIndex, -1});
+        if (endClip == numClips || earlierRunsLastTick <= laterRunsFirstTick[(size_t) endClip])
+        {
+            segments.push_back ({ segmentBegin, endClip });
+            segmentBegin = endClip;
+        }
     }
 
-    // Sort timeline by time
-    std::sort (timeline.begin(), timeline.end());
+    eventTicks.resize (numEvents);
+    eventIds.resize (numEvents);
+    eventTypes.resize (numEvents);
+    activeAfter.resize (numEvents);
+
+    forEachRange (pool, segments, [this, &runEvents, &laterRunsFirstTick] (int beginClip, int endClip)
+    {
+        mergeClipRuns (runEvents, laterRunsFirstTick, beginClip, endClip);
+        updateActiveStates (getRunOffset (beginClip), getRunOffset (endClip));
+    });
+
+    // A segment's events before its first clip starts still show the previous segment's clip
+    for (size_t s = 1; s < segments.size(); ++s)
+    {
+        const size_t begin = getRunOffset (segments[s].first);
+        const size_t end = getRunOffset (segments[s].second);
+
+        for (size_t i = begin; i < end && eventTypes[i] != EventType::ClipStart; ++i)
+            activeAfter[i] = activeAfter[begin - 1];
+    }
 
     // Reset the event index
     nextEventIndex = 0;
 }
 
-double TimelineEventManager::calculateHighlightDuration (double wordDuration,
-                                                         double wordStartTime,
-                                                         const HighlightSettings& settings) const
+juce::ThreadPool& TimelineEventManager::getBuildPool (int numThreads)
 {
-    using DurationMode = HighlightSettings::DurationMode;
+    // Starting the threads costs more than compiling a small timeline, and builds happen on
+    // every settings change, so they are started once and then wait for the next build
+    if (buildPool == nullptr || buildPool->getNumThreads() != numThreads)
+        buildPool = std::make_unique<juce::ThreadPool> (numThreads);
 
-    switch (settings.durationMode)
+    return *buildPool;
+}
+
+void TimelineEventManager::rebuildClip (const Narrate::NarrateProject& project, int clipIndex)
+{
+    // Tick of the next event to fire, so the cursor can be put back there afterwards
+    const Tick cursorTick = nextEventIndex < eventTicks.size() ? eventTicks[nextEventIndex]
+                                                               : std::numeric_limits<Tick>::max();
+
+    if (project.getClipLayoutId() != clipLayoutId)
+    {
+        // Clips were added, removed or reordered, so the other clips' indices are stale
+        buildTimeline (project, timelineSettings);
+        nextEventIndex = findEventIndex (cursorTick);
+        return;
+    }
+
+    jassert (clipIndex >= 0 && clipIndex < project.getNumClips());
+    const auto c = (size_t) clipIndex;
+
+    // Keep the clip's word ids if its words still fit in them, otherwise give it new ones after
+    // every other word, so no other word's id changes. The next full build numbers them afresh.
+    const int numWords = project.getClip (clipIndex).getNumWords();
+
+    if (numWords > clipNumWords[c])
     {
-        case DurationMode::Original:
-            // Use original word duration
-            return wordDuration;
+        clipFirstWords[c] = (int) wordClips.size();
+        wordClips.resize (wordClips.size() + (size_t) numWords, clipIndex);
+        wordHighlightEnds.resize (wordClips.size());
+        clipFirstWords.back() = (int) wordClips.size();
+    }
+
+    clipNumWords[c] = numWords;
+    const auto firstWord = (uint32_t) clipFirstWords[c];
+
+    std::vector<RunEvent> run ((size_t) (2 + 3 * numWords));
+    compileClips (project, clipIndex, clipIndex + 1, run.data(), wordHighlightEnds.data() + firstWord);
+
+    // The clip's old and new events all fall between these ticks, and so do any events of other
+    // clips they can swap places with. Nothing outside them moves.
+    const Tick windowFirstTick = std::min (clipFirstTicks[c], run.front().tick);
+    const Tick windowLastTick = std::max (clipLastTicks[c], run.back().tick);
+    clipFirstTicks[c] = run.front().tick;
+    clipLastTicks[c] = run.back().tick;
+
+    const auto windowBegin = (size_t) (std::lower_bound (eventTicks.begin(), eventTicks.end(), windowFirstTick) - eventTicks.begin());
+    const auto windowEnd = (size_t) (std::upper_bound (eventTicks.begin(), eventTicks.end(), windowLastTick) - eventTicks.begin());
 
-        case DurationMode::Minimum:
-            // Use at least the minimum duration
-            return std::max (wordDuration, settings.minimumDuration);
+    // Drop the clip's old events from the window and merge its new run in, placing it among
+    // same-time events by clip index as a full build would
+    std::vector<Tick> ticks;
+    std::vector<uint32_t> ids;
+    std::vector<EventType> types;
 
-        case DurationMode::Fixed:
-            // Use fixed duration for all words
-            return settings.fixedDuration;
+    const size_t capacity = windowEnd - windowBegin + run.size();
+    ticks.reserve (capacity);
+    ids.reserve (capacity);
+    types.reserve (capacity);
+
+    size_t next = 0;
+
+    const auto appendFromRun = [&] (const RunEvent& event)
+    {
+        ticks.push_back (event.tick);
+        ids.push_back (isClipEvent (event.type) ? (uint32_t) clipIndex : firstWord + event.id);
+        types.push_back (event.type);
+    };
+
+    for (size_t i = windowBegin; i < windowEnd; ++i)
+    {
+        const int eventClip = getEventClip (i);
+
+        if (eventClip == clipIndex)
+            continue;
+
+        while (next < run.size()
+               && (run[next].tick < eventTicks[i] || (run[next].tick == eventTicks[i] && clipIndex < eventClip)))
+            appendFromRun (run[next++]);
+
+        ticks.push_back (eventTicks[i]);
+        ids.push_back (eventIds[i]);
+        types.push_back (eventTypes[i]);
+    }
+
+    while (next < run.size())
+        appendFromRun (run[next++]);
+
+    // Copy the window back, first moving the later events along if its size changed
+    const auto resizeWindow = [windowEnd, newEnd = windowBegin + ticks.size()] (auto& column)
+    {
+        if (newEnd > windowEnd)
+            column.insert (column.begin() + (std::ptrdiff_t) windowEnd, newEnd - windowEnd, {});
+        else
+            column.erase (column.begin() + (std::ptrdiff_t) newEnd, column.begin() + (std::ptrdiff_t) windowEnd);
+    };
 
-        case DurationMode::GridBased:
+    if (ticks.size() != windowEnd - windowBegin)
+    {
+        resizeWindow (eventTicks);
+        resizeWindow (eventIds);
+        resizeWindow (eventTypes);
+        resizeWindow (activeAfter);
+    }
+
+    std::copy (ticks.begin(), ticks.end(), eventTicks.begin() + (std::ptrdiff_t) windowBegin);
+    std::copy (ids.begin(), ids.end(), eventIds.begin() + (std::ptrdiff_t) windowBegin);
+    std::copy (types.begin(), types.end(), eventTypes.begin() + (std::ptrdiff_t) windowBegin);
+
+    // The active states change from the window up to the next clip start after it, which
+    // doesn't depend on anything before it
+    size_t activeEnd = windowBegin + ticks.size();
+
+    while (activeEnd < eventTypes.size() && eventTypes[activeEnd] != EventType::ClipStart)
+        ++activeEnd;
+
+    updateActiveStates (windowBegin, activeEnd, windowBegin > 0 ? activeAfter[windowBegin - 1] : ActiveState { -1, -1 });
+    nextEventIndex = findEventIndex (cursorTick);
+}
+
+void TimelineEventManager::compileClips (const Narrate::NarrateProject& project, int beginClip, int endClip,
+                                         RunEvent* events, Tick* highlightEnds) const
+{
+    const auto& settings = timelineSettings;
+    const double snapInterval = settings.getSnapInterval();
+
+    // Scratch columns for one block of words: start, start of the next word (or the clip
+    // end for a clip's last word), duration and highlight duration
+    std::vector<double> starts, nextStarts, durations, highlights;
+
+    int blockBegin = beginClip;
+
+    while (blockBegin < endClip)
+    {
+        // Whole clips up to about wordsPerBlock words; a longer clip is a block of its own
+        auto count = (size_t) project.getClip (blockBegin).getNumWords();
+        int blockEnd = blockBegin + 1;
+
+        for (; blockEnd < endClip; ++blockEnd)
+        {
+            const auto clipWords = (size_t) project.getClip (blockEnd).getNumWords();
+            if (count + clipWords > wordsPerBlock)
+                break;
+
+            count += clipWords;
+        }
+
+        starts.resize (count);
+        nextStarts.resize (count);
+        durations.resize (count);
+        highlights.resize (count);
+
+        // Absolute word times, and the time each word runs until. The words are gathered
+        // out of each clip's array once; everything after works on the flat columns.
+        size_t begin = 0;
+
+        for (int clipIndex = blockBegin; clipIndex < blockEnd; ++clipIndex)
+        {
+            const auto& clip = project.getClip (clipIndex);
+            const size_t end = begin + (size_t) clip.getNumWords();
+            size_t i = begin;
+
+            for (const auto& word : clip.getWords())
+                starts[i++] = clip.getStartTime() + word.relativeTime;
+
+            if (end > begin)
+            {
+                std::copy (starts.begin() + (std::ptrdiff_t) begin + 1, starts.begin() + (std::ptrdiff_t) end,
+                           nextStarts.begin() + (std::ptrdiff_t) begin);
+                nextStarts[end - 1] = clip.getEndTime();
+            }
+
+            begin = end;
+        }
+
+        if (settings.quantizeEnabled)
         {
-            // Highlight until next grid position
-            double snapInterval = settings.getSnapInterval();
+            // Quantize word start times if enabled
             if (snapInterval > 0.0)
+                quantizeTimes (starts.data(), count, snapInterval);
+
+            // Ensure no word starts before the previous one ends: a running bound, so per clip
+            begin = 0;
+
+            for (int clipIndex = blockBegin; clipIndex < blockEnd; ++clipIndex)
             {
-                // Calculate next grid position
-                double nextGridTime = std::ceil (wordStartTime / snapInterval) * snapInterval;
-                if (nextGridTime <= wordStartTime)
-                    nextGridTime += snapInterval;
+                const auto& clip = project.getClip (clipIndex);
+                const size_t end = begin + (size_t) clip.getNumWords();
+                double currentTime = settings.quantizeTime (clip.getStartTime());
+
+                for (size_t i = begin; i < end; ++i)
+                {
+                    if (starts[i] < currentTime)
+                        starts[i] = currentTime;
+
+                    currentTime = starts[i] + (nextStarts[i] - starts[i]);
+                }
 
-                return nextGridTime - wordStartTime;
+                begin = end;
             }
-            // Fall back to original if no valid grid
-            return wordDuration;
         }
 
-        default:
-            return wordDuration;
+        // Original word durations, then highlight durations based on settings
+        for (size_t i = 0; i < count; ++i)
+            durations[i] = nextStarts[i] - starts[i];
+
+        computeHighlightDurations (settings, starts.data(), durations.data(), highlights.data(), count);
+
+        // Emit each clip's run and sort it by time. Events at the same time keep the order they
+        // were added in (a clip's start before its first word), so the active state is well defined
+        begin = 0;
+
+        for (int clipIndex = blockBegin; clipIndex < blockEnd; ++clipIndex)
+        {
+            const auto& clip = project.getClip (clipIndex);
+            const size_t end = begin + (size_t) clip.getNumWords();
+            RunEvent* const runBegin = events;
+
+            // Quantize clip start time if enabled
+            double clipStartTime = clip.getStartTime();
+            if (settings.quantizeEnabled)
+                clipStartTime = settings.quantizeTime (clipStartTime);
+
+            *events++ = { toTicks (clipStartTime), 0, EventType::ClipStart };
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                const auto wordIndex = (uint32_t) (i - begin);
+                const Tick highlightEnd = toTicks (starts[i] + highlights[i]);
+
+                *events++ = { toTicks (starts[i]), wordIndex, EventType::WordStart };
+                *events++ = { highlightEnd, wordIndex, EventType::HighlightEnd };
+                *events++ = { toTicks (starts[i] + durations[i]), wordIndex, EventType::WordEnd };
+                *highlightEnds++ = highlightEnd;
+            }
+
+            *events++ = { toTicks (clip.getEndTime()), 0, EventType::ClipEnd };
+            sortRun (runBegin, events);
+            begin = end;
+        }
+
+        blockBegin = blockEnd;
     }
 }
 
-void TimelineEventManager::processEvents (double previousTime, double currentTime)
+void TimelineEventManager::mergeClipRuns (const RunEvent* runEvents, const std::vector<Tick>& laterRunsFirstTick,
+                                          int beginClip, int endClip)
 {
-    // Process all events that fall within the time range [previousTime, currentTime)
-    while (nextEventIndex < timeline.size())
+    // k-way merge: a min-heap holds the next event of every run that has started and has one
+    // left. Runs join in clip order once the merge reaches the earliest event of the runs still
+    // waiting, so the heap only holds clips that overlap. Same-time events from different runs
+    // come out in clip order, as a stable sort of all events would.
+    struct RunCursor
+    {
+        const RunEvent* next;
+        const RunEvent* end;
+        uint32_t clipIndex;
+    };
+
+    const auto comesLater = [] (const RunCursor& a, const RunCursor& b)
     {
-        const auto& event = timeline[nextEventIndex];
+        return a.next->tick > b.next->tick
+            || (a.next->tick == b.next->tick && a.clipIndex > b.clipIndex);
+    };
 
-        // Check if this event should fire
-        if (event.time < previousTime)
+    std::vector<RunCursor> heap;
+    size_t out = getRunOffset (beginClip);
+    int nextRun = beginClip;
+
+    for (;;)
+    {
+        // Every run has at least its clip's start and end, so none joins empty
+        while (nextRun < endClip && (heap.empty() || laterRunsFirstTick[(size_t) nextRun] <= heap.front().next->tick))
         {
-            // This event is in the past, skip it
-            nextEventIndex++;
-            continue;
+            heap.push_back ({ runEvents + getRunOffset (nextRun), runEvents + getRunOffset (nextRun + 1), (uint32_t) nextRun });
+            std::push_heap (heap.begin(), heap.end(), comesLater);
+            ++nextRun;
         }
 
-        if (event.time >= currentTime)
-        {
-            // This event is in the future, stop processing
+        if (heap.empty())
             break;
+
+        std::pop_heap (heap.begin(), heap.end(), comesLater);
+        auto& cursor = heap.back();
+        const auto firstWord = (uint32_t) clipFirstWords[cursor.clipIndex];
+        const Tick waitingTick = nextRun < endClip ? laterRunsFirstTick[(size_t) nextRun] : std::numeric_limits<Tick>::max();
+
+        // Take events from this run for as long as it stays ahead of every other run,
+        // so clips that don't overlap are copied through without touching the heap
+        do
+        {
+            const auto& event = *cursor.next++;
+            eventTicks[out] = event.tick;
+            eventIds[out] = isClipEvent (event.type) ? cursor.clipIndex : firstWord + event.id;
+            eventTypes[out] = event.type;
+            ++out;
         }
+        while (cursor.next != cursor.end && cursor.next->tick <= waitingTick
+               && (heap.size() == 1 || ! comesLater (cursor, heap.front())));
+
+        if (cursor.next == cursor.end)
+            heap.pop_back();
+        else
+            std::push_heap (heap.begin(), heap.end(), comesLater);
+    }
+
+    jassert (out == getRunOffset (endClip));
+}
+
+void TimelineEventManager::updateActiveStates (size_t beginEvent, size_t endEvent, ActiveState active)
+{
+    // Record the active clip and word after each event, so a display query can report
+    // them directly
+    for (size_t i = beginEvent; i < endEvent; ++i)
+    {
+        const auto type = eventTypes[i];
+        const auto id = eventIds[i];
 
-        // Fire the event
-        switch (event.type)
+        if (type == EventType::ClipStart)
+        {
+            active = { (int) id, -1 };
+        }
+        else if (type == EventType::WordStart && wordClips[id] == active.clipIndex)
+        {
+            active.wordIndex = (int) id - clipFirstWords[(size_t) active.clipIndex];
+        }
+
+        activeAfter[i] = active;
+    }
+}
+
+void TimelineEventManager::processEvents (double previousTime, double currentTime)
+{
+    moveCursorTo (previousTime);
+
+    // The same loop as the listener version, calling the callbacks that are set directly
+    while (nextEventIndex < eventTicks.size() && isEventBefore (nextEventIndex, currentTime))
+    {
+        const auto id = eventIds[nextEventIndex];
+
+        switch (eventTypes[nextEventIndex])
         {
             case EventType::ClipStart:
                 if (onClipStart)
-                    onClipStart (event.clipIndex);
+                    onClipStart ((int) id);
                 break;
 
             case EventType::ClipEnd:
                 if (onClipEnd)
-                    onClipEnd (event.clipIndex);
+                    onClipEnd ((int) id);
                 break;
 
             case EventType::WordStart:
                 if (onWordStart)
-                    onWordStart (event.clipIndex, event.wordIndex);
+                    onWordStart (wordClips[id], (int) id - clipFirstWords[(size_t) wordClips[id]]);
                 break;
 
             case EventType::WordEnd:
                 if (onWordEnd)
-                    onWordEnd (event.clipIndex, event.wordIndex);
+                    onWordEnd (wordClips[id], (int) id - clipFirstWords[(size_t) wordClips[id]]);
                 break;
 
             case EventType::HighlightEnd:
                 if (onHighlightEnd)
-                    onHighlightEnd (event.clipIndex, event.wordIndex);
+                    onHighlightEnd (wordClips[id], (int) id - clipFirstWords[(size_t) wordClips[id]]);
                 break;
         }
 
@@ -189,22 +652,101 @@ void TimelineEventManager::processEvents (double previousTime, double currentTim
 
 void TimelineEventManager::reset()
 {
-    timeline.clear();
+    eventTicks.clear();
+    eventIds.clear();
+    eventTypes.clear();
+    wordClips.clear();
+    clipFirstWords.clear();
+    clipNumWords.clear();
+    wordHighlightEnds.clear();
+    clipFirstTicks.clear();
+    clipLastTicks.clear();
+    clipLayoutId = 0;
+    activeAfter.clear();
     nextEventIndex = 0;
 }
 
 void TimelineEventManager::seekToTime (double time)
 {
-    // Find the first event at or after the seek time
-    nextEventIndex = 0;
-    for (size_t i = 0; i < timeline.size(); ++i)
+    nextEventIndex = findEventIndex (firstTickAtOrAfter (time));
+}
+
+TimelineEventManager::DisplayState TimelineEventManager::getDisplayStateAt (double time) const
+{
+    // Number of events at or before time
+    const Tick tick = lastTickAtOrBefore (time);
+    const auto end = std::upper_bound (eventTicks.begin(), eventTicks.end(), tick);
+
+    if (end == eventTicks.begin())
+        return {};
+
+    const auto& active = activeAfter[(size_t) (end - eventTicks.begin()) - 1];
+
+    if (active.wordIndex < 0)
+        return { active.clipIndex, -1, false };
+
+    // The tick at or before time is before an integer tick exactly when time is
+    const auto highlightEnd = wordHighlightEnds[(size_t) (clipFirstWords[(size_t) active.clipIndex] + active.wordIndex)];
+    return { active.clipIndex, active.wordIndex, tick < highlightEnd };
+}
+
+TimelineEventManager::TimeEvent TimelineEventManager::getEvent (size_t index) const
+{
+    const auto type = eventTypes[index];
+    const int clipIndex = getEventClip (index);
+    const int wordIndex = isClipEvent (type) ? -1 : (int) eventIds[index] - clipFirstWords[(size_t) clipIndex];
+
+    return { (double) eventTicks[index] / ticksPerSecond, type, clipIndex, wordIndex };
+}
+
+std::vector<TimelineEventManager::TimeEvent> TimelineEventManager::getTimeline() const
+{
+    std::vector<TimeEvent> events;
+    events.reserve (eventTicks.size());
+
+    for (size_t i = 0; i < eventTicks.size(); ++i)
+        events.push_back (getEvent (i));
+
+    return events;
+}
+
+size_t TimelineEventManager::findEventIndex (Tick tick) const
+{
+    const size_t size = eventTicks.size();
+    const size_t cursor = std::min (nextEventIndex, size);
+
+    // Gallop from the cursor in the direction of the target to bracket it, then binary search
+    // the bracket. Playback and small jumps stay near the cursor; a scrub costs O(log n).
+    size_t low, high;
+
+    if (cursor < size && eventTicks[cursor] < tick)
     {
-        if (timeline[i].time >= time)
+        size_t step = 1;
+        low = cursor + 1;
+        high = cursor + 1;
+
+        while (high < size && eventTicks[high] < tick)
         {
-            nextEventIndex = i;
-            return;
+            low = high + 1;
+            high = std::min (size, high + step);
+            step *= 2;
         }
     }
-    // If no events found after seek time, set index to end
-    nextEventIndex = timeline.size();
+    else
+    {
+        size_t step = 1;
+        low = cursor;
+        high = cursor;
+
+        while (low > 0 && eventTicks[low - 1] >= tick)
+        {
+            high = low - 1;
+            low = low > step ? low - step : 0;
+            step *= 2;
+        }
+    }
+
+    return (size_t) (std::lower_bound (eventTicks.begin() + (std::ptrdiff_t) low,
+                                       eventTicks.begin() + (std::ptrdiff_t) std::max (low, high),
+                                       tick) - eventTicks.begin());
 }
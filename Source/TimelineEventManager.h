@@ -2,7 +2,10 @@
 
 #include "NarrateDataModel.h"
 #include "HighlightSettings.h"
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <vector>
 
 class TimelineEventManager
@@ -12,7 +15,7 @@ public:
     ~TimelineEventManager();
 
     // Event types that can occur on the timeline
-    enum class EventType
+    enum class EventType : uint8_t
     {
         ClipStart,
         ClipEnd,
@@ -21,7 +24,7 @@ public:
         HighlightEnd  // NEW: Separate event for when highlight should end
     };
 
-    // A single timed event
+    // A single timed event, as decoded from the compiled timeline
     struct TimeEvent
     {
         double time;
@@ -32,6 +35,30 @@ public:
         bool operator< (const TimeEvent& other) const { return time < other.time; }
     };
 
+    /**
+     * Event times are stored as integer ticks of 2^-20 s (just under a microsecond).
+     * A power of two converts to and from seconds exactly, so comparing a time in seconds
+     * against a tick gives the same answer as comparing it against the decoded time.
+     */
+    using Tick = int64_t;
+    static constexpr double ticksPerSecond = 1048576.0;
+    static constexpr double secondsPerTick = 1.0 / ticksPerSecond;
+
+    /**
+     * Receives fired events. processEvents() is a template over the listener type, so a
+     * listener declared final has its calls resolved at compile time and inlined. The
+     * std::function callbacks below don't go through a listener.
+     */
+    struct Listener
+    {
+        virtual ~Listener() = default;
+        virtual void clipStarted (int /*clipIndex*/) {}
+        virtual void clipEnded (int /*clipIndex*/) {}
+        virtual void wordStarted (int /*clipIndex*/, int /*wordIndex*/) {}
+        virtual void wordEnded (int /*clipIndex*/, int /*wordIndex*/) {}
+        virtual void highlightEnded (int /*clipIndex*/, int /*wordIndex*/) {}
+    };
+
     // Event callbacks
     std::function<void(int clipIndex)> onClipStart;
     std::function<void(int clipIndex)> onClipEnd;
@@ -43,25 +70,249 @@ public:
     void buildTimeline (const Narrate::NarrateProject& project,
                         const HighlightSettings& settings = HighlightSettings());
 
-    // Process all events that occurred between previousTime and currentTime
+    /**
+     * Regenerate the events of one clip after it was edited in place and splice them into
+     * the timeline, using the settings of the last buildTimeline(). Only the stretch of the
+     * timeline between the clip's old and new events is merged again, and the later events
+     * just move along if the clip's number of words changed. The other clips must be as they
+     * were: if clips were added, removed or reordered since the build (see
+     * NarrateProject::getClipLayoutId()), this falls back to a full rebuild. The cursor
+     * stays at the same time.
+     */
+    void rebuildClip (const Narrate::NarrateProject& project, int clipIndex);
+
+    // NarrateProject::getClipLayoutId() of the project the timeline was built from
+    uint64_t getClipLayoutId() const { return clipLayoutId; }
+
+    /**
+     * Threads used to compile large timelines (0 = one per CPU core, 1 = single-threaded).
+     * Projects under parallelBuildMinWords are always compiled on the calling thread. The
+     * threads are started by the first parallel build and kept for later ones.
+     */
+    void setMaxBuildThreads (int numThreads) { maxBuildThreads = numThreads; }
+    int getMaxBuildThreads() const { return maxBuildThreads; }
+
+    static constexpr int parallelBuildMinWords = 65536;
+
+    /**
+     * Process all events that occurred between previousTime and currentTime, through the callbacks.
+     * If previousTime isn't where the last call left off (a seek or jump in either direction),
+     * the cursor is moved there first without firing anything: O(log distance) from where it was.
+     */
     void processEvents (double previousTime, double currentTime);
 
+    // Process all events that occurred between previousTime and currentTime, through a listener
+    template <typename ListenerType>
+    void processEvents (double previousTime, double currentTime, ListenerType& listener);
+
     // Reset the timeline
     void reset();
 
-    // Seek to a specific time position (resets event index to process events from this time)
+    /**
+     * Move the cursor to the first event at or after time, without firing anything.
+     * Searches outward from the current position in either direction, so short hops
+     * cost O(log distance) and any seek at most O(log n).
+     */
     void seekToTime (double time);
 
-    // Get the complete timeline (for debugging/inspection)
-    const std::vector<TimeEvent>& getTimeline() const { return timeline; }
+    /**
+     * The clip and word active at the cursor: as if every event before it had fired
+     * through the callbacks. The clip is the last one started (-1 before the first);
+     * the word is the last word started in that clip (-1 until its first word).
+     */
+    int getActiveClipIndex() const  { return nextEventIndex > 0 ? activeAfter[nextEventIndex - 1].clipIndex : -1; }
+    int getActiveWordIndex() const  { return nextEventIndex > 0 ? activeAfter[nextEventIndex - 1].wordIndex : -1; }
+
+    // What should be on screen at a point in time
+    struct DisplayState
+    {
+        int clipIndex = -1;            // Last clip started at or before the time, -1 before the first
+        int wordIndex = -1;            // Last word started in that clip, -1 until its first word
+        bool highlightActive = false;  // The word's highlight hasn't ended yet
+    };
+
+    /**
+     * The display state at time, as if every event at or before it had fired.
+     * A binary search over the compiled timeline: O(log n), independent of the
+     * cursor and without side effects, so rendering can be a pure function of time.
+     */
+    DisplayState getDisplayStateAt (double time) const;
+
+    // Number of events in the timeline, and one of them decoded
+    size_t getNumEvents() const { return eventTicks.size(); }
+    TimeEvent getEvent (size_t index) const;
+
+    // Decode the complete timeline (for debugging/inspection)
+    std::vector<TimeEvent> getTimeline() const;
 
 private:
-    std::vector<TimeEvent> timeline;
+    struct ActiveState
+    {
+        int clipIndex;
+        int wordIndex;
+    };
+
+    // One clip's events before merging: the id is the word's index within the clip. Each
+    // clip's run is sorted by time; ties keep the order they were generated in.
+    struct RunEvent
+    {
+        Tick tick;
+        uint32_t id;
+        EventType type;
+    };
+
+    HighlightSettings timelineSettings;  // Settings the timeline was built with
+    int maxBuildThreads = 0;
+    std::unique_ptr<juce::ThreadPool> buildPool;  // Kept between builds; see getBuildPool()
+
+    // The compiled timeline, one column per field. The id is the clip index for clip
+    // events and the project-wide word index for word events.
+    std::vector<Tick> eventTicks;
+    std::vector<uint32_t> eventIds;
+    std::vector<EventType> eventTypes;
+
+    // Per-word and per-clip lookups for decoding word ids. A build numbers the words in clip
+    // order; rebuildClip() gives a clip that gained words new ids after all the others.
+    std::vector<int> wordClips;          // Clip of each word id
+    std::vector<int> clipFirstWords;     // Id of each clip's first word, plus the number of ids
+    std::vector<int> clipNumWords;       // Number of words in each clip
+    std::vector<Tick> wordHighlightEnds; // When each word's highlight ends
+
+    // Earliest and latest event of each clip, which bound what rebuildClip() has to merge again
+    std::vector<Tick> clipFirstTicks;
+    std::vector<Tick> clipLastTicks;
+
+    uint64_t clipLayoutId = 0;  // NarrateProject::getClipLayoutId() of the project built from
+
+    std::vector<ActiveState> activeAfter;  // Active clip and word once each event has fired
     size_t nextEventIndex = 0;
 
-    // Helper to calculate highlight duration based on settings
-    double calculateHighlightDuration (double wordDuration, double wordStartTime,
-                                        const HighlightSettings& settings) const;
+    static bool isClipEvent (EventType type)  { return type == EventType::ClipStart || type == EventType::ClipEnd; }
+
+    // Seconds to ticks: nearest for compiling, and the bounds used to compare against a time.
+    // Scaling by a power of two is exact, so only the rounding direction matters. These run
+    // twice per frame, so they round with a cast rather than a libm call.
+    static double toScaledTicks (double time)
+    {
+        // Keep huge or infinite times well inside the tick range instead of overflowing
+        constexpr double maxTicks = 4611686018427387904.0;  // 2^62
+        return std::clamp (time * ticksPerSecond, -maxTicks, maxTicks);
+    }
+
+    static Tick toTicks (double time)
+    {
+        const double scaled = toScaledTicks (time);
+        return (Tick) (scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+    }
+
+    static Tick firstTickAtOrAfter (double time)
+    {
+        const double scaled = toScaledTicks (time);
+        const auto tick = (Tick) scaled;  // Truncates toward zero
+        return (double) tick < scaled ? tick + 1 : tick;
+    }
+
+    static Tick lastTickAtOrBefore (double time)
+    {
+        const double scaled = toScaledTicks (time);
+        const auto tick = (Tick) scaled;
+        return (double) tick > scaled ? tick - 1 : tick;
+    }
+
+    // Clip of an event, from its id
+    int getEventClip (size_t index) const
+    {
+        return isClipEvent (eventTypes[index]) ? (int) eventIds[index] : wordClips[eventIds[index]];
+    }
+
+    // First event at or after tick, searching outward from the cursor
+    size_t findEventIndex (Tick tick) const;
+
+    // A tick converts to seconds exactly, so events can be compared with times directly
+    bool isEventBefore (size_t index, double time) const { return (double) eventTicks[index] * secondsPerTick < time; }
+
+    // Move the cursor to previousTime if it isn't there: skip past events in one search rather
+    // than one by one, and go back to replay events after a backward jump
+    void moveCursorTo (double previousTime)
+    {
+        if ((nextEventIndex < eventTicks.size() && isEventBefore (nextEventIndex, previousTime))
+            || (nextEventIndex > 0 && ! isEventBefore (nextEventIndex - 1, previousTime)))
+            nextEventIndex = findEventIndex (firstTickAtOrAfter (previousTime));
+    }
+
+    // Where a clip's run starts among all runs: two clip events and three per word before it.
+    // Only while building, when the word ids are in clip order.
+    size_t getRunOffset (int clipIndex) const
+    {
+        return (size_t) (2 * clipIndex) + 3 * (size_t) clipFirstWords[(size_t) clipIndex];
+    }
+
+    /**
+     * Generate and sort the runs of clips [beginClip, endClip) into events, and their words'
+     * highlight ends into highlightEnds. Works through blocks of words with branch-free
+     * loops over the word times; ranges of clips can be compiled on separate threads.
+     */
+    void compileClips (const Narrate::NarrateProject& project, int beginClip, int endClip,
+                       RunEvent* events, Tick* highlightEnds) const;
+
+    // Merge the runs of clips [beginClip, endClip) into their place in the timeline columns.
+    // laterRunsFirstTick holds the earliest event of each clip's run and every run after it.
+    void mergeClipRuns (const RunEvent* runEvents, const std::vector<Tick>& laterRunsFirstTick,
+                        int beginClip, int endClip);
+
+    // The pool for a parallel build, started on first use and again only if numThreads changes
+    juce::ThreadPool& getBuildPool (int numThreads);
+
+    // Record the active state after each event in a range, starting from the given state
+    void updateActiveStates (size_t beginEvent, size_t endEvent, ActiveState active = { -1, -1 });
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TimelineEventManager)
 };
+
+template <typename ListenerType>
+void TimelineEventManager::processEvents (double previousTime, double currentTime, ListenerType& listener)
+{
+    moveCursorTo (previousTime);
+
+    // Process all events that fall within the time range [previousTime, currentTime).
+    // Only the tick column is read to find them; ids are decoded for the ones that fire.
+    while (nextEventIndex < eventTicks.size() && isEventBefore (nextEventIndex, currentTime))
+    {
+        const auto id = eventIds[nextEventIndex];
+
+        // Fire the event
+        switch (eventTypes[nextEventIndex])
+        {
+            case EventType::ClipStart:
+                listener.clipStarted ((int) id);
+                break;
+
+            case EventType::ClipEnd:
+                listener.clipEnded ((int) id);
+                break;
+
+            case EventType::WordStart:
+            {
+                const int clipIndex = wordClips[id];
+                listener.wordStarted (clipIndex, (int) id - clipFirstWords[(size_t) clipIndex]);
+                break;
+            }
+
+            case EventType::WordEnd:
+            {
+                const int clipIndex = wordClips[id];
+                listener.wordEnded (clipIndex, (int) id - clipFirstWords[(size_t) clipIndex]);
+                break;
+            }
+
+            case EventType::HighlightEnd:
+            {
+                const int clipIndex = wordClips[id];
+                listener.highlightEnded (clipIndex, (int) id - clipFirstWords[(size_t) clipIndex]);
+                break;
+            }
+        }
+
+        nextEventIndex++;
+    }
+}
@@ -10,6 +10,13 @@ ExportPanel::ExportPanel(NarrateAudioProcessor* processor)
 
     exportVttButton.onClick = [this] { exportVttClicked(); };
     addAndMakeVisible(exportVttButton);
+
+    exportAllButton.setTooltip("Export SRT, WebVTT, text, JSON and CSV in one pass");
+    exportAllButton.onClick = [this] { exportAllClicked(); };
+    addAndMakeVisible(exportAllButton);
+
+    clipCuesToggle.setTooltip("SRT/WebVTT: one cue per clip instead of per word (WebVTT keeps word timing)");
+    addAndMakeVisible(clipCuesToggle);
 #endif
 }
 
@@ -33,6 +40,10 @@ void ExportPanel::resized()
     exportSrtButton.setBounds(area.removeFromLeft(100));
     area.removeFromLeft(5);
     exportVttButton.setBounds(area.removeFromLeft(100));
+    area.removeFromLeft(5);
+    exportAllButton.setBounds(area.removeFromLeft(100));
+    area.removeFromLeft(5);
+    clipCuesToggle.setBounds(area.removeFromLeft(110));
 #endif
 }
 
@@ -40,26 +51,58 @@ void ExportPanel::resized()
 
 void ExportPanel::exportSrtClicked()
 {
-    // TODO: Get project from processor/editor
-    juce::AlertWindow::showMessageBoxAsync(
-        juce::MessageBoxIconType::InfoIcon,
-        "Export SRT",
-        "Export functionality is ready!\n\n"
-        "This will be wired up when EditorView is refactored.\n"
-        "Implementation: StandaloneExportFeature::exportSRT()",
-        "OK");
+    exportFormats("Export SRT", { "srt" });
 }
 
 void ExportPanel::exportVttClicked()
 {
-    // TODO: Get project from processor/editor
-    juce::AlertWindow::showMessageBoxAsync(
-        juce::MessageBoxIconType::InfoIcon,
-        "Export WebVTT",
-        "Export functionality is ready!\n\n"
-        "This will be wired up when EditorView is refactored.\n"
-        "Implementation: StandaloneExportFeature::exportWebVTT()",
-        "OK");
+    exportFormats("Export WebVTT", { "vtt" });
+}
+
+void ExportPanel::exportAllClicked()
+{
+    exportFormats("Export All Formats", ExportFeature::getFormatNames());
+}
+
+void ExportPanel::exportFormats(const juce::String& title, const juce::StringArray& formats)
+{
+    if (getProjectToExport == nullptr)
+        return;
+
+    // A single format filters by its extension; several are named after the chosen file
+    const auto pattern = formats.size() == 1 ? "*." + formats[0] : juce::String("*");
+    auto chooser = std::make_shared<juce::FileChooser>(title, juce::File(), pattern);
+
+    auto chooserFlags = juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles;
+
+    chooser->launchAsync(chooserFlags, [this, chooser, title, formats](const juce::FileChooser& fc)
+    {
+        auto file = fc.getResult();
+        if (file == juce::File())
+            return;
+
+        std::vector<ExportTarget> targets;
+        for (const auto& format : formats)
+            targets.push_back({ format, file.withFileExtension(format) });
+
+        auto& exportFeature = audioProcessor->getExportFeature();
+        exportFeature.setCueMode(clipCuesToggle.getToggleState() ? ExportFeature::CueMode::Clip
+                                                                 : ExportFeature::CueMode::Word);
+
+        const auto& project = getProjectToExport();
+        if (exportFeature.exportFormats(project, targets))
+            return;
+
+        juce::StringArray failed;
+        for (const auto& target : targets)
+            if (!target.succeeded)
+                failed.add(target.file.getFileName());
+
+        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon,
+                                               title + " Failed",
+                                               project.getNumClips() == 0 ? juce::String("The project has no clips to export.")
+                                                                          : "Could not write:\n" + failed.joinIntoString("\n"));
+    });
 }
 
 #endif // NARRATE_SHOW_EXPORT_MENU
@@ -2,9 +2,15 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "../NarrateConfig.h"
+#include <functional>
 
 class NarrateAudioProcessor;
 
+namespace Narrate
+{
+    class NarrateProject;
+}
+
 /**
  * ExportPanel
  *
@@ -20,6 +26,9 @@ public:
     void paint(juce::Graphics& g) override;
     void resized() override;
 
+    // Supplies the project to export (set by the owning view)
+    std::function<const Narrate::NarrateProject&()> getProjectToExport;
+
 private:
     NarrateAudioProcessor* audioProcessor;
 
@@ -27,9 +36,15 @@ private:
     // Standalone-only members
     juce::TextButton exportSrtButton {"Export SRT"};
     juce::TextButton exportVttButton {"Export WebVTT"};
+    juce::TextButton exportAllButton {"Export All"};
+    juce::ToggleButton clipCuesToggle {"Cue per clip"};
 
     void exportSrtClicked();
     void exportVttClicked();
+    void exportAllClicked();
+
+    // Asks for an output file, then writes every format in one pass as <file>.<format>
+    void exportFormats(const juce::String& title, const juce::StringArray& formats);
 #endif
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ExportPanel)
@@ -0,0 +1,276 @@
+// Export benchmarks (whole-file String vs streamed ExportWriter, String vs to_chars formatting,
+// one export per format vs a single multi-format pass, word vs clip cues).
+// Run with: NarrateBenchmarks "[export]"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "../../Source/NarrateDataModel.h"
+#include "../../Source/Features/StandaloneExportFeature.h"
+#include "../../Source/Features/ExportWriter.h"
+
+#include <fstream>
+#include <vector>
+#include <iostream>
+
+#if JUCE_LINUX
+ #include <malloc.h>
+#endif
+
+using namespace Narrate;
+
+namespace
+{
+    NarrateProject createLargeProject(int numClips, int wordsPerClip)
+    {
+        static const char* vocabulary[] = { "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog" };
+
+        NarrateProject project;
+        NarrateProject::ClipBatch batch(project, numClips);
+
+        for (int i = 0; i < numClips; ++i)
+        {
+            NarrateClip clip("clip" + juce::String(i), i * 3.0, i * 3.0 + 2.5);
+            clip.reserveWords(wordsPerClip);
+
+            for (int w = 0; w < wordsPerClip; ++w)
+                clip.addWord(NarrateWord(vocabulary[(i + w) % 8], w * 0.25));
+
+            batch.add(std::move(clip));
+        }
+
+        batch.finish();
+        return project;
+    }
+
+    // The SRT export as it was before streaming: the whole file is built as one String
+    juce::String buildSRTString(const NarrateProject& project)
+    {
+        auto formatTimestamp = [](double seconds)
+        {
+            int hours = static_cast<int>(seconds) / 3600;
+            int minutes = (static_cast<int>(seconds) % 3600) / 60;
+            int secs = static_cast<int>(seconds) % 60;
+            int millis = static_cast<int>((seconds - static_cast<int>(seconds)) * 1000);
+            return juce::String::formatted("%02d:%02d:%02d,%03d", hours, minutes, secs, millis);
+        };
+
+        juce::String content;
+        int sequenceNumber = 1;
+
+        for (int clipIdx = 0; clipIdx < project.getNumClips(); ++clipIdx)
+        {
+            const auto& clip = project.getClip(clipIdx);
+
+            for (int wordIdx = 0; wordIdx < clip.getNumWords(); ++wordIdx)
+            {
+                const auto& word = clip.getWord(wordIdx);
+                double startTime = clip.getStartTime() + word.relativeTime;
+                double endTime = wordIdx + 1 < clip.getNumWords() ? clip.getStartTime() + clip.getWord(wordIdx + 1).relativeTime
+                                                                  : clip.getEndTime();
+
+                content += juce::String(sequenceNumber++) + "\n";
+                content += formatTimestamp(startTime) + " --> " + formatTimestamp(endTime) + "\n";
+                content += word.text + "\n\n";
+            }
+        }
+
+        return content;
+    }
+
+   #if JUCE_LINUX
+    juce::int64 readStatusKB(const std::string& field)
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+
+        while (std::getline(status, line))
+            if (line.rfind(field, 0) == 0)
+                return std::stoll(line.substr(field.size()));
+
+        return -1;
+    }
+
+    void resetPeakMemory()
+    {
+        malloc_trim(0);
+        std::ofstream("/proc/self/clear_refs") << "5";
+    }
+
+    juce::int64 getCurrentMemoryKB() { return readStatusKB("VmRSS:"); }
+    juce::int64 getPeakMemoryKB()    { return readStatusKB("VmHWM:"); }
+   #else
+    void resetPeakMemory() {}
+    juce::int64 getCurrentMemoryKB() { return -1; }
+    juce::int64 getPeakMemoryKB()    { return -1; }
+   #endif
+
+    template <typename ExportFunction>
+    void reportExport(const char* name, const juce::File& file, ExportFunction&& exportTo)
+    {
+        resetPeakMemory();
+        auto baseline = getCurrentMemoryKB();
+        auto start = juce::Time::getMillisecondCounterHiRes();
+
+        REQUIRE(exportTo());
+
+        auto elapsed = juce::Time::getMillisecondCounterHiRes() - start;
+        auto peak = getPeakMemoryKB();
+
+        std::cout << name << ": " << (file.getSize() / 1024) << " KB, " << juce::String(elapsed, 1) << " ms, "
+                  << "peak RSS +" << (baseline >= 0 ? juce::String(peak - baseline) + " KB" : juce::String("n/a")) << "\n";
+    }
+}
+
+TEST_CASE("SRT export: whole-file String vs streamed", "[.][benchmark][export]")
+{
+    auto project = createLargeProject(20000, 10);  // 200k words
+    StandaloneExportFeature exporter;
+
+    auto file = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("narrate-bench-export.srt");
+
+    BENCHMARK("String + replaceWithText (200k words)")
+    {
+        return file.replaceWithText(buildSRTString(project));
+    };
+
+    BENCHMARK("ExportWriter (200k words)")
+    {
+        return exporter.exportSRT(project, file);
+    };
+
+    BENCHMARK("JSON via ExportWriter (200k words)")
+    {
+        return exporter.exportJSON(project, file);
+    };
+
+    file.deleteFile();
+}
+
+TEST_CASE("Multi-format export: one pass vs one export per format", "[.][benchmark][export]")
+{
+    auto project = createLargeProject(20000, 10);  // 200k words
+    StandaloneExportFeature exporter;
+
+    auto base = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("narrate-bench-multi");
+    const juce::StringArray formats { "srt", "vtt", "json", "csv" };
+
+    BENCHMARK("four separate exports (200k words)")
+    {
+        return exporter.exportSRT(project, base.withFileExtension("srt"))
+            && exporter.exportWebVTT(project, base.withFileExtension("vtt"))
+            && exporter.exportJSON(project, base.withFileExtension("json"))
+            && exporter.exportCSV(project, base.withFileExtension("csv"));
+    };
+
+    BENCHMARK("exportFormats, one pass (200k words)")
+    {
+        std::vector<ExportTarget> targets;
+        for (const auto& format : formats)
+            targets.push_back({ format, base.withFileExtension(format) });
+
+        return exporter.exportFormats(project, targets);
+    };
+
+    for (const auto& format : formats)
+        base.withFileExtension(format).deleteFile();
+}
+
+TEST_CASE("Subtitle export: word cues vs clip cues", "[.][benchmark][export]")
+{
+    auto project = createLargeProject(20000, 10);  // 200k words
+    StandaloneExportFeature exporter;
+
+    auto file = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("narrate-bench-cues.vtt");
+
+    for (auto mode : { ExportFeature::CueMode::Word, ExportFeature::CueMode::Clip })
+    {
+        exporter.setCueMode(mode);
+        REQUIRE(exporter.exportWebVTT(project, file));
+        const auto vttSize = file.getSize();
+        REQUIRE(exporter.exportSRT(project, file));
+
+        std::cout << (mode == ExportFeature::CueMode::Word ? "Word" : "Clip") << " cues: WebVTT "
+                  << (vttSize / 1024) << " KB, SRT " << (file.getSize() / 1024) << " KB\n";
+    }
+
+    exporter.setCueMode(ExportFeature::CueMode::Word);
+    BENCHMARK("WebVTT, word cues (200k words)")
+    {
+        return exporter.exportWebVTT(project, file);
+    };
+
+    exporter.setCueMode(ExportFeature::CueMode::Clip);
+    BENCHMARK("WebVTT, clip cues (200k words)")
+    {
+        return exporter.exportWebVTT(project, file);
+    };
+
+    BENCHMARK("SRT, clip cues (200k words)")
+    {
+        return exporter.exportSRT(project, file);
+    };
+
+    file.deleteFile();
+}
+
+TEST_CASE("Export formatting: String vs ExportWriter", "[.][benchmark][export]")
+{
+    // 100k times spread over a long project, as the exporters see them
+    std::vector<double> times;
+    for (int i = 0; i < 100000; ++i)
+        times.push_back(i * 3.217 + (i % 7) * 0.013);
+
+    BENCHMARK("String::formatted timestamps (100k)")
+    {
+        size_t total = 0;
+        for (auto seconds : times)
+        {
+            int millis = static_cast<int>((seconds - static_cast<int>(seconds)) * 1000);
+            total += juce::String::formatted("%02d:%02d:%02d,%03d", static_cast<int>(seconds) / 3600,
+                                             (static_cast<int>(seconds) % 3600) / 60, static_cast<int>(seconds) % 60, millis).length();
+        }
+        return total;
+    };
+
+    BENCHMARK("ExportWriter timestamps (100k)")
+    {
+        juce::MemoryOutputStream stream(2 * 1024 * 1024);
+        ExportWriter writer(stream);
+        for (auto seconds : times)
+            writer.writeTimestamp(seconds, ',');
+        writer.flush();
+        return stream.getDataSize();
+    };
+
+    BENCHMARK("juce::String(double) numbers (100k)")
+    {
+        size_t total = 0;
+        for (auto seconds : times)
+            total += juce::String(seconds).length();
+        return total;
+    };
+
+    BENCHMARK("ExportWriter numbers (100k)")
+    {
+        juce::MemoryOutputStream stream(4 * 1024 * 1024);
+        ExportWriter writer(stream);
+        for (auto seconds : times)
+            writer.writeNumber(seconds);
+        writer.flush();
+        return stream.getDataSize();
+    };
+}
+
+TEST_CASE("Export: peak memory", "[.][benchmark][export]")
+{
+    auto project = createLargeProject(100000, 10);  // 1M words
+    StandaloneExportFeature exporter;
+
+    auto file = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("narrate-bench-export.srt");
+
+    reportExport("SRT via String", file, [&] { return file.replaceWithText(buildSRTString(project)); });
+    reportExport("SRT streamed", file, [&] { return exporter.exportSRT(project, file); });
+    reportExport("JSON streamed", file, [&] { return exporter.exportJSON(project, file); });
+    reportExport("CSV streamed", file, [&] { return exporter.exportCSV(project, file); });
+
+    file.deleteFile();
+}
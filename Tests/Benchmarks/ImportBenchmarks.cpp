@@ -0,0 +1,296 @@
+// Import throughput benchmarks.
+// Run with: NarrateBenchmarks "[benchmark]"
+// Timings should grow roughly linearly with the cue count; a quadratic jump
+// between the sizes below means clip insertion has regressed.
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "../../Source/NarrateDataModel.h"
+#include "../../Source/Features/StandaloneImportFeature.h"
+#include "../../Source/Features/SubtitleTokenizer.h"
+#include "../../Source/Features/TextImportSource.h"
+#include "../../Source/Features/TextSanitizer.h"
+
+using namespace Narrate;
+
+namespace
+{
+    juce::String formatSrtTime(int totalMs)
+    {
+        return juce::String::formatted("%02d:%02d:%02d,%03d",
+                                       totalMs / 3600000, (totalMs / 60000) % 60,
+                                       (totalMs / 1000) % 60, totalMs % 1000);
+    }
+
+    juce::File writeSrtFile(int numCues)
+    {
+        auto file = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                        .getChildFile("narrate-bench-" + juce::String(numCues) + ".srt");
+
+        juce::String content;
+        content.preallocateBytes((size_t) numCues * 64);
+
+        for (int i = 0; i < numCues; ++i)
+        {
+            int start = i * 2000;
+            content << (i + 1) << "\n"
+                    << formatSrtTime(start) << " --> " << formatSrtTime(start + 1500) << "\n"
+                    << "Subtitle line number " << i << " with a few words\n\n";
+        }
+
+        file.replaceWithText(content);
+        return file;
+    }
+}
+
+TEST_CASE("SRT import scales linearly", "[.][benchmark][import]")
+{
+    for (int numCues : { 1000, 10000, 50000 })
+    {
+        auto file = writeSrtFile(numCues);
+        StandaloneImportFeature importer;
+
+        BENCHMARK("importSRT " + std::to_string(numCues) + " cues")
+        {
+            NarrateProject project;
+            importer.importSRT(file, project);
+            return project.getNumClips();
+        };
+
+        file.deleteFile();
+    }
+}
+
+TEST_CASE("Clip insertion: addClip vs ClipBatch", "[.][benchmark][data-model]")
+{
+    constexpr int numClips = 2000;
+
+    BENCHMARK("addClip x" + std::to_string(numClips))
+    {
+        NarrateProject project;
+        for (int i = 0; i < numClips; ++i)
+            project.addClip(NarrateClip("clip" + juce::String(i), i * 2.0, i * 2.0 + 1.5));
+        return project.getNumClips();
+    };
+
+    BENCHMARK("ClipBatch x" + std::to_string(numClips))
+    {
+        NarrateProject project;
+        NarrateProject::ClipBatch batch(project, numClips);
+        for (int i = 0; i < numClips; ++i)
+            batch.add(NarrateClip("clip" + juce::String(i), i * 2.0, i * 2.0 + 1.5));
+        batch.finish();
+        return project.getNumClips();
+    };
+}
+
+TEST_CASE("SRT cue scanning: line-based vs SubtitleTokenizer", "[.][benchmark][import]")
+{
+    constexpr int numCues = 50000;
+    auto file = writeSrtFile(numCues);
+
+    // The pre-tokenizer approach: decode the whole file, split into a StringArray, parse timecodes via juce::String
+    BENCHMARK("line-based " + std::to_string(numCues) + " cues")
+    {
+        auto lines = juce::StringArray::fromLines(file.loadFileAsString());
+        double totalDuration = 0.0;
+
+        for (int i = 0; i + 2 < lines.size(); i += 4)
+        {
+            auto timecodeLine = lines[i + 1].trim();
+            int separatorPos = timecodeLine.indexOf("-->");
+            auto start = ImportFeature::parseTimecode(timecodeLine.substring(0, separatorPos));
+            auto end = ImportFeature::parseTimecode(timecodeLine.substring(separatorPos + 3));
+            auto words = juce::StringArray::fromTokens(lines[i + 2].trim(), " ", "");
+            totalDuration += (end - start) * words.size();
+        }
+
+        return totalDuration;
+    };
+
+    BENCHMARK("SubtitleTokenizer " + std::to_string(numCues) + " cues")
+    {
+        juce::MemoryBlock data;
+        file.loadFileAsData(data);
+        SubtitleTokenizer tokenizer(std::string_view(static_cast<const char*>(data.getData()), data.getSize()),
+                                    SubtitleTokenizer::Format::SRT);
+        SubtitleTokenizer::Cue cue;
+        std::vector<juce::String> words;
+        double totalDuration = 0.0;
+
+        while (tokenizer.next(cue))
+        {
+            words.clear();
+            SubtitleTokenizer::splitWords(cue.text, SubtitleTokenizer::Format::SRT, words);
+            totalDuration += (cue.endTime - cue.startTime) * (double) words.size();
+        }
+
+        return totalDuration;
+    };
+
+    // The importer's path: the file mapped and read in place, window by window
+    BENCHMARK("SubtitleTokenizer mapped " + std::to_string(numCues) + " cues")
+    {
+        auto source = TextImportSource::open(file);
+        std::string_view window;
+        std::vector<juce::String> words;
+        double totalDuration = 0.0;
+
+        for (bool firstWindow = true; source->nextWindow(window); firstWindow = false)
+        {
+            SubtitleTokenizer tokenizer(window, SubtitleTokenizer::Format::SRT, firstWindow);
+            SubtitleTokenizer::Cue cue;
+
+            while (tokenizer.next(cue))
+            {
+                words.clear();
+                SubtitleTokenizer::splitWords(cue.text, SubtitleTokenizer::Format::SRT, words);
+                totalDuration += (cue.endTime - cue.startTime) * (double) words.size();
+            }
+        }
+
+        return totalDuration;
+    };
+
+    file.deleteFile();
+}
+
+TEST_CASE("Parallel SRT import scaling", "[.][benchmark][import]")
+{
+    constexpr int numCues = 200000;
+    auto file = writeSrtFile(numCues);
+
+    for (int numThreads : { 1, 2, 4, 8 })
+    {
+        StandaloneImportFeature importer;
+        importer.setMaxImportThreads(numThreads);
+
+        BENCHMARK("importSRT " + std::to_string(numCues) + " cues, " + std::to_string(numThreads) + " threads")
+        {
+            NarrateProject project;
+            importer.importSRT(file, project);
+            return project.getNumClips();
+        };
+    }
+
+    file.deleteFile();
+}
+
+TEST_CASE("Text sanitizing: per-line String chain vs TextSanitizer", "[.][benchmark][import]")
+{
+    // Mostly ASCII subtitle text with the odd accented word, zero-width space and control character
+    std::string text;
+    for (int i = 0; text.size() < 8 * 1024 * 1024; ++i)
+    {
+        text += std::to_string(i + 1) + "\n00:00:01,000 --> 00:00:02,000\nSubtitle line number " + std::to_string(i);
+        text += i % 5 == 0 ? " caf\xC3\xA9\xE2\x80\x8B with\x01 words\n\n" : " with a few words\n\n";
+    }
+
+    const auto megabytes = std::to_string(text.size() / (1024 * 1024));
+    std::string buffer;
+
+    // The pre-tokenizer cleanup, applied to every line
+    BENCHMARK("String chain " + megabytes + " MB")
+    {
+        auto lines = juce::StringArray::fromLines(juce::String::fromUTF8(text.data(), (int) text.size()));
+        size_t totalLength = 0;
+
+        for (auto line : lines)
+        {
+            line = line.replace(juce::CharPointer_UTF8("\xE2\x80\x8B"), "");
+            line = line.replace(juce::CharPointer_UTF8("\xEF\xBB\xBF"), "");
+            line = line.removeCharacters("\x01\x02\x03\x04\x05\x06\x07\x08\x0B\x0C\x0E\x0F"
+                                         "\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F");
+            totalLength += line.getNumBytesAsUTF8();
+        }
+
+        return totalLength;
+    };
+
+    BENCHMARK("TextSanitizer scalar " + megabytes + " MB")
+    {
+        buffer = text;
+        return TextSanitizer::sanitizeScalar(buffer.data(), buffer.size());
+    };
+
+    BENCHMARK("TextSanitizer " + std::string(TextSanitizer::getKernelName()) + " " + megabytes + " MB")
+    {
+        buffer = text;
+        return TextSanitizer::sanitize(buffer.data(), buffer.size());
+    };
+
+    BENCHMARK("copy only " + megabytes + " MB")
+    {
+        buffer = text;
+        return buffer.size();
+    };
+}
+
+TEST_CASE("JSON import: juce::var DOM vs pull parser", "[.][benchmark][import]")
+{
+    // Same layout as StandaloneExportFeature::exportJSON
+    constexpr int numClips = 20000;
+    auto file = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("narrate-bench.json");
+
+    juce::String content;
+    content.preallocateBytes((size_t) numClips * 700);
+    content << "{\n  \"projectName\": \"Bench\",\n  \"styles\": [\n"
+            << "    { \"bold\": false, \"italic\": false, \"colour\": \"FFFFFF\", \"fontSizeMultiplier\": 1.0 }\n  ],\n"
+            << "  \"clips\": [\n";
+
+    for (int i = 0; i < numClips; ++i)
+    {
+        content << "    {\n      \"id\": \"clip-" << i << "\",\n      \"startTime\": " << i * 2 << ",\n"
+                << "      \"endTime\": " << i * 2 + 1.5 << ",\n      \"duration\": 1.5,\n      \"defaultStyle\": 0,\n"
+                << "      \"words\": [\n";
+
+        for (int w = 0; w < 5; ++w)
+            content << "        {\n          \"text\": \"word" << w << "\",\n          \"relativeTime\": " << w * 0.3
+                    << ",\n          \"absoluteTime\": " << i * 2 + w * 0.3 << "\n        }" << (w < 4 ? ",\n" : "\n");
+
+        content << "      ]\n    }" << (i < numClips - 1 ? ",\n" : "\n");
+    }
+
+    content << "  ]\n}\n";
+    file.replaceWithText(content);
+
+    // The previous importer's approach: parse into juce::var, then look up every property by name
+    BENCHMARK("juce::JSON::parse + var walk " + std::to_string(numClips) + " clips")
+    {
+        juce::var json;
+        juce::JSON::parse(file.loadFileAsString(), json);
+
+        NarrateProject project;
+        NarrateProject::ClipBatch batch(project);
+
+        for (const auto& clipVar : *json.getDynamicObject()->getProperty("clips").getArray())
+        {
+            auto* clipObj = clipVar.getDynamicObject();
+            double startTime = clipObj->getProperty("startTime");
+
+            NarrateClip clip;
+            clip.setStartTime(startTime);
+            clip.setEndTime(startTime + (double) clipObj->getProperty("duration"));
+
+            for (const auto& wordVar : *clipObj->getProperty("words").getArray())
+            {
+                auto* wordObj = wordVar.getDynamicObject();
+                clip.addWord(NarrateWord(wordObj->getProperty("text").toString(), wordObj->getProperty("relativeTime")));
+            }
+
+            batch.add(std::move(clip));
+        }
+
+        batch.finish();
+        return project.getNumClips();
+    };
+
+    BENCHMARK("importJSON (pull parser) " + std::to_string(numClips) + " clips")
+    {
+        StandaloneImportFeature importer;
+        NarrateProject project;
+        importer.importJSON(file, project);
+        return project.getNumClips();
+    };
+
+    file.deleteFile();
+}
@@ -0,0 +1,332 @@
+// Per-frame playback query benchmarks.
+// Run with: NarrateBenchmarks "[playback]"
+//
+// One 60 fps frame of a running view asks the project for its total duration once in
+// the timer callback, once for the timer label and once per drawn word, and looks up
+// the clip and word at the playhead. "linear" reproduces the old per-call scans;
+// "cached" uses the project's cached aggregates and time index.
+//
+// "[timeline]" compares the old linear seek with the cursor's galloping search and the
+// display state's binary search for the running view's scrubs, and times the cursor
+// following 5 s jumps in processEvents().
+//
+// "[sweep]" plays a 1M-event timeline through frame by frame, firing every event: the
+// old padded event structs with std::function callbacks, the compact columns with the
+// same callbacks, and the columns with a final listener the compiler can inline. At
+// 60 fps most frames fire nothing, so it also fires every event in a single call.
+//
+// "[build]" compiles the same 1M-event timeline on one thread and on one thread per core.
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "../../Source/TimelineEventManager.h"
+
+#include <cmath>
+#include <functional>
+#include <vector>
+
+using namespace Narrate;
+
+namespace
+{
+    constexpr int numClips = 10000;
+    constexpr int wordsPerClip = 8;
+    constexpr int wordsDrawnPerFrame = 200;
+
+    // 40k clips of 8 words: 2 clip events and 3 word events each, 1.04M timeline events
+    constexpr int sweepClips = 40000;
+
+    NarrateProject createProject(int clipCount = numClips)
+    {
+        NarrateProject project;
+        NarrateProject::ClipBatch batch(project, clipCount);
+
+        for (int i = 0; i < clipCount; ++i)
+        {
+            NarrateClip clip("clip" + juce::String(i), i * 2.0, i * 2.0 + 1.8);
+            for (int w = 0; w < wordsPerClip; ++w)
+                clip.addWord(NarrateWord("word", w * 0.2));
+
+            batch.add(std::move(clip));
+        }
+
+        return project;
+    }
+
+    // The timeline as it was stored before: one padded struct per event, dispatched
+    // through std::function callbacks
+    struct LegacyTimeline
+    {
+        std::vector<TimelineEventManager::TimeEvent> events;
+        size_t nextEventIndex = 0;
+
+        std::function<void(int clipIndex)> onClipStart;
+        std::function<void(int clipIndex)> onClipEnd;
+        std::function<void(int clipIndex, int wordIndex)> onWordStart;
+        std::function<void(int clipIndex, int wordIndex)> onWordEnd;
+        std::function<void(int clipIndex, int wordIndex)> onHighlightEnd;
+
+        void processEvents(double currentTime)
+        {
+            using EventType = TimelineEventManager::EventType;
+
+            while (nextEventIndex < events.size() && events[nextEventIndex].time < currentTime)
+            {
+                const auto& event = events[nextEventIndex++];
+
+                switch (event.type)
+                {
+                    case EventType::ClipStart:    if (onClipStart) onClipStart(event.clipIndex); break;
+                    case EventType::ClipEnd:      if (onClipEnd) onClipEnd(event.clipIndex); break;
+                    case EventType::WordStart:    if (onWordStart) onWordStart(event.clipIndex, event.wordIndex); break;
+                    case EventType::WordEnd:      if (onWordEnd) onWordEnd(event.clipIndex, event.wordIndex); break;
+                    case EventType::HighlightEnd: if (onHighlightEnd) onHighlightEnd(event.clipIndex, event.wordIndex); break;
+                }
+            }
+        }
+    };
+
+    // Tracks the clip and word on screen, as the running view used to
+    struct SweepListener final : TimelineEventManager::Listener
+    {
+        int clipIndex = -1;
+        int wordIndex = -1;
+        size_t fired = 0;
+
+        void clipStarted(int clip) override { clipIndex = clip; wordIndex = -1; ++fired; }
+        void clipEnded(int) override { ++fired; }
+        void wordStarted(int clip, int word) override { if (clip == clipIndex) wordIndex = word; ++fired; }
+        void wordEnded(int, int) override { ++fired; }
+        void highlightEnded(int, int) override { ++fired; }
+    };
+
+    double linearTotalDuration(const NarrateProject& project)
+    {
+        double maxEnd = 0.0;
+        for (int i = 0; i < project.getNumClips(); ++i)
+            maxEnd = juce::jmax(maxEnd, project.getClip(i).getEndTime());
+        return maxEnd;
+    }
+
+    int linearClipIndexAtTime(const NarrateProject& project, double time)
+    {
+        for (int i = 0; i < project.getNumClips(); ++i)
+        {
+            const auto& clip = project.getClip(i);
+            if (time >= clip.getStartTime() && time < clip.getEndTime())
+                return i;
+        }
+        return -1;
+    }
+
+    int linearWordIndexAtTime(const NarrateClip& clip, double time)
+    {
+        const auto& words = clip.getWords();
+        for (int i = 0; i < words.size(); ++i)
+        {
+            double start = clip.getStartTime() + words[i].relativeTime;
+            double end = i < words.size() - 1 ? clip.getStartTime() + words[i + 1].relativeTime : clip.getEndTime();
+            if (time >= start && time < end)
+                return i;
+        }
+        return -1;
+    }
+}
+
+TEST_CASE("Playback frame queries on 10k clips", "[.][benchmark][playback]")
+{
+    const auto project = createProject();
+    const double playhead = numClips * 2.0 * 0.75;  // Three quarters through
+
+    BENCHMARK("one frame - linear")
+    {
+        double sum = 0.0;
+        sum += linearTotalDuration(project);                   // Timer callback end check
+
+        auto clipIndex = linearClipIndexAtTime(project, playhead);
+        if (clipIndex >= 0)
+            sum += linearWordIndexAtTime(project.getClip(clipIndex), playhead);
+
+        for (int w = 0; w < wordsDrawnPerFrame; ++w)
+            sum += linearTotalDuration(project) > playhead;    // Per-word highlight check
+
+        sum += linearTotalDuration(project);                   // Timer label
+        return sum;
+    };
+
+    BENCHMARK("one frame - cached")
+    {
+        double sum = 0.0;
+        sum += project.getTotalDuration();
+
+        auto clipIndex = project.getClipIndexAtTime(playhead);
+        if (clipIndex >= 0)
+            sum += project.getWordIndexAtTime(clipIndex, playhead);
+
+        for (int w = 0; w < wordsDrawnPerFrame; ++w)
+            sum += project.getTotalDuration() > playhead;
+
+        sum += project.getTotalDuration();
+        return sum;
+    };
+
+    auto editable = project;
+
+    BENCHMARK("rebuild cache after an edit")
+    {
+        editable.clipsChanged();
+        return editable.getTotalDuration();
+    };
+}
+
+TEST_CASE("Timeline seeks on 10k clips", "[.][benchmark][timeline]")
+{
+    const auto project = createProject();
+    TimelineEventManager manager;
+    manager.buildTimeline(project);
+
+    const auto& timeline = manager.getTimeline();
+    const double duration = project.getTotalDuration();
+
+    // 100 scrub positions spread over the whole project
+    std::vector<double> scrubTimes;
+    for (int i = 0; i < 100; ++i)
+        scrubTimes.push_back(std::fmod(i * 7919.0, duration));
+
+    BENCHMARK("100 scrubs - linear scan")
+    {
+        size_t sum = 0;
+        for (auto time : scrubTimes)
+        {
+            size_t index = 0;
+            while (index < timeline.size() && timeline[index].time < time)
+                ++index;
+            sum += index;
+        }
+        return sum;
+    };
+
+    BENCHMARK("100 scrubs - cursor")
+    {
+        size_t sum = 0;
+        for (auto time : scrubTimes)
+        {
+            manager.seekToTime(time);
+            sum += (size_t) manager.getActiveClipIndex() + (size_t) manager.getActiveWordIndex();
+        }
+        return sum;
+    };
+
+    BENCHMARK("100 scrubs - display state")
+    {
+        size_t sum = 0;
+        for (auto time : scrubTimes)
+        {
+            const auto state = manager.getDisplayStateAt(time);
+            sum += (size_t) state.clipIndex + (size_t) state.wordIndex;
+        }
+        return sum;
+    };
+
+    // Each jump moves the cursor, as the first processEvents() call after it would
+    BENCHMARK("100 jumps of 5 s - cursor")
+    {
+        manager.processEvents(duration / 2, duration / 2);
+        size_t sum = 0;
+        for (int i = 0; i < 100; ++i)
+        {
+            const double time = duration / 2 + (i % 2 == 0 ? 5.0 : -5.0) * (i % 5);
+            manager.processEvents(time, time + 1.0 / 60.0);
+            sum += (size_t) manager.getDisplayStateAt(time).wordIndex;
+        }
+        return sum;
+    };
+}
+
+TEST_CASE("Timeline sweep on 1M events", "[.][benchmark][sweep]")
+{
+    const auto project = createProject(sweepClips);
+    TimelineEventManager manager;
+    manager.buildTimeline(project);
+
+    LegacyTimeline legacy;
+    legacy.events = manager.getTimeline();
+
+    const double duration = project.getTotalDuration();
+    constexpr double frame = 1.0 / 60.0;
+
+    SweepListener state;
+
+    const auto bindCallbacks = [&state](auto& target)
+    {
+        target.onClipStart = [&state](int clip) { state.clipStarted(clip); };
+        target.onClipEnd = [&state](int clip) { state.clipEnded(clip); };
+        target.onWordStart = [&state](int clip, int word) { state.wordStarted(clip, word); };
+        target.onWordEnd = [&state](int clip, int word) { state.wordEnded(clip, word); };
+        target.onHighlightEnd = [&state](int clip, int word) { state.highlightEnded(clip, word); };
+    };
+
+    bindCallbacks(legacy);
+    bindCallbacks(manager);
+
+    BENCHMARK("play through - 24-byte events, std::function")
+    {
+        state = {};
+        legacy.nextEventIndex = 0;
+        for (double time = 0.0; time <= duration + frame; time += frame)
+            legacy.processEvents(time);
+        return state.fired + (size_t) state.wordIndex;
+    };
+
+    BENCHMARK("play through - columns, std::function")
+    {
+        state = {};
+        for (double time = 0.0; time <= duration + frame; time += frame)
+            manager.processEvents(time - frame, time);
+        return state.fired + (size_t) state.wordIndex;
+    };
+
+    BENCHMARK("play through - columns, final listener")
+    {
+        SweepListener listener;
+        for (double time = 0.0; time <= duration + frame; time += frame)
+            manager.processEvents(time - frame, time, listener);
+        return listener.fired + (size_t) listener.wordIndex;
+    };
+
+    // Every event in one call: the cost per event, without the per-frame overhead
+    BENCHMARK("one sweep - 24-byte events, std::function")
+    {
+        state = {};
+        legacy.nextEventIndex = 0;
+        legacy.processEvents(duration + 1.0);
+        return state.fired;
+    };
+
+    BENCHMARK("one sweep - columns, final listener")
+    {
+        SweepListener listener;
+        manager.processEvents(-1.0, duration + 1.0, listener);
+        return listener.fired;
+    };
+}
+
+TEST_CASE("Timeline build of 1M events", "[.][benchmark][build]")
+{
+    const auto project = createProject(sweepClips);
+
+    TimelineEventManager manager;
+
+    BENCHMARK("build - one thread")
+    {
+        manager.setMaxBuildThreads(1);
+        manager.buildTimeline(project);
+        return manager.getNumEvents();
+    };
+
+    BENCHMARK("build - one thread per core")
+    {
+        manager.setMaxBuildThreads(0);
+        manager.buildTimeline(project);
+        return manager.getNumEvents();
+    };
+}
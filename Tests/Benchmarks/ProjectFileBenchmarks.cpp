@@ -0,0 +1,173 @@
+// Project save/load benchmarks (DOM XML vs streaming XML vs binary container).
+// Run with: NarrateBenchmarks "[project-file]"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "../../Source/NarrateDataModel.h"
+#include "../../Source/NarrateBinaryFormat.h"
+#include "../../Source/NarrateXmlReader.h"
+
+#include <fstream>
+#include <iostream>
+
+#if JUCE_LINUX
+ #include <malloc.h>
+#endif
+
+using namespace Narrate;
+
+namespace
+{
+    NarrateProject createLargeProject(int numClips, int wordsPerClip)
+    {
+        static const char* vocabulary[] = { "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog" };
+
+        NarrateProject project;
+        NarrateProject::ClipBatch batch(project, numClips);
+
+        for (int i = 0; i < numClips; ++i)
+        {
+            NarrateClip clip("clip" + juce::String(i), i * 3.0, i * 3.0 + 2.5);
+            clip.reserveWords(wordsPerClip);
+
+            for (int w = 0; w < wordsPerClip; ++w)
+                clip.addWord(NarrateWord(vocabulary[(i + w) % 8], w * 0.25));
+
+            batch.add(std::move(clip));
+        }
+
+        batch.finish();
+        return project;
+    }
+
+   #if JUCE_LINUX
+    // /proc files have no size, so read them with plain streams rather than juce::File
+    juce::int64 readStatusKB(const std::string& field)
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+
+        while (std::getline(status, line))
+            if (line.rfind(field, 0) == 0)
+                return std::stoll(line.substr(field.size()));
+
+        return -1;
+    }
+
+    // Returns freed heap pages to the OS, then resets the kernel's peak RSS counter to the current RSS
+    void resetPeakMemory()
+    {
+        malloc_trim(0);
+        std::ofstream("/proc/self/clear_refs") << "5";
+    }
+
+    juce::int64 getCurrentMemoryKB() { return readStatusKB("VmRSS:"); }
+    juce::int64 getPeakMemoryKB()    { return readStatusKB("VmHWM:"); }
+   #else
+    void resetPeakMemory() {}
+    juce::int64 getCurrentMemoryKB() { return -1; }
+    juce::int64 getPeakMemoryKB()    { return -1; }
+   #endif
+
+    // Peak memory growth (KB) and wall time (ms) of a single load
+    template <typename LoadFunction>
+    void reportLoad(const char* name, LoadFunction&& load)
+    {
+        resetPeakMemory();
+        auto baseline = getCurrentMemoryKB();
+        auto start = juce::Time::getMillisecondCounterHiRes();
+
+        auto numClips = load();
+
+        auto elapsed = juce::Time::getMillisecondCounterHiRes() - start;
+        auto peak = getPeakMemoryKB();
+
+        std::cout << name << ": " << numClips << " clips, " << juce::String(elapsed, 1) << " ms, "
+                  << "peak RSS +" << (baseline >= 0 ? juce::String(peak - baseline) + " KB" : juce::String("n/a")) << "\n";
+    }
+}
+
+TEST_CASE("Project load: XML vs binary", "[.][benchmark][project-file]")
+{
+    auto project = createLargeProject(20000, 10);  // 200k words
+
+    auto tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory);
+    auto xmlFile = tempDir.getChildFile("narrate-bench-xml.narrate");
+    auto binaryFile = tempDir.getChildFile("narrate-bench-bin.narrate");
+
+    REQUIRE(project.saveToFile(xmlFile));
+    REQUIRE(project.saveToBinaryFile(binaryFile));
+
+    BENCHMARK("load XML via DOM (200k words)")
+    {
+        auto xml = juce::XmlDocument::parse(xmlFile);
+        return NarrateProject::fromXml(*xml).getNumClips();
+    };
+
+    BENCHMARK("load XML streaming (200k words)")
+    {
+        NarrateProject loaded;
+        NarrateXmlReader::readFromFile(xmlFile, loaded);
+        return loaded.getNumClips();
+    };
+
+    BENCHMARK("load binary (200k words)")
+    {
+        NarrateProject loaded;
+        loaded.loadFromFile(binaryFile);
+        return loaded.getNumClips();
+    };
+
+    BENCHMARK("open binary view (200k words)")
+    {
+        NarrateBinaryProjectView view(binaryFile);
+        return view.getClipStartTime(view.getNumClips() - 1);
+    };
+
+    BENCHMARK("save binary (200k words)")
+    {
+        return project.saveToBinaryFile(binaryFile);
+    };
+
+    xmlFile.deleteFile();
+    binaryFile.deleteFile();
+}
+
+TEST_CASE("Project load: peak memory", "[.][benchmark][project-file]")
+{
+    auto tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory);
+    auto xmlFile = tempDir.getChildFile("narrate-bench-xml.narrate");
+    auto binaryFile = tempDir.getChildFile("narrate-bench-bin.narrate");
+
+    {
+        auto project = createLargeProject(50000, 10);  // 500k words
+        REQUIRE(project.saveToFile(xmlFile));
+        REQUIRE(project.saveToBinaryFile(binaryFile));
+    }
+
+    std::cout << "XML file: " << (xmlFile.getSize() / 1024) << " KB, binary file: " << (binaryFile.getSize() / 1024) << " KB\n";
+
+    // Each load keeps the project alive until measured, as a real load would
+    reportLoad("XML via DOM", [&]
+    {
+        auto xml = juce::XmlDocument::parse(xmlFile);
+        auto project = NarrateProject::fromXml(*xml);
+        return project.getNumClips();
+    });
+
+    reportLoad("XML streaming", [&]
+    {
+        NarrateProject project;
+        NarrateXmlReader::readFromFile(xmlFile, project);
+        return project.getNumClips();
+    });
+
+    reportLoad("Binary", [&]
+    {
+        NarrateProject project;
+        project.loadFromFile(binaryFile);
+        return project.getNumClips();
+    });
+
+    xmlFile.deleteFile();
+    binaryFile.deleteFile();
+}
@@ -0,0 +1,522 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "../../Source/Features/StandaloneExportFeature.h"
+#include "../../Source/Features/StandaloneImportFeature.h"
+#include "../../Source/Features/ExportWriter.h"
+#include "../../Source/NarrateDataModel.h"
+#include <juce_core/juce_core.h>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+
+/**
+ * Unit tests for Export Feature
+ *
+ * Tests cover:
+ * - SRT, WebVTT and plain text output
+ * - CSV and JSON escaping
+ * - JSON export -> import round-trip
+ * - File and stream exports producing the same bytes
+ * - Multi-format export in one pass
+ * - Clip-level SRT/WebVTT cues
+ * - ExportWriter buffering and write failures
+ * - Timestamp rounding and number formatting
+ */
+
+namespace
+{
+    // Two clips; the times are exact in binary so the timestamps are unambiguous
+    Narrate::NarrateProject createExportProject()
+    {
+        Narrate::NarrateProject project;
+        project.setProjectName("Export \"test\"");
+
+        Narrate::NarrateClip first("clip-1", 1.0, 3.0);
+        first.addWord(Narrate::NarrateWord("Hello", 0.0));
+
+        Narrate::NarrateWord world("world", 0.5);
+        Narrate::TextFormatting bold;
+        bold.bold = true;
+        bold.colour = juce::Colours::red;
+        world.formatting = bold;
+        first.addWord(world);
+
+        Narrate::NarrateClip second("clip-2", 3.5, 4.0);
+        Narrate::NarrateWord special("a<b&c", 0.25);
+        Narrate::TextFormatting italic;
+        italic.italic = true;
+        italic.fontSizeMultiplier = 1.5f;
+        special.formatting = italic;
+        second.addWord(special);
+
+        project.addClip(first);
+        project.addClip(second);
+        return project;
+    }
+
+    template <typename WriteFunction>
+    std::string writeToString(WriteFunction&& writeTo)
+    {
+        juce::MemoryOutputStream stream;
+        {
+            ExportWriter writer(stream);
+            writeTo(writer);
+        }
+        return std::string(static_cast<const char*>(stream.getData()), stream.getDataSize());
+    }
+
+    template <typename ExportFunction>
+    std::string exportToString(ExportFunction&& exportTo)
+    {
+        juce::MemoryOutputStream stream;
+        REQUIRE(exportTo(stream));
+        return std::string(static_cast<const char*>(stream.getData()), stream.getDataSize());
+    }
+
+    // Records the size of every write, optionally failing them all
+    class RecordingOutputStream : public juce::OutputStream
+    {
+    public:
+        explicit RecordingOutputStream(bool shouldFail = false) : fail(shouldFail) {}
+
+        void flush() override {}
+        bool setPosition(juce::int64) override { return false; }
+        juce::int64 getPosition() override { return (juce::int64) data.size(); }
+
+        bool write(const void* source, size_t numBytes) override
+        {
+            largestWrite = juce::jmax(largestWrite, numBytes);
+            ++numWrites;
+
+            if (fail)
+                return false;
+
+            data.append(static_cast<const char*>(source), numBytes);
+            return true;
+        }
+
+        std::string data;
+        size_t largestWrite = 0;
+        int numWrites = 0;
+        bool fail;
+    };
+}
+
+TEST_CASE("ExportFeature - Subtitle and text formats", "[export]")
+{
+    StandaloneExportFeature exporter;
+    const auto project = createExportProject();
+
+    SECTION("SRT has one entry per word")
+    {
+        const auto srt = exportToString([&](juce::OutputStream& s) { return exporter.exportSRT(project, s); });
+
+        REQUIRE(srt == "1\r\n00:00:01,000 --> 00:00:01,500\r\nHello\r\n\r\n"
+                       "2\r\n00:00:01,500 --> 00:00:03,000\r\nworld\r\n\r\n"
+                       "3\r\n00:00:03,750 --> 00:00:04,000\r\na<b&c\r\n\r\n");
+    }
+
+    SECTION("WebVTT escapes text and wraps formatted words in tags")
+    {
+        const auto vtt = exportToString([&](juce::OutputStream& s) { return exporter.exportWebVTT(project, s); });
+
+        REQUIRE(vtt == "WEBVTT\r\n\r\n"
+                       "00:00:01.000 --> 00:00:01.500\r\nHello\r\n\r\n"
+                       "00:00:01.500 --> 00:00:03.000\r\n<c.color_ff0000><b>world</b></c>\r\n\r\n"
+                       "00:00:03.750 --> 00:00:04.000\r\n<i>a&lt;b&amp;c</i>\r\n\r\n");
+    }
+
+    SECTION("Plain text joins the words with spaces")
+    {
+        const auto text = exportToString([&](juce::OutputStream& s) { return exporter.exportPlainText(project, s); });
+        REQUIRE(text == "Hello world a<b&c");
+    }
+
+    SECTION("Empty projects are not exported")
+    {
+        Narrate::NarrateProject empty;
+        juce::MemoryOutputStream stream;
+
+        REQUIRE_FALSE(exporter.exportSRT(empty, stream));
+        REQUIRE_FALSE(exporter.exportJSON(empty, stream));
+        REQUIRE(stream.getDataSize() == 0);
+    }
+}
+
+TEST_CASE("ExportFeature - CSV", "[export][csv]")
+{
+    StandaloneExportFeature exporter;
+    auto project = createExportProject();
+
+    Narrate::NarrateClip quoted("clip,3", 5.0, 6.0);
+    quoted.addWord(Narrate::NarrateWord("say \"hi\"", 0.0));
+    project.addClip(quoted);
+
+    const auto csv = exportToString([&](juce::OutputStream& s) { return exporter.exportCSV(project, s); });
+    auto lines = juce::StringArray::fromLines(juce::String(csv).trimEnd());
+
+    REQUIRE(lines.size() == 5);
+    REQUIRE(lines[0] == "ClipID,StartTime,EndTime,Duration,WordIndex,Word,RelativeTime,AbsoluteTime,Bold,Italic,Colour,FontSizeMultiplier");
+    REQUIRE(lines[1].startsWith("clip-1,"));
+    REQUIRE(lines[2].contains(",world,"));
+    REQUIRE(lines[2].contains(",true,false,ff0000,"));
+    REQUIRE(lines[3].contains(",false,true,ffffff,"));
+    REQUIRE(lines[4].startsWith("\"clip,3\","));
+    REQUIRE(lines[4].contains(",\"say \"\"hi\"\"\","));
+}
+
+TEST_CASE("ExportFeature - JSON round-trip", "[export][json]")
+{
+    StandaloneExportFeature exporter;
+    StandaloneImportFeature importer;
+    auto project = createExportProject();
+
+    // Control characters and quotes must survive as escapes
+    project.getClip(0).getWord(0).text = "Tab\there \"quoted\"\\ \x01";
+
+    juce::File jsonFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+        .getChildFile("test_export_roundtrip.json");
+
+    REQUIRE(exporter.exportJSON(project, jsonFile));
+
+    Narrate::NarrateProject imported;
+    REQUIRE(importer.importJSON(jsonFile, imported));
+
+    REQUIRE(imported.getProjectName() == project.getProjectName());
+    REQUIRE(imported.getNumClips() == project.getNumClips());
+
+    for (int c = 0; c < project.getNumClips(); ++c)
+    {
+        const auto& expectedClip = std::as_const(project).getClip(c);
+        const auto& clip = std::as_const(imported).getClip(c);
+
+        REQUIRE(clip.getId() == expectedClip.getId());
+        REQUIRE(clip.getStartTime() == Catch::Approx(expectedClip.getStartTime()));
+        REQUIRE(clip.getEndTime() == Catch::Approx(expectedClip.getEndTime()));
+        REQUIRE(clip.getDefaultFormatting() == expectedClip.getDefaultFormatting());
+        REQUIRE(clip.getNumWords() == expectedClip.getNumWords());
+
+        for (int w = 0; w < clip.getNumWords(); ++w)
+        {
+            REQUIRE(clip.getWord(w).text == expectedClip.getWord(w).text);
+            REQUIRE(clip.getWord(w).relativeTime == Catch::Approx(expectedClip.getWord(w).relativeTime));
+            REQUIRE(clip.getWord(w).formatting == expectedClip.getWord(w).formatting);
+        }
+    }
+
+    jsonFile.deleteFile();
+}
+
+TEST_CASE("ExportFeature - JSON style table", "[export][json]")
+{
+    StandaloneExportFeature exporter;
+    const auto project = createExportProject();
+
+    const auto json = exportToString([&](juce::OutputStream& s) { return exporter.exportJSON(project, s); });
+    const auto parsed = juce::JSON::parse(juce::String(json));
+
+    // The clips' shared default and the two word styles, each written once in first-use order
+    const auto* styles = parsed["styles"].getArray();
+    REQUIRE(styles != nullptr);
+    REQUIRE(styles->size() == 3);
+    REQUIRE((bool) (*styles)[1]["bold"]);
+    REQUIRE((bool) (*styles)[2]["italic"]);
+
+    const auto& clips = parsed["clips"];
+    REQUIRE((int) clips[0]["defaultStyle"] == 0);
+    REQUIRE((int) clips[1]["defaultStyle"] == 0);
+    REQUIRE((int) clips[0]["words"][1]["style"] == 1);
+    REQUIRE((int) clips[1]["words"][0]["style"] == 2);
+    REQUIRE_FALSE(clips[0]["words"][0].hasProperty("style"));
+}
+
+TEST_CASE("ExportFeature - File and stream exports match", "[export]")
+{
+    StandaloneExportFeature exporter;
+    const auto project = createExportProject();
+
+    juce::File outputFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+        .getChildFile("test_export_stream.srt");
+
+    // Replacing a longer file must not leave its tail behind
+    outputFile.replaceWithText(juce::String::repeatedString("stale ", 1000));
+
+    REQUIRE(exporter.exportSRT(project, outputFile));
+
+    juce::MemoryBlock fileContents;
+    REQUIRE(outputFile.loadFileAsData(fileContents));
+
+    const auto streamed = exportToString([&](juce::OutputStream& s) { return exporter.exportSRT(project, s); });
+    REQUIRE(std::string(static_cast<const char*>(fileContents.getData()), fileContents.getSize()) == streamed);
+
+    // The export is written beside the target and moved over it, leaving nothing behind
+    REQUIRE(outputFile.getParentDirectory().findChildFiles(juce::File::findFiles, false, "test_export_stream_temp*").isEmpty());
+
+    outputFile.deleteFile();
+}
+
+TEST_CASE("ExportFeature - Multi-format export", "[export][multi]")
+{
+    StandaloneExportFeature exporter;
+    const auto project = createExportProject();
+    const auto formats = ExportFeature::getFormatNames();
+
+    // The output of each format on its own
+    std::map<juce::String, std::string> expected;
+    expected["srt"] = exportToString([&](juce::OutputStream& s) { return exporter.exportSRT(project, s); });
+    expected["vtt"] = exportToString([&](juce::OutputStream& s) { return exporter.exportWebVTT(project, s); });
+    expected["txt"] = exportToString([&](juce::OutputStream& s) { return exporter.exportPlainText(project, s); });
+    expected["json"] = exportToString([&](juce::OutputStream& s) { return exporter.exportJSON(project, s); });
+    expected["csv"] = exportToString([&](juce::OutputStream& s) { return exporter.exportCSV(project, s); });
+
+    SECTION("Streams get the same bytes as single exports")
+    {
+        std::vector<std::unique_ptr<juce::MemoryOutputStream>> streams;
+        std::vector<std::pair<juce::String, juce::OutputStream*>> outputs;
+
+        for (const auto& format : formats)
+        {
+            streams.push_back(std::make_unique<juce::MemoryOutputStream>());
+            outputs.emplace_back(format, streams.back().get());
+        }
+
+        REQUIRE(exporter.exportFormats(project, outputs));
+
+        for (size_t i = 0; i < outputs.size(); ++i)
+        {
+            INFO("Format: " << outputs[i].first);
+            REQUIRE(std::string(static_cast<const char*>(streams[i]->getData()), streams[i]->getDataSize()) == expected[outputs[i].first]);
+        }
+    }
+
+    SECTION("Files are written next to each other")
+    {
+        auto base = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("test_export_multi");
+
+        std::vector<ExportTarget> targets;
+        for (const auto& format : formats)
+            targets.push_back({ format, base.withFileExtension(format) });
+
+        REQUIRE(exporter.exportFormats(project, targets));
+
+        for (const auto& target : targets)
+        {
+            INFO("Format: " << target.format);
+            REQUIRE(target.succeeded);
+
+            juce::MemoryBlock contents;
+            REQUIRE(target.file.loadFileAsData(contents));
+            REQUIRE(std::string(static_cast<const char*>(contents.getData()), contents.getSize()) == expected[target.format]);
+
+            target.file.deleteFile();
+        }
+    }
+
+    SECTION("A failing target does not stop the others")
+    {
+        auto tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory);
+
+        // A file where a directory should be makes the CSV target impossible to create
+        auto blocker = tempDir.getChildFile("test_export_blocker");
+        blocker.replaceWithText("not a directory");
+
+        std::vector<ExportTarget> targets {
+            { "srt", tempDir.getChildFile("test_export_partial.srt") },
+            { "docx", tempDir.getChildFile("test_export_partial.docx") },
+            { "csv", blocker.getChildFile("test_export_partial.csv") },
+            { "json", tempDir.getChildFile("test_export_partial.json") }
+        };
+
+        REQUIRE_FALSE(exporter.exportFormats(project, targets));
+
+        REQUIRE(targets[0].succeeded);
+        REQUIRE_FALSE(targets[1].succeeded);
+        REQUIRE_FALSE(targets[1].file.exists());
+        REQUIRE_FALSE(targets[2].succeeded);
+        REQUIRE(targets[3].succeeded);
+        REQUIRE(targets[3].file.getSize() == (juce::int64) expected["json"].size());
+
+        targets[0].file.deleteFile();
+        targets[3].file.deleteFile();
+        blocker.deleteFile();
+    }
+
+    SECTION("Unknown formats are rejected for streams")
+    {
+        juce::MemoryOutputStream stream;
+        REQUIRE_FALSE(exporter.exportFormats(project, { { "docx", &stream } }));
+        REQUIRE(stream.getDataSize() == 0);
+    }
+}
+
+TEST_CASE("ExportFeature - Clip cues", "[export][cues]")
+{
+    StandaloneExportFeature exporter;
+    auto project = createExportProject();
+
+    // Clips without text produce no cue
+    project.addClip(Narrate::NarrateClip("empty", 5.0, 6.0));
+
+    const auto wordJson = exportToString([&](juce::OutputStream& s) { return exporter.exportJSON(project, s); });
+
+    exporter.setCueMode(ExportFeature::CueMode::Clip);
+    REQUIRE(exporter.getCueMode() == ExportFeature::CueMode::Clip);
+
+    SECTION("WebVTT keeps word timing in timestamp tags")
+    {
+        const auto vtt = exportToString([&](juce::OutputStream& s) { return exporter.exportWebVTT(project, s); });
+
+        REQUIRE(vtt == "WEBVTT\r\n\r\n"
+                       "00:00:01.000 --> 00:00:03.000\r\nHello <00:00:01.500><c.color_ff0000><b>world</b></c>\r\n\r\n"
+                       "00:00:03.500 --> 00:00:04.000\r\n<00:00:03.750><i>a&lt;b&amp;c</i>\r\n\r\n");
+    }
+
+    SECTION("SRT has the clip text")
+    {
+        const auto srt = exportToString([&](juce::OutputStream& s) { return exporter.exportSRT(project, s); });
+
+        REQUIRE(srt == "1\r\n00:00:01,000 --> 00:00:03,000\r\nHello world\r\n\r\n"
+                       "2\r\n00:00:03,500 --> 00:00:04,000\r\na<b&c\r\n\r\n");
+    }
+
+    SECTION("Timestamp tags stay inside the cue and increase")
+    {
+        Narrate::NarrateProject overlapping;
+        Narrate::NarrateClip clip("c", 10.0, 11.0);
+        clip.addWord(Narrate::NarrateWord("before", -0.5));   // Before the cue start
+        clip.addWord(Narrate::NarrateWord("inside", 0.5));
+        clip.addWord(Narrate::NarrateWord("backwards", 0.25)); // Earlier than the previous tag
+        clip.addWord(Narrate::NarrateWord("after", 2.0));      // After the cue end
+        overlapping.addClip(clip);
+
+        const auto vtt = exportToString([&](juce::OutputStream& s) { return exporter.exportWebVTT(overlapping, s); });
+        REQUIRE(vtt == "WEBVTT\r\n\r\n00:00:10.000 --> 00:00:11.000\r\nbefore <00:00:10.500>inside backwards after\r\n\r\n");
+    }
+
+    SECTION("Other formats stay per word")
+    {
+        REQUIRE(exportToString([&](juce::OutputStream& s) { return exporter.exportJSON(project, s); }) == wordJson);
+    }
+}
+
+TEST_CASE("ExportWriter buffering", "[export][writer]")
+{
+    SECTION("Output reaches the stream in buffer-sized blocks")
+    {
+        RecordingOutputStream stream;
+        std::string expected;
+
+        {
+            ExportWriter writer(stream, 256);
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                writer.write("word ");
+                writer.writeInt(i);
+                writer.write(',');
+                writer.newLine();
+                expected += "word " + std::to_string(i) + ",\r\n";
+            }
+
+            REQUIRE(writer.flush());
+        }
+
+        REQUIRE(stream.data == expected);
+        REQUIRE(stream.largestWrite <= 256);
+        REQUIRE(stream.numWrites > 1);
+    }
+
+    SECTION("Text larger than the buffer is passed through")
+    {
+        RecordingOutputStream stream;
+        const std::string large(5000, 'x');
+
+        {
+            ExportWriter writer(stream, 256);
+            writer.write("head");
+            writer.write(std::string_view(large));
+            writer.write("tail");
+        }
+
+        REQUIRE(stream.data == "head" + large + "tail");
+    }
+
+    SECTION("Write failures are reported")
+    {
+        RecordingOutputStream failing(true);
+        StandaloneExportFeature exporter;
+
+        REQUIRE_FALSE(exporter.exportSRT(createExportProject(), failing));
+        REQUIRE(failing.numWrites > 0);
+    }
+}
+
+TEST_CASE("ExportWriter formatting", "[export][writer]")
+{
+    auto timestamp = [](double seconds, char separator = ',')
+    {
+        return writeToString([&](ExportWriter& w) { w.writeTimestamp(seconds, separator); });
+    };
+
+    auto number = [](auto value)
+    {
+        return writeToString([&](ExportWriter& w) { w.writeNumber(value); });
+    };
+
+    SECTION("Timestamps round to the nearest millisecond")
+    {
+        REQUIRE(timestamp(0.0) == "00:00:00,000");
+        REQUIRE(timestamp(1.9999) == "00:00:02,000");
+        REQUIRE(timestamp(1.0004) == "00:00:01,000");
+        REQUIRE(timestamp(1.0005, '.') == "00:00:01.001");
+        REQUIRE(timestamp(0.3) == "00:00:00,300");          // 0.3 * 1000 is 299.99999999999997
+        REQUIRE(timestamp(59.9996) == "00:01:00,000");      // Carries into the minutes
+        REQUIRE(timestamp(3723.456) == "01:02:03,456");
+        REQUIRE(timestamp(100 * 3600.0 + 1.5) == "100:00:01,500");
+        REQUIRE(timestamp(-2.0) == "00:00:00,000");
+    }
+
+    SECTION("Numbers are written in their shortest exact form")
+    {
+        REQUIRE(number(0.0) == "0.0");
+        REQUIRE(number(-0.0) == "0.0");
+        REQUIRE(number(1.0) == "1.0");
+        REQUIRE(number(2.5) == "2.5");
+        REQUIRE(number(0.1) == "0.1");
+        REQUIRE(number(-12.75) == "-12.75");
+        REQUIRE(number(123456.0) == "123456.0");
+        REQUIRE(number(1.5f) == "1.5");
+        REQUIRE(number(0.1f) == "0.1");
+        REQUIRE(number(std::numeric_limits<double>::quiet_NaN()) == "0.0");
+        REQUIRE(number(std::numeric_limits<double>::infinity()) == "0.0");
+    }
+
+    SECTION("Numbers read back exactly")
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<double> times(0.0, 100000.0);
+
+        for (int i = 0; i < 10000; ++i)
+        {
+            const double value = times(random);
+            const auto text = number(value);
+            REQUIRE(std::strtod(text.c_str(), nullptr) == value);
+        }
+    }
+
+    SECTION("Exports are reproducible")
+    {
+        StandaloneExportFeature exporter;
+        auto project = createExportProject();
+        project.getClip(1).setEndTime(1.0 / 3.0 + 4.0);
+
+        const auto first = exportToString([&](juce::OutputStream& s) { return exporter.exportJSON(project, s); });
+        const auto second = exportToString([&](juce::OutputStream& s) { return exporter.exportJSON(project, s); });
+
+        REQUIRE(first == second);
+        REQUIRE(first.find("\"endTime\": 4.333333333333333,") != std::string::npos);
+    }
+}
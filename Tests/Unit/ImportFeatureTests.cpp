@@ -1,7 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
 #include "../../Source/Features/StandaloneImportFeature.h"
 #include "../../Source/NarrateDataModel.h"
 #include <juce_core/juce_core.h>
+#include <thread>
+#include <utility>
 
 /**
  * Unit tests for Import Feature
@@ -88,7 +91,7 @@ TEST_CASE("ImportFeature - SRT Format", "[import][srt]")
 
         // Multi-line text should be combined with spaces
         auto& clip = project.getClip(0);
-        REQUIRE(clip.getNumWords() == 7);  // "This is line one This is line two"
+        REQUIRE(clip.getNumWords() == 8);  // "This is line one This is line two"
 
         tempFile.deleteFile();
     }
@@ -352,6 +355,152 @@ TEST_CASE("ImportFeature - JSON Format", "[import][json]")
         REQUIRE(clip.getStartTime() == 1.0);
         REQUIRE(clip.getDuration() == 2.5);
         REQUIRE(clip.getNumWords() == 2);
+        REQUIRE(clip.getWord(1).relativeTime == 0.5);
+
+        tempFile.deleteFile();
+    }
+
+    SECTION("Import the schema exportJSON writes")
+    {
+        juce::File tempFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+            .getChildFile("test_import_export_schema.json");
+
+        juce::String jsonContent = R"({
+  "projectName": "Exported \"Project\"",
+  "totalDuration": 6.25,
+  "styles": [
+    {
+      "bold": false,
+      "italic": false,
+      "colour": "FFFFFF",
+      "fontSizeMultiplier": 1.0
+    },
+    {
+      "bold": true,
+      "italic": false,
+      "colour": "FF5733",
+      "fontSizeMultiplier": 1.5
+    }
+  ],
+  "clips": [
+    {
+      "id": "clip-2",
+      "startTime": 4.0,
+      "endTime": 6.25,
+      "duration": 2.25,
+      "defaultStyle": 1,
+      "words": [
+        {
+          "text": "Later",
+          "relativeTime": 0.75,
+          "absoluteTime": 4.75
+        }
+      ]
+    },
+    {
+      "id": "clip-1",
+      "startTime": 1.0,
+      "endTime": 3.5,
+      "duration": 2.5,
+      "defaultStyle": 0,
+      "words": [
+        {
+          "text": "Caf\u00e9",
+          "relativeTime": 0.0,
+          "absoluteTime": 1.0
+        },
+        {
+          "text": "ol\u00e9",
+          "relativeTime": 1.25,
+          "absoluteTime": 2.25,
+          "style": 1
+        }
+      ]
+    }
+  ]
+})";
+
+        tempFile.replaceWithText(jsonContent);
+
+        REQUIRE(importer.importJSON(tempFile, project));
+        REQUIRE(project.getProjectName() == "Exported \"Project\"");
+        REQUIRE(project.getNumClips() == 2);
+
+        // Clips come back in start-time order, with their ids
+        const auto& first = std::as_const(project).getClip(0);
+        REQUIRE(first.getId() == "clip-1");
+        REQUIRE(first.getStartTime() == 1.0);
+        REQUIRE(first.getEndTime() == 3.5);
+        REQUIRE(first.getNumWords() == 2);
+        REQUIRE(first.getWord(0).text == juce::String(juce::CharPointer_UTF8("Caf\xc3\xa9")));
+        REQUIRE_FALSE(first.getWord(0).formatting.has_value());
+        REQUIRE(first.getWord(1).relativeTime == 1.25);
+        REQUIRE(first.getWord(1).formatting.has_value());
+        REQUIRE(first.getWord(1).formatting->bold);
+        REQUIRE(first.getWord(1).formatting->colour == juce::Colour(0xffff5733));
+        REQUIRE(first.getWord(1).formatting->fontSizeMultiplier == 1.5f);
+
+        const auto& second = std::as_const(project).getClip(1);
+        REQUIRE(second.getId() == "clip-2");
+        REQUIRE(second.getEndTime() == 6.25);
+        REQUIRE(second.getDefaultFormatting().bold);
+        REQUIRE(second.getWord(0).relativeTime == 0.75);
+
+        tempFile.deleteFile();
+    }
+
+    SECTION("Word times from absoluteTime when relativeTime is missing")
+    {
+        juce::File tempFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+            .getChildFile("test_import_absolute.json");
+
+        tempFile.replaceWithText(R"({"projectName": "Abs", "clips": [
+            {"startTime": 2.0, "duration": 1.0, "futureKey": {"nested": [1, 2]},
+             "words": [{"text": "One", "absoluteTime": 2.5}]}]})");
+
+        REQUIRE(importer.importJSON(tempFile, project));
+        REQUIRE(std::as_const(project).getClip(0).getWord(0).relativeTime == 0.5);
+        REQUIRE(std::as_const(project).getClip(0).getEndTime() == 3.0);
+
+        tempFile.deleteFile();
+    }
+
+    SECTION("Style indices that aren't whole numbers in range are ignored")
+    {
+        juce::File tempFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+            .getChildFile("test_import_bad_styles.json");
+
+        tempFile.replaceWithText(R"({"projectName": "Styles",
+            "styles": [{"bold": false}, {"bold": true}],
+            "clips": [{"startTime": 0.0, "endTime": 5.0, "defaultStyle": 1e300,
+             "words": [{"text": "a", "relativeTime": 0.0, "style": 1.5},
+                       {"text": "b", "relativeTime": 1.0, "style": 4294967297},
+                       {"text": "c", "relativeTime": 2.0, "style": -1},
+                       {"text": "d", "relativeTime": 3.0, "style": 1.0}]}]})");
+
+        REQUIRE(importer.importJSON(tempFile, project));
+
+        const auto& clip = std::as_const(project).getClip(0);
+        REQUIRE_FALSE(clip.getDefaultFormatting().bold);
+        REQUIRE_FALSE(clip.getWord(0).formatting.has_value());
+        REQUIRE_FALSE(clip.getWord(1).formatting.has_value());
+        REQUIRE_FALSE(clip.getWord(2).formatting.has_value());
+        REQUIRE(clip.getWord(3).formatting.has_value());
+        REQUIRE(clip.getWord(3).formatting->bold);
+
+        tempFile.deleteFile();
+    }
+
+    SECTION("A file that breaks off leaves the project untouched")
+    {
+        juce::File tempFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+            .getChildFile("test_truncated.json");
+
+        project.setProjectName("Unchanged");
+        tempFile.replaceWithText(R"({"projectName": "New", "clips": [{"startTime": 1.0, "words": [{"text": "Cut)");
+
+        REQUIRE_FALSE(importer.importJSON(tempFile, project));
+        REQUIRE(project.getProjectName() == "Unchanged");
 
         tempFile.deleteFile();
     }
@@ -448,6 +597,160 @@ TEST_CASE("ImportFeature - Format Detection", "[import][detection]")
 
         tempFile.deleteFile();
     }
+
+    SECTION("Detect through byte order marks")
+    {
+        juce::File tempFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+            .getChildFile("test_bom.srt");
+
+        const std::string withBom = "\xEF\xBB\xBF" "1\r\n00:00:01,000 --> 00:00:03,500\r\nText\r\n";
+        tempFile.replaceWithData(withBom.data(), withBom.size());
+        REQUIRE(importer.detectFormat(tempFile, detectedFormat));
+        REQUIRE(detectedFormat == "srt");
+
+        // UTF-16 LE "WEBVTT\n\n00:01.000 --> 00:02.000\nHi\n"
+        std::string utf16 = "\xFF\xFE";
+        for (char c : std::string("WEBVTT\n\n00:01.000 --> 00:02.000\nHi\n"))
+        {
+            utf16 += c;
+            utf16 += '\0';
+        }
+
+        tempFile.replaceWithData(utf16.data(), utf16.size());
+        REQUIRE(importer.detectFormat(tempFile, detectedFormat));
+        REQUIRE(detectedFormat == "vtt");
+
+        Narrate::NarrateProject project;
+        REQUIRE(importer.importWebVTT(tempFile, project));
+        REQUIRE(project.getNumClips() == 1);
+        REQUIRE(std::as_const(project).getClip(0).getFullText() == "Hi");
+
+        tempFile.deleteFile();
+    }
+
+    SECTION("Only the first few KB are needed")
+    {
+        // Detection must not depend on anything past the prefix
+        REQUIRE(TextImportSource::detectFormat("1\n00:00:01,000 --> 00:00:02,000\n") == "srt");
+        REQUIRE(TextImportSource::detectFormat("\n\n  { \"projectName\": \"x\"") == "json");
+        REQUIRE(TextImportSource::detectFormat("{ \"something\": 1 }") == "txt");
+        REQUIRE(TextImportSource::detectFormat("1\nnot a timecode\n") == "txt");
+        REQUIRE(TextImportSource::detectFormat("\nno index\n00:00:01,000 --> 00:00:02,000\n") == "txt");
+    }
+
+    SECTION("The handle from detection imports without reopening the file")
+    {
+        juce::File tempFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+            .getChildFile("test_handle.srt");
+
+        juce::String srtContent;
+        for (int i = 0; i < 500; ++i)
+            srtContent << (i + 1) << "\n00:00:" << juce::String(i % 60).paddedLeft('0', 2) << ",000 --> 00:00:59,000\nCue " << i << "\n\n";
+
+        tempFile.replaceWithText(srtContent);
+        REQUIRE(tempFile.getSize() > (juce::int64) TextImportSource::detectionPrefixSize);
+
+        auto source = importer.openForImport(tempFile);
+        REQUIRE(source != nullptr);
+        REQUIRE(source->getFormat() == "srt");
+
+        // The open handle keeps reading after the file is gone from the directory (POSIX)
+        tempFile.deleteFile();
+
+        Narrate::NarrateProject project;
+        REQUIRE(importer.importFromSource(*source, project));
+        REQUIRE(project.getNumClips() == 500);
+    }
+
+    SECTION("Mapped files import like streams")
+    {
+        juce::File tempFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+            .getChildFile("test_mapped.srt");
+
+        // Zero-width spaces in some cues make the mapped window go through the sanitizing copy
+        std::string srtContent = "\xEF\xBB\xBF";
+        for (int i = 0; i < 2000; ++i)
+            srtContent += std::to_string(i + 1) + "\r\n00:00:01,000 --> 00:00:02,000\r\nCue" + (i % 300 == 0 ? "\xE2\x80\x8B" : "")
+                        + " " + std::to_string(i) + "\r\n\r\n";
+
+        tempFile.replaceWithData(srtContent.data(), srtContent.size());
+
+        auto mapped = TextImportSource::open(tempFile);
+        REQUIRE(mapped != nullptr);
+        REQUIRE(mapped->isMapped());
+        REQUIRE(mapped->getFormat() == "srt");
+
+        auto streamed = TextImportSource::open(tempFile.createInputStream(), {}, tempFile);
+        REQUIRE(streamed != nullptr);
+        REQUIRE_FALSE(streamed->isMapped());
+
+        Narrate::NarrateProject fromMapping, fromStream;
+        REQUIRE(importer.importFromSource(*mapped, fromMapping));
+        REQUIRE(importer.importFromSource(*streamed, fromStream));
+
+        REQUIRE(fromMapping.getNumClips() == 2000);
+        REQUIRE(fromStream.getNumClips() == 2000);
+        for (int i = 0; i < 2000; i += 150)
+            REQUIRE(std::as_const(fromMapping).getClip(i).getFullText() == std::as_const(fromStream).getClip(i).getFullText());
+
+        tempFile.deleteFile();
+    }
+
+    SECTION("Streams without a known length import like files")
+    {
+        // A pipe: one byte per read, no length, no seeking back
+        struct PipeStream : juce::InputStream
+        {
+            explicit PipeStream(std::string bytes) : data(std::move(bytes)) {}
+            juce::int64 getTotalLength() override { return -1; }
+            juce::int64 getPosition() override { return (juce::int64) position; }
+            bool isExhausted() override { return position >= data.size(); }
+            bool setPosition(juce::int64) override { return false; }
+            int read(void* dest, int maxBytes) override
+            {
+                if (maxBytes <= 0 || position >= data.size())
+                    return 0;
+                static_cast<char*>(dest)[0] = data[position++];
+                return 1;
+            }
+
+            std::string data;
+            size_t position = 0;
+        };
+
+        std::string srtContent;
+        for (int i = 0; i < 500; ++i)
+            srtContent += std::to_string(i + 1) + "\n00:00:01,000 --> 00:00:02,000\nCue " + std::to_string(i) + "\n\n";
+
+        auto source = importer.openForImport(std::make_unique<PipeStream>(srtContent));
+        REQUIRE(source != nullptr);
+        REQUIRE(source->getFormat() == "srt");
+
+        Narrate::NarrateProject project;
+        REQUIRE(importer.importFromSource(*source, project));
+        REQUIRE(project.getNumClips() == 500);
+
+        // The format can be given instead of detected
+        auto asText = importer.openForImport(std::make_unique<PipeStream>(srtContent), "txt");
+        REQUIRE(asText != nullptr);
+        REQUIRE(asText->getFormat() == "txt");
+
+        REQUIRE(importer.openForImport(std::make_unique<PipeStream>(srtContent), "doc") == nullptr);
+        REQUIRE(importer.openForImport(std::make_unique<PipeStream>("")) == nullptr);
+    }
+
+    SECTION("Missing and empty files can't be opened")
+    {
+        juce::File tempFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+            .getChildFile("test_empty_detect.txt");
+
+        tempFile.replaceWithText("");
+        REQUIRE(importer.openForImport(tempFile) == nullptr);
+        REQUIRE_FALSE(importer.detectFormat(tempFile, detectedFormat));
+
+        tempFile.deleteFile();
+        REQUIRE(importer.openForImport(tempFile) == nullptr);
+    }
 }
 
 TEST_CASE("ImportFeature - Timecode Parsing", "[import][timecode]")
@@ -517,3 +820,85 @@ TEST_CASE("ImportFeature - Round-trip Conversion", "[import][export][integration
         jsonFile.deleteFile();
     }
 }
+
+TEST_CASE("ImportFeature - Parallel SRT import", "[import][srt][parallel]")
+{
+    juce::File tempFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+        .getChildFile("test_parallel.srt");
+
+    // Large enough to take the parallel path, with a few cues out of order and some malformed blocks
+    juce::String srtContent;
+    for (int i = 0; i < 20000; ++i)
+    {
+        int startMs = (i % 997 == 0) ? (20000 - i) * 1000 : i * 1000;
+        auto timecode = [](int ms)
+        {
+            return juce::String::formatted("%02d:%02d:%02d,%03d", ms / 3600000, (ms / 60000) % 60, (ms / 1000) % 60, ms % 1000);
+        };
+
+        srtContent << (i + 1) << "\n";
+        if (i % 1499 == 0)
+            srtContent << "not a timecode\n";
+        else
+            srtContent << timecode(startMs) << " --> " << timecode(startMs + 800) << "\n";
+        srtContent << "Cue number " << i << " with some words\n\n";
+    }
+
+    tempFile.replaceWithText(srtContent);
+    REQUIRE(tempFile.getSize() >= (juce::int64) StandaloneImportFeature::parallelImportMinBytes);
+
+    StandaloneImportFeature sequentialImporter;
+    sequentialImporter.setMaxImportThreads(1);
+    Narrate::NarrateProject expected;
+    REQUIRE(sequentialImporter.importSRT(tempFile, expected));
+
+    SECTION("Same clips in the same order as a single-threaded import")
+    {
+        for (int numThreads : { 2, 3, 8 })
+        {
+            StandaloneImportFeature importer;
+            importer.setMaxImportThreads(numThreads);
+            Narrate::NarrateProject project;
+            REQUIRE(importer.importSRT(tempFile, project));
+
+            REQUIRE(project.getNumClips() == expected.getNumClips());
+            REQUIRE(project.getTotalNumWords() == expected.getTotalNumWords());
+
+            for (int c = 0; c < project.getNumClips(); ++c)
+            {
+                const auto& clip = std::as_const(project).getClip(c);
+                const auto& expectedClip = std::as_const(expected).getClip(c);
+                REQUIRE(clip.getStartTime() == expectedClip.getStartTime());
+                REQUIRE(clip.getEndTime() == expectedClip.getEndTime());
+                REQUIRE(clip.getFullText() == expectedClip.getFullText());
+            }
+        }
+    }
+
+    SECTION("Progress stays on the calling thread and cancellation stops the import")
+    {
+        StandaloneImportFeature importer;
+        importer.setMaxImportThreads(4);
+        Narrate::NarrateProject project;
+        project.setProjectName("Unchanged");
+
+        const auto callingThread = std::this_thread::get_id();
+        bool sameThread = true;
+        int numCalls = 0;
+
+        bool result = importer.importSRT(tempFile, project, [&](double, const juce::String&)
+        {
+            sameThread = sameThread && std::this_thread::get_id() == callingThread;
+            return ++numCalls < 3;
+        });
+
+        REQUIRE(result == false);
+        REQUIRE(sameThread);
+
+        // The clips parsed before the cancel never reach the caller's project
+        REQUIRE(project.getProjectName() == "Unchanged");
+        REQUIRE(project.getNumClips() == 0);
+    }
+
+    tempFile.deleteFile();
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../../Source/Features/JsonPullParser.h"
+#include <cstdio>
+
+namespace
+{
+    using Token = JsonPullParser::Token;
+
+    // Every token of a document as text, e.g. "{ key:a 1 }"
+    std::string describe(const std::string& json, size_t bufferSize = 64 * 1024)
+    {
+        juce::MemoryInputStream stream(json.data(), json.size(), false);
+        JsonPullParser parser(stream, bufferSize);
+        std::string result;
+
+        for (;;)
+        {
+            auto token = parser.next();
+            std::string text;
+
+            switch (token)
+            {
+                case Token::BeginObject:   text = "{"; break;
+                case Token::EndObject:     text = "}"; break;
+                case Token::BeginArray:    text = "["; break;
+                case Token::EndArray:      text = "]"; break;
+                case Token::Key:           text = "key:" + parser.getString(); break;
+                case Token::String:        text = "'" + parser.getString() + "'"; break;
+                case Token::Number:
+                {
+                    char number[32];
+                    std::snprintf(number, sizeof(number), "%g", parser.getNumber());
+                    text = number;
+                    break;
+                }
+                case Token::True:          text = "true"; break;
+                case Token::False:         text = "false"; break;
+                case Token::Null:          text = "null"; break;
+                case Token::EndOfDocument: return result;
+                case Token::Error:         return result + (result.empty() ? "" : " ") + "error";
+            }
+
+            result += (result.empty() ? "" : " ") + text;
+        }
+    }
+}
+
+TEST_CASE("JsonPullParser tokens", "[json]")
+{
+    SECTION("Objects, arrays and scalars")
+    {
+        REQUIRE(describe(R"({"a": 1, "b": [true, false, null], "c": {}, "d": []})")
+                == "{ key:a 1 key:b [ true false null ] key:c { } key:d [ ] }");
+        REQUIRE(describe(" [ -0.5, 1e3, 2E-2, 12345678901234567 ] ") == "[ -0.5 1000 0.02 1.23457e+16 ]");
+        REQUIRE(describe("\"top\"") == "'top'");
+        REQUIRE(describe("\xEF\xBB\xBF{}") == "{ }");
+    }
+
+    SECTION("String escapes decode to UTF-8")
+    {
+        REQUIRE(describe(R"(["a\"b\\c\/d\n\t", "\u00e9\u20ac", "\ud83c\udfa4", "\udc00x"])")
+                == "[ 'a\"b\\c/d\n\t' '\xC3\xA9\xE2\x82\xAC' '\xF0\x9F\x8E\xA4' '\xEF\xBF\xBDx' ]");
+    }
+
+    SECTION("Tokens that straddle the buffer give the same result")
+    {
+        std::string json = R"({"projectName": "A \"long\" name \u00e9", "values": [1.25, -3, true, null, "x"]})";
+        auto expected = describe(json);
+
+        for (size_t bufferSize = 4; bufferSize < 16; ++bufferSize)
+            REQUIRE(describe(json, bufferSize) == expected);
+    }
+
+    SECTION("Malformed documents stop with an error")
+    {
+        REQUIRE(describe("{ invalid json }") == "{ error");
+        REQUIRE(describe("[1, 2,]") == "[ 1 2 error");
+        REQUIRE(describe(R"({"a": 1,})") == "{ key:a 1 error");
+        REQUIRE(describe(R"({"a" 1})") == "{ error");
+        REQUIRE(describe("[1 2]") == "[ 1 error");
+        REQUIRE(describe("[1}") == "[ 1 error");
+        REQUIRE(describe("[01]") == "[ error");
+        REQUIRE(describe("[\"open") == "[ error");
+        REQUIRE(describe("[\"tab\tinside\"]") == "[ error");
+        REQUIRE(describe("[tru]") == "[ error");
+        REQUIRE(describe("{} {}") == "{ } error");
+        REQUIRE(describe("[") == "[ error");
+        REQUIRE(describe("") == "error");
+    }
+}
+
+TEST_CASE("JsonPullParser skipValue", "[json]")
+{
+    std::string json = R"({"skip": {"nested": [1, {"deep": [[]]}], "s": "}"}, "keep": 7})";
+    juce::MemoryInputStream stream(json.data(), json.size(), false);
+    JsonPullParser parser(stream, 8);
+
+    REQUIRE(parser.next() == Token::BeginObject);
+    REQUIRE(parser.next() == Token::Key);
+    REQUIRE(parser.getString() == "skip");
+    REQUIRE(parser.skipValue(parser.next()));
+    REQUIRE(parser.getDepth() == 1);
+
+    REQUIRE(parser.next() == Token::Key);
+    REQUIRE(parser.isString("keep"));
+    REQUIRE(parser.next() == Token::Number);
+    REQUIRE(parser.getNumber() == 7.0);
+    REQUIRE(parser.next() == Token::EndObject);
+    REQUIRE(parser.next() == Token::EndOfDocument);
+    REQUIRE(parser.getPosition() == (juce::int64) json.size());
+}
@@ -0,0 +1,190 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "../../Source/NarrateBinaryFormat.h"
+
+using namespace Narrate;
+
+namespace
+{
+    NarrateProject createTestProject()
+    {
+        NarrateProject project;
+        project.setProjectName("Binary Test");
+        project.setDefaultFontSize(30.0f);
+        project.setDefaultTextColour(juce::Colours::lightgrey);
+        project.setHighlightColour(juce::Colours::orange);
+        project.setRenderStrategy(NarrateProject::RenderStrategy::Teleprompter);
+
+        NarrateClip clip1("clip1", 0.0, 2.5);
+        clip1.addWord(NarrateWord("Hello", 0.0));
+        clip1.addWord(NarrateWord("world", 0.75));
+
+        NarrateClip clip2("clip2", 3.0, 6.0);
+        TextFormatting clipFormatting;
+        clipFormatting.colour = juce::Colours::cyan;
+        clipFormatting.italic = true;
+        clip2.setDefaultFormatting(clipFormatting);
+
+        NarrateWord bold("bold", 0.5);
+        TextFormatting wordFormatting;
+        wordFormatting.bold = true;
+        wordFormatting.fontSizeMultiplier = 1.5f;
+        bold.formatting = wordFormatting;
+
+        clip2.addWord(NarrateWord("Hello", 0.0));  // Repeated text shares one pool entry
+        clip2.addWord(bold);
+        clip2.addWord(NarrateWord(juce::String::fromUTF8("caf\xc3\xa9"), 1.25));
+
+        project.addClip(clip1);
+        project.addClip(clip2);
+        project.addClip(NarrateClip("empty", 7.0, 8.0));
+        return project;
+    }
+
+    juce::MemoryBlock writeToMemory(const NarrateProject& project)
+    {
+        juce::MemoryBlock block;
+        {
+            juce::MemoryOutputStream stream(block, false);
+            REQUIRE(NarrateBinaryFormat::write(project, stream));
+        }
+        return block;
+    }
+}
+
+TEST_CASE("NarrateBinaryFormat", "[binary-format]")
+{
+    auto original = createTestProject();
+    auto block = writeToMemory(original);
+
+    SECTION("Data starts with the binary signature")
+    {
+        REQUIRE(NarrateBinaryFormat::isBinaryProject(block.getData(), block.getSize()));
+
+        juce::String xmlText("<NarrateProject version=\"1.0\"/>");
+        REQUIRE(!NarrateBinaryFormat::isBinaryProject(xmlText.toRawUTF8(), xmlText.getNumBytesAsUTF8()));
+    }
+
+    SECTION("Sections are 8-byte aligned")
+    {
+        const auto* bytes = static_cast<const juce::uint8*>(block.getData());
+        for (size_t field = 32; field < 72; field += 8)
+            REQUIRE(juce::ByteOrder::littleEndianInt64(bytes + field) % 8 == 0);
+
+        NarrateBinaryProjectView view(block.getData(), block.getSize());
+        REQUIRE(view.isValid());
+        REQUIRE(view.getVersion() == NarrateBinaryFormat::currentVersion);
+    }
+
+    SECTION("Round-trip preserves project settings")
+    {
+        NarrateProject loaded;
+        REQUIRE(NarrateBinaryFormat::read(block.getData(), block.getSize(), loaded));
+
+        REQUIRE(loaded.getProjectName() == "Binary Test");
+        REQUIRE_THAT(loaded.getDefaultFontSize(), Catch::Matchers::WithinRel(30.0f, 0.001f));
+        REQUIRE(loaded.getDefaultTextColour() == juce::Colours::lightgrey);
+        REQUIRE(loaded.getHighlightColour() == juce::Colours::orange);
+        REQUIRE(loaded.getRenderStrategy() == NarrateProject::RenderStrategy::Teleprompter);
+    }
+
+    SECTION("Round-trip preserves clips, words and formatting")
+    {
+        NarrateProject loaded;
+        REQUIRE(NarrateBinaryFormat::read(block.getData(), block.getSize(), loaded));
+        REQUIRE(loaded.getNumClips() == 3);
+
+        const auto& clip1 = loaded.getClip(0);
+        REQUIRE(clip1.getId() == "clip1");
+        REQUIRE(clip1.getNumWords() == 2);
+        REQUIRE(clip1.getWord(1).text == "world");
+        REQUIRE_THAT(clip1.getWord(1).relativeTime, Catch::Matchers::WithinAbs(0.75, 1e-12));
+        REQUIRE(!clip1.getWord(1).formatting.has_value());
+
+        const auto& clip2 = loaded.getClip(1);
+        REQUIRE_THAT(clip2.getStartTime(), Catch::Matchers::WithinAbs(3.0, 1e-12));
+        REQUIRE_THAT(clip2.getEndTime(), Catch::Matchers::WithinAbs(6.0, 1e-12));
+        REQUIRE(clip2.getDefaultFormatting().colour == juce::Colours::cyan);
+        REQUIRE(clip2.getDefaultFormatting().italic);
+        REQUIRE(clip2.getWord(0).text == "Hello");
+        REQUIRE(clip2.getWord(1).formatting.has_value());
+        REQUIRE(clip2.getWord(1).formatting->bold);
+        REQUIRE_THAT(clip2.getWord(1).formatting->fontSizeMultiplier, Catch::Matchers::WithinRel(1.5f, 0.001f));
+        REQUIRE(clip2.getWord(2).text == juce::String::fromUTF8("caf\xc3\xa9"));
+
+        REQUIRE(loaded.getClip(2).getId() == "empty");
+        REQUIRE(loaded.getClip(2).getNumWords() == 0);
+    }
+
+    SECTION("View reads clips and words lazily")
+    {
+        NarrateBinaryProjectView view(block.getData(), block.getSize());
+        REQUIRE(view.isValid());
+        REQUIRE(view.getNumClips() == 3);
+        REQUIRE(view.getNumWords() == 5);
+        REQUIRE(view.getNumStyles() == 3);  // Plain default, clip2 default, bold word
+
+        REQUIRE(view.getClipId(1) == "clip2");
+        REQUIRE(view.getClipFirstWord(1) == 2);
+        REQUIRE(view.getClipNumWords(1) == 3);
+        REQUIRE(view.getWordText(3) == "bold");
+        REQUIRE_THAT(view.getWordRelativeTime(4), Catch::Matchers::WithinAbs(1.25, 1e-12));
+        REQUIRE(view.getWordStyleIndex(0) == NarrateBinaryFormat::noStyle);
+    }
+
+    SECTION("Truncated data is rejected")
+    {
+        NarrateBinaryProjectView view(block.getData(), block.getSize() - 4);
+        REQUIRE(!view.isValid());
+
+        NarrateProject loaded;
+        REQUIRE(!NarrateBinaryFormat::read(block.getData(), 64, loaded));
+    }
+
+    SECTION("Newer versions are rejected")
+    {
+        auto* bytes = static_cast<juce::uint8*>(block.getData());
+        bytes[8] = (juce::uint8) (NarrateBinaryFormat::currentVersion + 1);
+
+        NarrateBinaryProjectView view(block.getData(), block.getSize());
+        REQUIRE(!view.isValid());
+    }
+}
+
+TEST_CASE("NarrateProject binary files", "[binary-format][project]")
+{
+    auto file = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                    .getChildFile("narrate-binary-test.narrate");
+
+    auto original = createTestProject();
+    REQUIRE(original.saveToBinaryFile(file));
+    REQUIRE(NarrateBinaryFormat::isBinaryProjectFile(file));
+
+    SECTION("loadFromFile detects the binary container")
+    {
+        NarrateProject loaded;
+        REQUIRE(loaded.loadFromFile(file));
+        REQUIRE(loaded.getNumClips() == 3);
+        REQUIRE(loaded.getClip(1).getWord(1).text == "bold");
+    }
+
+    SECTION("Memory-mapped view")
+    {
+        NarrateBinaryProjectView view(file);
+        REQUIRE(view.isValid());
+        REQUIRE(view.getProjectName() == "Binary Test");
+        REQUIRE(view.getClip(0).getFullText() == "Hello world");
+    }
+
+    SECTION("XML files are still loaded as XML")
+    {
+        REQUIRE(original.saveToFile(file));
+        REQUIRE(!NarrateBinaryFormat::isBinaryProjectFile(file));
+
+        NarrateProject loaded;
+        REQUIRE(loaded.loadFromFile(file));
+        REQUIRE(loaded.getNumClips() == 3);
+    }
+
+    file.deleteFile();
+}
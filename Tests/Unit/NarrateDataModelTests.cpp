@@ -35,6 +35,40 @@ TEST_CASE("TextFormatting", "[data-model][formatting]")
     }
 }
 
+TEST_CASE("FormattingPalette", "[data-model][formatting][palette]")
+{
+    TextFormatting bold;
+    bold.bold = true;
+
+    TextFormatting red;
+    red.colour = juce::Colours::red;
+
+    SECTION("Equal styles share an index")
+    {
+        FormattingPalette palette;
+        REQUIRE(palette.add(bold) == 0);
+        REQUIRE(palette.add(red) == 1);
+        REQUIRE(palette.add(bold) == 0);
+        REQUIRE(palette.size() == 2);
+        REQUIRE(palette.indexOf(red) == 1);
+        REQUIRE(palette.indexOf(TextFormatting()) == -1);
+        REQUIRE(palette[1] == red);
+    }
+
+    SECTION("XML round-trip keeps positions, including duplicates")
+    {
+        FormattingPalette palette;
+        palette.append(bold);
+        palette.append(red);
+        palette.append(bold);
+
+        auto restored = FormattingPalette::fromXml(*palette.toXml());
+        REQUIRE(restored.size() == 3);
+        REQUIRE(restored[2] == bold);
+        REQUIRE(restored.indexOf(bold) == 0);
+    }
+}
+
 TEST_CASE("NarrateWord", "[data-model][word]")
 {
     SECTION("Construction")
@@ -168,6 +202,33 @@ TEST_CASE("NarrateClip", "[data-model][clip]")
         REQUIRE(restored.getNumWords() == original.getNumWords());
         REQUIRE(restored.getDefaultFormatting().bold == true);
     }
+
+    SECTION("XML with a palette stores style indices")
+    {
+        NarrateClip original("clip1", 1.0, 5.0);
+        NarrateWord styled("Hello", 0.5);
+        TextFormatting italic;
+        italic.italic = true;
+        styled.formatting = italic;
+        original.addWord(styled);
+        original.addWord(NarrateWord("World", 1.5));
+
+        FormattingPalette palette;
+        palette.add(original.getDefaultFormatting());
+        palette.add(italic);
+
+        auto xml = original.toXml(&palette);
+        REQUIRE(xml->getIntAttribute("defaultStyle", -1) == 0);
+        REQUIRE(xml->getChildByName("DefaultFormatting") == nullptr);
+
+        auto* wordXml = xml->getChildByName("Words")->getChildElement(0);
+        REQUIRE(wordXml->getIntAttribute("style", -1) == 1);
+        REQUIRE(wordXml->getChildByName("Formatting") == nullptr);
+
+        auto restored = NarrateClip::fromXml(*xml, &palette);
+        REQUIRE(restored.getWord(0).formatting == italic);
+        REQUIRE(!restored.getWord(1).formatting.has_value());
+    }
 }
 
 TEST_CASE("NarrateProject", "[data-model][project]")
@@ -287,4 +348,403 @@ TEST_CASE("NarrateProject", "[data-model][project]")
         REQUIRE_THAT(project.getClip(2).getStartTime(), Catch::Matchers::WithinRel(10.0, 0.001));
         REQUIRE_THAT(project.getClip(2).getEndTime(), Catch::Matchers::WithinRel(15.0, 0.001));
     }
+
+    SECTION("setClipTimes - keeps clips sorted by start time")
+    {
+        NarrateProject project;
+        for (int i = 0; i < 5; ++i)
+            project.addClip(NarrateClip("clip" + juce::String(i), i * 5.0, i * 5.0 + 4.0));
+
+        // Staying between its neighbours keeps the index
+        REQUIRE(project.setClipTimes(2, 11.0, 14.0) == 2);
+        REQUIRE(project.getClip(2).getId() == "clip2");
+        REQUIRE_THAT(project.getClip(2).getEndTime(), Catch::Matchers::WithinRel(14.0, 0.001));
+
+        // Moving later shifts the clips it passes down by one
+        REQUIRE(project.setClipTimes(1, 17.0, 19.0) == 3);
+        REQUIRE(project.getClip(1).getId() == "clip2");
+        REQUIRE(project.getClip(2).getId() == "clip3");
+        REQUIRE(project.getClip(3).getId() == "clip1");
+
+        // Moving earlier shifts them up
+        REQUIRE(project.setClipTimes(4, 1.0, 3.0) == 1);
+        REQUIRE(project.getClip(0).getId() == "clip0");
+        REQUIRE(project.getClip(1).getId() == "clip4");
+        REQUIRE(project.getClip(4).getId() == "clip1");
+
+        // Clips sharing the new start time stay on the side they were on, as sortClips() leaves them
+        REQUIRE(project.setClipTimes(0, 15.0, 16.0) == 2);
+        REQUIRE(project.getClip(1).getId() == "clip2");
+        REQUIRE(project.getClip(2).getId() == "clip0");
+        REQUIRE(project.getClip(3).getId() == "clip3");
+
+        REQUIRE(project.setClipTimes(4, 11.0, 12.0) == 2);
+        REQUIRE(project.getClip(1).getId() == "clip2");
+        REQUIRE(project.getClip(2).getId() == "clip1");
+        REQUIRE(project.getClip(3).getId() == "clip0");
+
+        for (int i = 1; i < project.getNumClips(); ++i)
+            REQUIRE(project.getClip(i - 1).getStartTime() <= project.getClip(i).getStartTime());
+    }
+
+    SECTION("Clip layout id - changes when the clips are reordered")
+    {
+        NarrateProject project;
+        project.addClip(NarrateClip("clip1", 0.0, 5.0));
+        project.addClip(NarrateClip("clip2", 5.0, 10.0));
+
+        const auto layoutId = project.getClipLayoutId();
+
+        // Edits in place and copies keep it
+        project.getClip(0).setText("Edited in place");
+        REQUIRE(project.setClipTimes(1, 6.0, 9.0) == 1);
+        REQUIRE(project.getClipLayoutId() == layoutId);
+
+        const NarrateProject copy(project);
+        REQUIRE(copy.getClipLayoutId() == layoutId);
+
+        // Reordering, adding and removing change it, and never back to an earlier one
+        REQUIRE(project.setClipTimes(0, 7.0, 8.0) == 1);
+        const auto reorderedId = project.getClipLayoutId();
+        REQUIRE(reorderedId != layoutId);
+
+        project.addClip(NarrateClip("clip3", 20.0, 25.0));
+        REQUIRE(project.getClipLayoutId() != reorderedId);
+
+        const auto addedId = project.getClipLayoutId();
+        project.removeClip(2);
+        REQUIRE(project.getClipLayoutId() != addedId);
+        REQUIRE(project.getClipLayoutId() != layoutId);
+        REQUIRE(NarrateProject().getClipLayoutId() != project.getClipLayoutId());
+    }
+}
+
+TEST_CASE("NarrateProject::ClipBatch", "[data-model][project][batch]")
+{
+    SECTION("Sorts out-of-order clips once on finish")
+    {
+        NarrateProject project;
+        {
+            NarrateProject::ClipBatch batch(project, 3);
+            batch.add(NarrateClip("clip2", 5.0, 10.0));
+            batch.add(NarrateClip("clip3", 10.0, 15.0));
+            batch.add(NarrateClip("clip1", 0.0, 5.0));
+            batch.finish();
+
+            REQUIRE(batch.getNumAdded() == 3);
+        }
+
+        REQUIRE(project.getNumClips() == 3);
+        REQUIRE(project.getClip(0).getId() == "clip1");
+        REQUIRE(project.getClip(1).getId() == "clip2");
+        REQUIRE(project.getClip(2).getId() == "clip3");
+    }
+
+    SECTION("Keeps in-order clips as added")
+    {
+        NarrateProject project;
+        NarrateProject::ClipBatch batch(project);
+
+        for (int i = 0; i < 100; ++i)
+            batch.add(NarrateClip("clip" + juce::String(i), i * 2.0, i * 2.0 + 1.5));
+
+        batch.finish();
+
+        REQUIRE(project.getNumClips() == 100);
+        for (int i = 0; i < 100; ++i)
+            REQUIRE(project.getClip(i).getId() == "clip" + juce::String(i));
+    }
+
+    SECTION("Merges with clips already in the project")
+    {
+        NarrateProject project;
+        project.addClip(NarrateClip("existing", 10.0, 15.0));
+
+        {
+            NarrateProject::ClipBatch batch(project);
+            batch.add(NarrateClip("early", 0.0, 5.0));
+            batch.add(NarrateClip("late", 20.0, 25.0));
+        } // Finishes on destruction
+
+        REQUIRE(project.getNumClips() == 3);
+        REQUIRE(project.getClip(0).getId() == "early");
+        REQUIRE(project.getClip(1).getId() == "existing");
+        REQUIRE(project.getClip(2).getId() == "late");
+    }
+
+    SECTION("Clips sharing a start time keep insertion order")
+    {
+        NarrateProject project;
+        NarrateProject::ClipBatch batch(project);
+        batch.add(NarrateClip("b", 5.0, 6.0));
+        batch.add(NarrateClip("a1", 1.0, 2.0));
+        batch.add(NarrateClip("a2", 1.0, 3.0));
+        batch.finish();
+
+        REQUIRE(project.getClip(0).getId() == "a1");
+        REQUIRE(project.getClip(1).getId() == "a2");
+        REQUIRE(project.getClip(2).getId() == "b");
+    }
+
+    SECTION("Changes the clip layout id once, on finish")
+    {
+        NarrateProject project;
+        const auto layoutId = project.getClipLayoutId();
+
+        NarrateProject::ClipBatch batch(project);
+        batch.add(NarrateClip("a", 0.0, 1.0));
+        batch.add(NarrateClip("b", 2.0, 3.0));
+        REQUIRE(project.getClipLayoutId() == layoutId);
+
+        batch.finish();
+        const auto addedId = project.getClipLayoutId();
+        REQUIRE(addedId != layoutId);
+
+        // Finishing again with nothing new added keeps it
+        batch.finish();
+        REQUIRE(project.getClipLayoutId() == addedId);
+    }
+
+    SECTION("XML load preserves clip order")
+    {
+        NarrateProject original;
+        for (int i = 0; i < 10; ++i)
+            original.addClip(NarrateClip("clip" + juce::String(i), i * 1.0, i * 1.0 + 0.5));
+
+        auto xml = original.toXml();
+        auto loaded = NarrateProject::fromXml(*xml);
+
+        REQUIRE(loaded.getNumClips() == 10);
+        for (int i = 0; i < 10; ++i)
+            REQUIRE(loaded.getClip(i).getId() == "clip" + juce::String(i));
+    }
+}
+
+TEST_CASE("NarrateProject time index", "[data-model][project][time-index]")
+{
+    SECTION("getClipIndicesAtTime - reports every overlapping clip")
+    {
+        NarrateProject project;
+        project.addClip(NarrateClip("long", 0.0, 20.0));
+        project.addClip(NarrateClip("a", 2.0, 4.0));
+        project.addClip(NarrateClip("b", 3.0, 6.0));
+        project.addClip(NarrateClip("c", 10.0, 12.0));
+
+        juce::Array<int> active;
+        REQUIRE(project.getClipIndicesAtTime(3.5, active) == 3);
+        REQUIRE(active == juce::Array<int>({ 0, 1, 2 }));
+
+        REQUIRE(project.getClipIndicesAtTime(8.0, active) == 1);
+        REQUIRE(active[0] == 0);
+
+        REQUIRE(project.getClipIndicesAtTime(25.0, active) == 0);
+
+        // First in clip order, as the linear search returned
+        REQUIRE(project.getClipIndexAtTime(3.5) == 0);
+        REQUIRE(project.getClipIndexAtTime(-1.0) == -1);
+    }
+
+    SECTION("getClipIndexAtTime - matches a linear scan")
+    {
+        NarrateProject project;
+        juce::Random random(42);
+
+        for (int i = 0; i < 200; ++i)
+        {
+            double start = random.nextDouble() * 100.0;
+            project.addClip(NarrateClip("clip" + juce::String(i), start, start + random.nextDouble() * 5.0));
+        }
+
+        for (double t = -1.0; t < 110.0; t += 0.37)
+        {
+            int expected = -1;
+            for (int i = 0; i < project.getNumClips(); ++i)
+            {
+                const auto& clip = std::as_const(project).getClip(i);
+                if (t >= clip.getStartTime() && t < clip.getEndTime())
+                {
+                    expected = i;
+                    break;
+                }
+            }
+
+            REQUIRE(project.getClipIndexAtTime(t) == expected);
+        }
+    }
+
+    SECTION("getWordIndexAtTime - word spans run to the next word or clip end")
+    {
+        NarrateProject project;
+        NarrateClip clip("clip", 10.0, 14.0);
+        clip.addWord(NarrateWord("one", 0.0));
+        clip.addWord(NarrateWord("two", 1.0));
+        clip.addWord(NarrateWord("three", 2.5));
+        project.addClip(clip);
+
+        REQUIRE(project.getWordIndexAtTime(0, 9.9) == -1);
+        REQUIRE(project.getWordIndexAtTime(0, 10.0) == 0);
+        REQUIRE(project.getWordIndexAtTime(0, 10.99) == 0);
+        REQUIRE(project.getWordIndexAtTime(0, 11.0) == 1);
+        REQUIRE(project.getWordIndexAtTime(0, 13.9) == 2);
+        REQUIRE(project.getWordIndexAtTime(0, 14.0) == -1);
+        REQUIRE(project.getWordIndexAtTime(5, 11.0) == -1);
+    }
+
+    SECTION("Edits through getClip invalidate the index")
+    {
+        NarrateProject project;
+        project.addClip(NarrateClip("clip", 0.0, 5.0));
+        REQUIRE(project.getClipIndexAtTime(7.0) == -1);
+
+        project.getClip(0).setEndTime(10.0);
+        REQUIRE(project.getClipIndexAtTime(7.0) == 0);
+
+        NarrateClip words("words", 20.0, 24.0);
+        words.addWord(NarrateWord("a", 0.0));
+        words.addWord(NarrateWord("b", 2.0));
+        project.addClip(words);
+        REQUIRE(project.getWordIndexAtTime(1, 21.0) == 0);
+
+        // Out-of-order word times fall back to a scan with the same answers
+        project.getClip(1).getWord(0).relativeTime = 3.0;
+        REQUIRE(project.getWordIndexAtTime(1, 21.0) == -1);
+        REQUIRE(project.getWordIndexAtTime(1, 23.5) == 1);
+
+        project.removeClip(0);
+        REQUIRE(project.getClipIndexAtTime(7.0) == -1);
+        REQUIRE(project.getClipIndexAtTime(21.0) == 0);
+    }
+
+    SECTION("Start times edited out of order are still found")
+    {
+        NarrateProject project;
+        project.addClip(NarrateClip("a", 0.0, 2.0));
+        project.addClip(NarrateClip("b", 5.0, 7.0));
+
+        project.getClip(1).setStartTime(-3.0);  // Not re-sorted until the next sort
+        REQUIRE(project.getClipIndexAtTime(-1.0) == 1);
+        REQUIRE(project.getClipIndexAtTime(1.0) == 0);
+    }
+}
+
+TEST_CASE("NarrateProject cached aggregates", "[data-model][project][aggregates]")
+{
+    NarrateProject project;
+    REQUIRE(project.getTotalNumWords() == 0);
+    REQUIRE(!project.hasOverlappingClips());
+
+    NarrateClip clip1("clip1", 0.0, 5.0);
+    clip1.setText("one two three");
+    project.addClip(clip1);
+
+    NarrateClip clip2("clip2", 6.0, 9.0);
+    clip2.setText("four five");
+    project.addClip(clip2);
+
+    REQUIRE(project.getTotalNumWords() == 5);
+    REQUIRE_THAT(project.getTotalDuration(), Catch::Matchers::WithinRel(9.0, 0.001));
+
+    SECTION("Word edits through getClip are picked up")
+    {
+        project.getClip(1).addWord(NarrateWord("six", 2.0));
+        REQUIRE(project.getTotalNumWords() == 6);
+
+        project.getClip(0).clearWords();
+        REQUIRE(project.getTotalNumWords() == 3);
+    }
+
+    SECTION("Clip time edits update duration and overlap state")
+    {
+        project.getClip(1).setEndTime(12.0);
+        REQUIRE_THAT(project.getTotalDuration(), Catch::Matchers::WithinRel(12.0, 0.001));
+
+        project.getClip(0).setEndTime(7.0);
+        REQUIRE(project.hasOverlappingClips());
+
+        project.removeClip(1);
+        REQUIRE(!project.hasOverlappingClips());
+        REQUIRE_THAT(project.getTotalDuration(), Catch::Matchers::WithinRel(7.0, 0.001));
+    }
+
+    SECTION("Held references need clipsChanged")
+    {
+        auto& clip = project.getClip(0);
+        REQUIRE(project.getTotalNumWords() == 5);  // Cache rebuilt after the non-const access
+
+        clip.addWord(NarrateWord("extra", 4.0));
+        project.clipsChanged();
+        REQUIRE(project.getTotalNumWords() == 6);
+    }
+
+    SECTION("clearClips resets everything")
+    {
+        project.clearClips();
+        REQUIRE(project.getTotalNumWords() == 0);
+        REQUIRE_THAT(project.getTotalDuration(), Catch::Matchers::WithinAbs(0.0, 1e-12));
+    }
+}
+
+TEST_CASE("NarrateProject formatting palette", "[data-model][project][palette]")
+{
+    TextFormatting highlight;
+    highlight.colour = juce::Colours::red;
+    highlight.bold = true;
+
+    NarrateProject project;
+    for (int i = 0; i < 20; ++i)
+    {
+        NarrateClip clip("clip" + juce::String(i), i * 2.0, i * 2.0 + 1.0);
+        NarrateWord styled("styled", 0.0);
+        styled.formatting = highlight;
+        clip.addWord(styled);
+        clip.addWord(NarrateWord("plain", 0.5));
+        project.addClip(clip);
+    }
+
+    SECTION("Holds each distinct style once")
+    {
+        const auto& palette = project.getFormattingPalette();
+        REQUIRE(palette.size() == 2);
+        REQUIRE(palette.indexOf(TextFormatting()) == 0);
+        REQUIRE(palette.indexOf(highlight) == 1);
+    }
+
+    SECTION("Is rebuilt after an edit")
+    {
+        REQUIRE(project.getFormattingPalette().size() == 2);
+
+        TextFormatting italic;
+        italic.italic = true;
+        project.getClip(5).getWord(1).formatting = italic;
+
+        const auto& palette = project.getFormattingPalette();
+        REQUIRE(palette.size() == 3);
+        REQUIRE(palette.indexOf(italic) == 2);
+    }
+
+    SECTION("XML writes the palette once and loads it back")
+    {
+        auto xml = project.toXml();
+        auto* stylesXml = xml->getChildByName("Styles");
+        REQUIRE(stylesXml != nullptr);
+        REQUIRE(stylesXml->getNumChildElements() == 2);
+
+        auto restored = NarrateProject::fromXml(*xml);
+        REQUIRE(restored.getNumClips() == 20);
+        REQUIRE(restored.getClip(19).getWord(0).formatting == highlight);
+        REQUIRE(!restored.getClip(19).getWord(1).formatting.has_value());
+    }
+
+    SECTION("Version 1.0 XML with inline formatting still loads")
+    {
+        auto legacy = juce::XmlDocument::parse(juce::String(
+            "<NarrateProject version=\"1.0\"><Clips><Clip id=\"c\" startTime=\"0\" endTime=\"1\">"
+            "<DefaultFormatting colour=\"ff00ffff\" bold=\"0\" italic=\"1\" fontSizeMultiplier=\"1\"/>"
+            "<Words><Word text=\"hi\" relativeTime=\"0\"><Formatting colour=\"ffff0000\" bold=\"1\" italic=\"0\" fontSizeMultiplier=\"1\"/></Word></Words>"
+            "</Clip></Clips></NarrateProject>"));
+
+        auto restored = NarrateProject::fromXml(*legacy);
+        REQUIRE(restored.getClip(0).getDefaultFormatting().italic);
+        REQUIRE(restored.getClip(0).getWord(0).formatting == highlight);
+    }
 }
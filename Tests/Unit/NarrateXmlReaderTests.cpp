@@ -0,0 +1,226 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "../../Source/NarrateXmlReader.h"
+
+using namespace Narrate;
+
+namespace
+{
+    bool readFromString(const juce::String& xmlText, NarrateProject& project)
+    {
+        juce::MemoryInputStream stream(xmlText.toRawUTF8(), xmlText.getNumBytesAsUTF8(), false);
+        return NarrateXmlReader::read(stream, project);
+    }
+
+    NarrateProject createTestProject()
+    {
+        NarrateProject project;
+        project.setProjectName("Stream <Test> & \"Friends\"");
+        project.setDefaultFontSize(28.0f);
+        project.setDefaultTextColour(juce::Colours::lightgrey);
+        project.setHighlightColour(juce::Colours::orange);
+        project.setRenderStrategy(NarrateProject::RenderStrategy::Karaoke);
+
+        for (int i = 0; i < 50; ++i)
+        {
+            NarrateClip clip("clip" + juce::String(i), i * 2.0, i * 2.0 + 1.75);
+
+            TextFormatting clipFormatting;
+            clipFormatting.italic = (i % 3 == 0);
+            clip.setDefaultFormatting(clipFormatting);
+
+            clip.addWord(NarrateWord("Word", 0.0));
+            clip.addWord(NarrateWord(juce::String::fromUTF8("na\xc3\xafve"), 0.333));
+
+            NarrateWord styled("styled", 1.25);
+            TextFormatting wordFormatting;
+            wordFormatting.colour = juce::Colours::red;
+            wordFormatting.bold = true;
+            wordFormatting.fontSizeMultiplier = 1.25f;
+            styled.formatting = wordFormatting;
+            clip.addWord(styled);
+
+            project.addClip(clip);
+        }
+
+        return project;
+    }
+
+    void requireSameProject(const NarrateProject& a, const NarrateProject& b)
+    {
+        REQUIRE(a.getProjectName() == b.getProjectName());
+        REQUIRE_THAT(a.getDefaultFontSize(), Catch::Matchers::WithinRel(b.getDefaultFontSize(), 0.0001f));
+        REQUIRE(a.getDefaultTextColour() == b.getDefaultTextColour());
+        REQUIRE(a.getHighlightColour() == b.getHighlightColour());
+        REQUIRE(a.getRenderStrategy() == b.getRenderStrategy());
+        REQUIRE(a.getNumClips() == b.getNumClips());
+
+        for (int i = 0; i < a.getNumClips(); ++i)
+        {
+            const auto& clipA = a.getClip(i);
+            const auto& clipB = b.getClip(i);
+
+            REQUIRE(clipA.getId() == clipB.getId());
+            REQUIRE(clipA.getStartTime() == clipB.getStartTime());
+            REQUIRE(clipA.getEndTime() == clipB.getEndTime());
+            REQUIRE(clipA.getDefaultFormatting().italic == clipB.getDefaultFormatting().italic);
+            REQUIRE(clipA.getNumWords() == clipB.getNumWords());
+
+            for (int w = 0; w < clipA.getNumWords(); ++w)
+            {
+                const auto& wordA = clipA.getWord(w);
+                const auto& wordB = clipB.getWord(w);
+
+                REQUIRE(wordA.text == wordB.text);
+                REQUIRE(wordA.relativeTime == wordB.relativeTime);
+                REQUIRE(wordA.formatting.has_value() == wordB.formatting.has_value());
+
+                if (wordA.formatting.has_value())
+                {
+                    REQUIRE(wordA.formatting->colour == wordB.formatting->colour);
+                    REQUIRE(wordA.formatting->bold == wordB.formatting->bold);
+                    REQUIRE(wordA.formatting->fontSizeMultiplier == wordB.formatting->fontSizeMultiplier);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("NarrateXmlReader", "[xml-reader]")
+{
+    SECTION("Matches the DOM loader on toXml output")
+    {
+        auto original = createTestProject();
+        auto xmlText = original.toXml()->toString();
+
+        NarrateProject streamed;
+        REQUIRE(readFromString(xmlText, streamed));
+
+        auto domLoaded = NarrateProject::fromXml(*juce::XmlDocument::parse(xmlText));
+        requireSameProject(streamed, domLoaded);
+        requireSameProject(streamed, original);
+    }
+
+    SECTION("Decodes predefined and numeric entities")
+    {
+        NarrateProject project;
+        REQUIRE(readFromString("<NarrateProject projectName=\"a &amp; b &lt;c&gt; &quot;d&quot; &apos;e&apos; &#233;&#x4E2D;\"/>",
+                               project));
+
+        REQUIRE(project.getProjectName() == juce::String::fromUTF8("a & b <c> \"d\" 'e' \xc3\xa9\xe4\xb8\xad"));
+    }
+
+    SECTION("Skips declaration, comments and unknown elements")
+    {
+        NarrateProject project;
+        REQUIRE(readFromString(
+            "\xef\xbb\xbf<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            "<!-- saved by a newer version -->\n"
+            "<NarrateProject projectName='Skip'>\n"
+            "  <Extension><Clips><Clip id=\"ignored\"/></Clips></Extension>\n"
+            "  <Clips>\n"
+            "    <Clip id=\"c1\" startTime=\"1.5\" endTime=\"2.5\">\n"
+            "      <Markers><Marker time=\"0.1\"/></Markers>\n"
+            "      <Words><Word text=\"hi\" relativeTime=\"0.25\"/><!-- c --></Words>\n"
+            "    </Clip>\n"
+            "  </Clips>\n"
+            "</NarrateProject>\n",
+            project));
+
+        REQUIRE(project.getProjectName() == "Skip");
+        REQUIRE(project.getNumClips() == 1);
+        REQUIRE(project.getClip(0).getId() == "c1");
+        REQUIRE(project.getClip(0).getNumWords() == 1);
+        REQUIRE_THAT(project.getClip(0).getWord(0).relativeTime, Catch::Matchers::WithinAbs(0.25, 1e-12));
+    }
+
+    SECTION("Sorts clips saved out of order")
+    {
+        NarrateProject project;
+        REQUIRE(readFromString("<NarrateProject><Clips>"
+                               "<Clip id=\"b\" startTime=\"5\" endTime=\"6\"/>"
+                               "<Clip id=\"a\" startTime=\"1\" endTime=\"2\"/>"
+                               "</Clips></NarrateProject>",
+                               project));
+
+        REQUIRE(project.getClip(0).getId() == "a");
+        REQUIRE(project.getClip(1).getId() == "b");
+    }
+
+    SECTION("Another root element gives an empty project")
+    {
+        NarrateProject project;
+        project.addClip(NarrateClip("old", 0.0, 1.0));
+
+        REQUIRE(readFromString("<SomethingElse><Clips/></SomethingElse>", project));
+        REQUIRE(project.getNumClips() == 0);
+    }
+
+    SECTION("Malformed documents are rejected and leave the project untouched")
+    {
+        NarrateProject project;
+        project.addClip(NarrateClip("old", 0.0, 1.0));
+
+        REQUIRE(!readFromString("<NarrateProject><Clips></NarrateProject>", project));
+        REQUIRE(!readFromString("<NarrateProject projectName=\"unterminated></NarrateProject>", project));
+        REQUIRE(!readFromString("<NarrateProject><Clips>", project));
+        REQUIRE(!readFromString("", project));
+
+        REQUIRE(project.getNumClips() == 1);
+        REQUIRE(project.getClip(0).getId() == "old");
+    }
+
+    SECTION("Resolves palette styles and inline formatting")
+    {
+        NarrateProject project;
+        REQUIRE(readFromString("<NarrateProject>"
+                               "<Styles><Style colour=\"ffff0000\" bold=\"1\"/><Style italic=\"1\"/></Styles>"
+                               "<Clips><Clip id=\"c\" startTime=\"0\" endTime=\"1\" defaultStyle=\"1\"><Words>"
+                               "<Word text=\"a\" relativeTime=\"0\" style=\"0\"/>"
+                               "<Word text=\"b\" relativeTime=\"0.2\"><Formatting fontSizeMultiplier=\"2\"/></Word>"
+                               "<Word text=\"c\" relativeTime=\"0.4\" style=\"7\"/>"
+                               "</Words></Clip></Clips></NarrateProject>",
+                               project));
+
+        const auto& clip = project.getClip(0);
+        REQUIRE(clip.getDefaultFormatting().italic);
+        REQUIRE(clip.getWord(0).formatting->bold);
+        REQUIRE(clip.getWord(0).formatting->colour == juce::Colours::red);
+        REQUIRE(clip.getWord(1).formatting->fontSizeMultiplier == 2.0f);
+        REQUIRE(!clip.getWord(2).formatting.has_value());  // Out-of-range index is ignored
+    }
+
+    SECTION("Small buffers split tokens across refills")
+    {
+        auto original = createTestProject();
+        auto xmlText = original.toXml()->toString();
+
+        juce::MemoryInputStream stream(xmlText.toRawUTF8(), xmlText.getNumBytesAsUTF8(), false);
+        XmlPullParser parser(stream, 7);
+
+        int numWords = 0;
+        for (auto token = parser.next(); token != XmlPullParser::Token::EndOfDocument; token = parser.next())
+        {
+            REQUIRE(token != XmlPullParser::Token::Error);
+            if (token == XmlPullParser::Token::StartElement && parser.hasTagName("Word"))
+                ++numWords;
+        }
+
+        REQUIRE(numWords == 150);
+    }
+}
+
+TEST_CASE("NarrateProject loads XML files by streaming", "[xml-reader][project]")
+{
+    auto file = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                    .getChildFile("narrate-xml-reader-test.narrate");
+
+    auto original = createTestProject();
+    REQUIRE(original.saveToFile(file));
+
+    NarrateProject loaded;
+    REQUIRE(loaded.loadFromFile(file));
+    requireSameProject(loaded, original);
+
+    file.deleteFile();
+}
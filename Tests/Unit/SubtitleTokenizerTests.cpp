@@ -0,0 +1,298 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../../Source/Features/SubtitleTokenizer.h"
+#include "../../Source/Features/TextBlockReader.h"
+
+namespace
+{
+    std::vector<SubtitleTokenizer::Cue> readAll(SubtitleTokenizer& tokenizer)
+    {
+        std::vector<SubtitleTokenizer::Cue> cues;
+        SubtitleTokenizer::Cue cue;
+        while (tokenizer.next(cue))
+            cues.push_back(cue);
+        return cues;
+    }
+
+    // Cues read window by window through a TextBlockReader, as the importer does
+    std::vector<SubtitleTokenizer::Cue> readWindows(const std::string& text, SubtitleTokenizer::Format format,
+                                                    size_t windowSize, std::vector<std::string>& storage)
+    {
+        TextBlockReader reader(std::make_unique<juce::MemoryInputStream>(text.data(), text.size(), false), windowSize);
+        std::vector<SubtitleTokenizer::Cue> cues;
+        std::string_view window;
+        bool first = true;
+
+        while (reader.readNextWindow(window))
+        {
+            // Windows are only valid until the next read
+            storage.emplace_back(window);
+            SubtitleTokenizer tokenizer(storage.back(), format, first);
+            for (const auto& cue : readAll(tokenizer))
+                cues.push_back(cue);
+            first = false;
+        }
+
+        REQUIRE(reader.getBytesConsumed() == (juce::int64) text.size());
+        return cues;
+    }
+
+    std::vector<juce::String> split(std::string_view text, SubtitleTokenizer::Format format)
+    {
+        std::vector<juce::String> words;
+        SubtitleTokenizer::splitWords(text, format, words);
+        return words;
+    }
+}
+
+TEST_CASE("SubtitleTokenizer timecode parsing", "[import][tokenizer]")
+{
+    juce::int64 ms = 0;
+
+    SECTION("Integer milliseconds")
+    {
+        REQUIRE(SubtitleTokenizer::parseTimecodeMs("01:23:45,678", ms));
+        REQUIRE(ms == 5025678);
+        REQUIRE(SubtitleTokenizer::parseTimecodeMs("00:00:01.5", ms));
+        REQUIRE(ms == 1500);
+        REQUIRE(SubtitleTokenizer::parseTimecodeMs("00:00:01.23456", ms));
+        REQUIRE(ms == 1234);
+        REQUIRE(SubtitleTokenizer::parseTimecodeMs("100:00:00", ms));
+        REQUIRE(ms == 360000000);
+    }
+
+    SECTION("Minutes-only form is WebVTT only")
+    {
+        REQUIRE_FALSE(SubtitleTokenizer::parseTimecodeMs("01:02.500", ms));
+        REQUIRE(SubtitleTokenizer::parseTimecodeMs("01:02.500", ms, true));
+        REQUIRE(ms == 62500);
+    }
+
+    SECTION("Malformed input")
+    {
+        REQUIRE_FALSE(SubtitleTokenizer::parseTimecodeMs("", ms));
+        REQUIRE_FALSE(SubtitleTokenizer::parseTimecodeMs("00:00:01,", ms));
+        REQUIRE_FALSE(SubtitleTokenizer::parseTimecodeMs("00:00:01,000x", ms));
+        REQUIRE_FALSE(SubtitleTokenizer::parseTimecodeMs("00::01,000", ms));
+        REQUIRE_FALSE(SubtitleTokenizer::parseTimecodeMs("00:00:00:01", ms));
+        REQUIRE_FALSE(SubtitleTokenizer::parseTimecodeMs("-1:00:00", ms));
+        REQUIRE(SubtitleTokenizer::parseTimecode("garbage") == -1.0);
+    }
+}
+
+TEST_CASE("SubtitleTokenizer reads SRT cues", "[import][tokenizer][srt]")
+{
+    SECTION("Cue text is a view into the input")
+    {
+        std::string_view text = "1\n00:00:01,000 --> 00:00:02,500\nHello\nworld\n\n2\n00:00:03,000 --> 00:00:04,000\nAgain\n";
+        SubtitleTokenizer tokenizer(text, SubtitleTokenizer::Format::SRT);
+        auto cues = readAll(tokenizer);
+
+        REQUIRE(cues.size() == 2);
+        REQUIRE(cues[0].startTime == 1.0);
+        REQUIRE(cues[0].endTime == 2.5);
+        REQUIRE(cues[0].text == "Hello\nworld");
+        REQUIRE(cues[0].text.data() >= text.data());
+        REQUIRE(cues[0].text.data() < text.data() + text.size());
+        REQUIRE(cues[1].text == "Again");
+        REQUIRE(tokenizer.getPosition() == tokenizer.getSize());
+    }
+
+    SECTION("CRLF, lone CR and a byte order mark")
+    {
+        std::string_view crlf = "\xEF\xBB\xBF" "1\r\n00:00:01,000 --> 00:00:02,000\r\nOne\r\n\r\n2\r\n00:00:03,000 --> 00:00:04,000\r\nTwo\r\n";
+        SubtitleTokenizer crlfTokenizer(crlf, SubtitleTokenizer::Format::SRT);
+        auto crlfCues = readAll(crlfTokenizer);
+        REQUIRE(crlfCues.size() == 2);
+        REQUIRE(crlfCues[0].text == "One");
+        REQUIRE(crlfCues[1].text == "Two");
+
+        std::string_view cr = "1\r00:00:01,000 --> 00:00:02,000\rOne\r\r2\r00:00:03,000 --> 00:00:04,000\rTwo";
+        SubtitleTokenizer crTokenizer(cr, SubtitleTokenizer::Format::SRT);
+        auto crCues = readAll(crTokenizer);
+        REQUIRE(crCues.size() == 2);
+        REQUIRE(crCues[1].startTime == 3.0);
+        REQUIRE(crCues[1].text == "Two");
+    }
+
+    SECTION("Malformed blocks are skipped and counted")
+    {
+        std::string_view text =
+            "1\nnot a timecode\nLost\n\n"
+            "2\n00:00:01,000 --> bad\nLost too\n\n"
+            "3\n00:00:02,000 --> 00:00:03,000\n\n"
+            "4\n00:00:04,000 --> 00:00:05,000 X1:10 X2:20\nKept\n";
+        SubtitleTokenizer tokenizer(text, SubtitleTokenizer::Format::SRT);
+        auto cues = readAll(tokenizer);
+
+        REQUIRE(cues.size() == 1);
+        REQUIRE(cues[0].startTime == 4.0);
+        REQUIRE(cues[0].endTime == 5.0);
+        REQUIRE(cues[0].text == "Kept");
+        REQUIRE(tokenizer.getNumSkippedBlocks() == 3);
+    }
+
+    SECTION("Words keep SRT markup literally but lose invisible characters")
+    {
+        auto words = split("Hi\xE2\x80\x8B there\n<i>A&amp;B</i>\x01", SubtitleTokenizer::Format::SRT);
+        REQUIRE(words.size() == 3);
+        REQUIRE(words[0] == "Hi");
+        REQUIRE(words[1] == "there");
+        REQUIRE(words[2] == "<i>A&amp;B</i>");
+    }
+}
+
+TEST_CASE("SubtitleTokenizer reads WebVTT cues", "[import][tokenizer][webvtt]")
+{
+    SECTION("Header, metadata blocks, identifiers and cue settings")
+    {
+        std::string_view text =
+            "WEBVTT - Example\nKind: captions\n\n"
+            "NOTE This is a comment\nspanning lines\n\n"
+            "STYLE\n::cue { color: red }\n\n"
+            "intro\n00:01.000 --> 00:02.500 align:start position:10%\n<v Roger Bingham>We are in\n\n"
+            "00:00:03.000 --> 00:00:04.000\nNo identifier\n";
+        SubtitleTokenizer tokenizer(text, SubtitleTokenizer::Format::WebVTT);
+        REQUIRE(tokenizer.hasValidHeader());
+
+        auto cues = readAll(tokenizer);
+        REQUIRE(cues.size() == 2);
+        REQUIRE(cues[0].startTime == 1.0);
+        REQUIRE(cues[0].endTime == 2.5);
+        REQUIRE(cues[1].startTime == 3.0);
+        REQUIRE(cues[1].text == "No identifier");
+        REQUIRE(tokenizer.getNumSkippedBlocks() == 0);
+    }
+
+    SECTION("Missing signature")
+    {
+        SubtitleTokenizer tokenizer("00:01.000 --> 00:02.000\nText\n", SubtitleTokenizer::Format::WebVTT);
+        REQUIRE_FALSE(tokenizer.hasValidHeader());
+    }
+
+    SECTION("Words drop tags and decode entities")
+    {
+        auto words = split("<v Roger Bingham>We <00:00:01.500><c.loud>are</c> <b>Tom&amp;Jerry</b> &lt;3 &bogus;",
+                           SubtitleTokenizer::Format::WebVTT);
+        REQUIRE(words.size() == 5);
+        REQUIRE(words[0] == "We");
+        REQUIRE(words[1] == "are");
+        REQUIRE(words[2] == "Tom&Jerry");
+        REQUIRE(words[3] == "<3");
+        REQUIRE(words[4] == "&bogus;");
+    }
+}
+
+TEST_CASE("SubtitleTokenizer reads a long SRT file", "[import][tokenizer][srt]")
+{
+    auto file = juce::File(__FILE__).getParentDirectory().getParentDirectory()
+                    .getChildFile("Data").getChildFile("long-srt-subs-test-file.srt");
+
+    if (!file.existsAsFile())
+        SKIP("Test data not found: " << file.getFullPathName());
+
+    juce::MemoryBlock data;
+    REQUIRE(file.loadFileAsData(data));
+    SubtitleTokenizer tokenizer(std::string_view(static_cast<const char*>(data.getData()), data.getSize()),
+                                SubtitleTokenizer::Format::SRT);
+    auto cues = readAll(tokenizer);
+
+    REQUIRE(cues.size() == 1394);
+    REQUIRE(tokenizer.getNumSkippedBlocks() == 0);
+    REQUIRE(cues[0].startTime == 26.611);
+    REQUIRE(cues[0].endTime == 30.365);
+    REQUIRE(cues[0].text == "Goedendag. En hallo daar,\ndames en heren.");
+
+    for (size_t i = 1; i < cues.size(); ++i)
+        REQUIRE(cues[i].startTime >= cues[i - 1].startTime);
+}
+
+TEST_CASE("SubtitleTokenizer chunks match a single pass", "[import][tokenizer]")
+{
+    std::string_view text =
+        "WEBVTT\n\n"
+        "1\n00:01.000 --> 00:02.000\nOne\n\n"
+        "NOTE between\ncues\n\n"
+        "2\r\n00:03.000 --> 00:04.000\r\nTwo\r\nlines\r\n\r\n"
+        "broken\nblock\n\n"
+        "00:05.000 --> 00:06.000\nThree\n\n\n\n"
+        "4\n00:07.000 --> 00:08.000\nFour";
+
+    SubtitleTokenizer whole(text, SubtitleTokenizer::Format::WebVTT);
+    SubtitleTokenizer reference(text, SubtitleTokenizer::Format::WebVTT);
+    auto expected = readAll(reference);
+    REQUIRE(expected.size() == 4);
+
+    for (int numChunks = 1; numChunks <= (int) text.size(); ++numChunks)
+    {
+        std::vector<SubtitleTokenizer::Cue> cues;
+        int numSkipped = 0;
+
+        for (auto& chunk : whole.splitAtBlockBoundaries(numChunks))
+        {
+            for (const auto& cue : readAll(chunk))
+                cues.push_back(cue);
+            numSkipped += chunk.getNumSkippedBlocks();
+        }
+
+        REQUIRE(cues.size() == expected.size());
+        REQUIRE(numSkipped == reference.getNumSkippedBlocks());
+
+        for (size_t i = 0; i < cues.size(); ++i)
+        {
+            REQUIRE(cues[i].startTime == expected[i].startTime);
+            REQUIRE(cues[i].text == expected[i].text);
+        }
+    }
+}
+
+TEST_CASE("TextBlockReader windows end on block boundaries", "[import][tokenizer]")
+{
+    // Mixed line endings and whitespace-only separator lines
+    std::string text = "\xEF\xBB\xBFWEBVTT\n\n";
+    for (int i = 0; i < 2000; ++i)
+    {
+        const char* lineBreak = i % 3 == 0 ? "\r\n" : (i % 3 == 1 ? "\n" : "\r");
+        text += std::to_string(i) + lineBreak;
+        text += "00:" + std::string(i % 60 < 10 ? "0" : "") + std::to_string(i % 60) + ".000 --> 00:59.000" + lineBreak;
+        text += "Cue " + std::to_string(i) + lineBreak + "second line" + lineBreak;
+        text += i % 7 == 0 ? std::string(" \t") + lineBreak : std::string(lineBreak);
+    }
+
+    SubtitleTokenizer reference(text, SubtitleTokenizer::Format::WebVTT);
+    auto expected = readAll(reference);
+    REQUIRE(expected.size() == 2000);
+
+    for (size_t windowSize : { (size_t) 1, (size_t) 4096, (size_t) 5000, (size_t) 1 << 20 })
+    {
+        std::vector<std::string> storage;
+        auto cues = readWindows(text, SubtitleTokenizer::Format::WebVTT, windowSize, storage);
+
+        REQUIRE(cues.size() == expected.size());
+        for (size_t i = 0; i < cues.size(); ++i)
+        {
+            REQUIRE(cues[i].startTime == expected[i].startTime);
+            REQUIRE(cues[i].text == expected[i].text);
+        }
+    }
+
+    SECTION("A block larger than the window grows it")
+    {
+        std::string big = "1\n00:00:01,000 --> 00:00:02,000\n" + std::string(10000, 'x') + "\n\n2\n00:00:03,000 --> 00:00:04,000\nEnd\n";
+        std::vector<std::string> storage;
+        auto cues = readWindows(big, SubtitleTokenizer::Format::SRT, 4096, storage);
+
+        REQUIRE(cues.size() == 2);
+        REQUIRE(cues[0].text.size() == 10000);
+        REQUIRE(cues[1].text == "End");
+    }
+
+    SECTION("UTF-16 input is flagged instead of split")
+    {
+        const char utf16[] = "\xFF\xFE" "1\0";
+        TextBlockReader reader(std::make_unique<juce::MemoryInputStream>(utf16, sizeof(utf16) - 1, false));
+        std::string_view window;
+
+        REQUIRE_FALSE(reader.readNextWindow(window));
+        REQUIRE(reader.isUTF16());
+    }
+}
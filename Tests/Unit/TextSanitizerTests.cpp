@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../../Source/Features/TextSanitizer.h"
+#include "../../Source/Features/SubtitleTokenizer.h"
+#include "../../Source/Features/TextBlockReader.h"
+#include <random>
+
+namespace
+{
+    std::string sanitized(std::string text)
+    {
+        text.resize(TextSanitizer::sanitize(text.data(), text.size()));
+        return text;
+    }
+
+    std::string sanitizedScalar(std::string text)
+    {
+        text.resize(TextSanitizer::sanitizeScalar(text.data(), text.size()));
+        return text;
+    }
+}
+
+TEST_CASE("TextSanitizer strips invisible characters", "[import][sanitizer]")
+{
+    INFO("Kernel: " << TextSanitizer::getKernelName());
+
+    SECTION("Plain text and allowed whitespace are untouched")
+    {
+        std::string text = "1\r\n00:00:01,000 --> 00:00:02,000\r\nHello\tworld\n\n";
+        REQUIRE(sanitized(text) == text);
+        REQUIRE(sanitized("") == "");
+    }
+
+    SECTION("Control characters, zero-width spaces and byte order marks are removed")
+    {
+        REQUIRE(sanitized(std::string("a\0b\x01" "c\x1F" "d\x7F", 8)) == "abcd\x7F");
+        REQUIRE(sanitized("Hi\xE2\x80\x8B there\xEF\xBB\xBF!") == "Hi there!");
+        REQUIRE(sanitized("C1\xC2\x80\xC2\x9F" "end") == "C1end");
+    }
+
+    SECTION("Other characters are kept")
+    {
+        std::string text = "caf\xC3\xA9 \xC2\xA0 \xE2\x80\x8C \xE2\x82\xAC \xF0\x9F\x8E\xA4 \xE4\xB8\xAD\xE6\x96\x87";
+        REQUIRE(sanitized(text) == text);
+    }
+
+    SECTION("Malformed UTF-8 is dropped byte by byte")
+    {
+        REQUIRE(sanitized("a\x80" "b\xFF" "c") == "abc");              // Stray continuation and invalid byte
+        REQUIRE(sanitized("a\xC3" "b") == "ab");                        // Truncated sequence
+        REQUIRE(sanitized("a\xC0\xAF" "b") == "ab");                    // Overlong '/'
+        REQUIRE(sanitized("a\xE0\x80\xAF" "b") == "ab");                // Overlong three-byte form
+        REQUIRE(sanitized("a\xED\xA0\x80" "b") == "ab");                // Surrogate
+        REQUIRE(sanitized("a\xF4\x90\x80\x80" "b") == "ab");            // Above U+10FFFF
+        REQUIRE(sanitized("\xE2\x82") == "");                           // Truncated at the end
+    }
+
+    SECTION("Removals inside long ASCII runs")
+    {
+        std::string text(100, 'x');
+        text[17] = '\x02';
+        text.insert(64, "\xE2\x80\x8B");
+        REQUIRE(sanitized(text) == std::string(99, 'x'));
+    }
+}
+
+TEST_CASE("TextSanitizer kernels agree", "[import][sanitizer]")
+{
+    INFO("Kernel: " << TextSanitizer::getKernelName());
+
+    // Mostly ASCII with interesting bytes mixed in, at lengths around the block sizes
+    const char* fragments[] = { "a", " ", "\n", "\r\n", "\t", "\x01", "\x7F", "\xC3\xA9", "\xC2\x85", "\xE2\x80\x8B",
+                                "\xEF\xBB\xBF", "\xF0\x9F\x8E\xA4", "\x80", "\xE2\x82", "\xFF", "\xED\xA0\x80" };
+    std::mt19937 random(12345);
+
+    for (int length = 0; length < 300; ++length)
+    {
+        for (int trial = 0; trial < 20; ++trial)
+        {
+            std::string text;
+            while ((int) text.size() < length)
+            {
+                const auto pick = random() % 64;
+                if (pick < 48)
+                    text += "abcdefghijklmnop"[pick % 16];
+                else
+                    text += fragments[pick % 16];
+            }
+
+            REQUIRE(sanitized(text) == sanitizedScalar(text));
+            REQUIRE(TextSanitizer::isClean(text.data(), text.size()) == (sanitized(text) == text));
+        }
+    }
+}
+
+TEST_CASE("Sanitized windows keep their stream offsets", "[import][sanitizer]")
+{
+    std::string text;
+    for (int i = 0; i < 500; ++i)
+        text += std::to_string(i + 1) + "\n00:00:01,000 --> 00:00:02,000\nWord\xE2\x80\x8B" "s\x01 " + std::to_string(i) + "\n\n";
+
+    TextBlockReader reader(std::make_unique<juce::MemoryInputStream>(text.data(), text.size(), false), 4096);
+    reader.setSanitizeText(true);
+
+    std::string_view window;
+    juce::int64 expectedStart = 0;
+    int numCues = 0;
+
+    while (reader.readNextWindow(window))
+    {
+        REQUIRE(reader.getWindowStart() == expectedStart);
+        expectedStart = reader.getBytesConsumed();
+
+        REQUIRE(window.find('\x01') == std::string_view::npos);
+        REQUIRE(window.find("\xE2\x80\x8B") == std::string_view::npos);
+
+        SubtitleTokenizer tokenizer(window, SubtitleTokenizer::Format::SRT, numCues == 0);
+        SubtitleTokenizer::Cue cue;
+        while (tokenizer.next(cue))
+        {
+            REQUIRE(cue.text == "Words " + std::to_string(numCues));
+            ++numCues;
+        }
+    }
+
+    REQUIRE(numCues == 500);
+    REQUIRE(reader.getBytesConsumed() == (juce::int64) text.size());
+}
@@ -0,0 +1,665 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../../Source/TimelineEventManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace Narrate;
+
+namespace
+{
+    // Clips with gaps between them, one clip overlapping the next and one without words
+    NarrateProject createTestProject()
+    {
+        NarrateProject project;
+
+        for (int i = 0; i < 40; ++i)
+        {
+            const double start = i * 2.5;
+            NarrateClip clip("clip" + juce::String(i), start, start + (i % 7 == 3 ? 3.0 : 2.0));
+
+            if (i % 11 != 5)
+                for (int w = 0; w < 4; ++w)
+                    clip.addWord(NarrateWord("w" + juce::String(w), w * 0.4));
+
+            project.addClip(clip);
+        }
+
+        return project;
+    }
+
+    struct ActiveState
+    {
+        int clipIndex = -1;
+        int wordIndex = -1;
+
+        bool operator== (const ActiveState&) const = default;
+    };
+
+    // The active clip and word reached by playing from the start up to (not including) time
+    ActiveState playTo(const NarrateProject& project, double time)
+    {
+        TimelineEventManager manager;
+        ActiveState state;
+
+        manager.onClipStart = [&](int clipIndex) { state = { clipIndex, -1 }; };
+        manager.onWordStart = [&](int clipIndex, int wordIndex)
+        {
+            if (clipIndex == state.clipIndex)
+                state.wordIndex = wordIndex;
+        };
+
+        manager.buildTimeline(project);
+        manager.processEvents(-1.0, time);
+        return state;
+    }
+
+    // The display state reached by firing every event at or before time
+    TimelineEventManager::DisplayState replayTo(const NarrateProject& project, const HighlightSettings& settings, double time)
+    {
+        TimelineEventManager manager;
+        TimelineEventManager::DisplayState state;
+
+        manager.onClipStart = [&](int clipIndex) { state = { clipIndex, -1, false }; };
+        manager.onWordStart = [&](int clipIndex, int wordIndex)
+        {
+            if (clipIndex == state.clipIndex)
+                state = { clipIndex, wordIndex, true };
+        };
+        manager.onHighlightEnd = [&](int clipIndex, int wordIndex)
+        {
+            if (clipIndex == state.clipIndex && wordIndex == state.wordIndex)
+                state.highlightActive = false;
+        };
+
+        manager.buildTimeline(project, settings);
+        manager.processEvents(-1.0, std::nextafter(time, 1.0e9));
+        return state;
+    }
+
+    void requireSameTimeline(const TimelineEventManager& actual, const TimelineEventManager& expected)
+    {
+        const auto& a = actual.getTimeline();
+        const auto& b = expected.getTimeline();
+        REQUIRE(a.size() == b.size());
+
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            REQUIRE(a[i].time == b[i].time);
+            REQUIRE(a[i].type == b[i].type);
+            REQUIRE(a[i].clipIndex == b[i].clipIndex);
+            REQUIRE(a[i].wordIndex == b[i].wordIndex);
+        }
+
+        for (double time = -0.5; time < 105.0; time += 0.07)
+        {
+            const auto x = actual.getDisplayStateAt(time);
+            const auto y = expected.getDisplayStateAt(time);
+            REQUIRE(x.clipIndex == y.clipIndex);
+            REQUIRE(x.wordIndex == y.wordIndex);
+            REQUIRE(x.highlightActive == y.highlightActive);
+        }
+    }
+
+    // A project over the parallel build threshold: clips that overlap, clips without words
+    // and clips whose word times are out of order or before the clip starts
+    NarrateProject createLargeProject()
+    {
+        NarrateProject project;
+        NarrateProject::ClipBatch batch(project, 12000);
+        juce::Random random(7);
+        double start = 0.0;
+
+        for (int i = 0; i < 12000; ++i)
+        {
+            const double length = 0.2 + random.nextDouble() * 4.0;
+            NarrateClip clip("clip" + juce::String(i), start, start + length);
+
+            const int numWords = i % 13 == 0 ? 0 : 1 + random.nextInt(15);
+            for (int w = 0; w < numWords; ++w)
+            {
+                const double time = i % 5 == 0 ? random.nextDouble() * length - 0.2 : w * length / numWords;
+                clip.addWord(NarrateWord("w", time));
+            }
+
+            batch.add(std::move(clip));
+            start += random.nextDouble() * 3.0 - 0.5;
+            start = juce::jmax(0.0, start);
+        }
+
+        return project;
+    }
+
+    // The timeline as built before compilation was chunked: clip by clip, one word at a time,
+    // then a stable sort of every event
+    std::vector<TimelineEventManager::TimeEvent> buildReferenceTimeline(const NarrateProject& project, const HighlightSettings& settings)
+    {
+        using EventType = TimelineEventManager::EventType;
+        using DurationMode = HighlightSettings::DurationMode;
+
+        const auto toTickTime = [](double time)
+        {
+            // Rounded to the nearest tick, as the manager does
+            const double scaled = time * TimelineEventManager::ticksPerSecond;
+            return (double) (TimelineEventManager::Tick) (scaled < 0.0 ? scaled - 0.5 : scaled + 0.5) / TimelineEventManager::ticksPerSecond;
+        };
+
+        const auto highlightDuration = [&settings](double wordDuration, double wordStartTime)
+        {
+            const double snapInterval = settings.getSnapInterval();
+
+            switch (settings.durationMode)
+            {
+                case DurationMode::Minimum: return std::max(wordDuration, settings.minimumDuration);
+                case DurationMode::Fixed:   return settings.fixedDuration;
+                case DurationMode::GridBased:
+                    if (snapInterval > 0.0)
+                    {
+                        double nextGridTime = std::ceil(wordStartTime / snapInterval) * snapInterval;
+                        if (nextGridTime <= wordStartTime)
+                            nextGridTime += snapInterval;
+                        return nextGridTime - wordStartTime;
+                    }
+                    return wordDuration;
+                default:                    return wordDuration;
+            }
+        };
+
+        std::vector<TimelineEventManager::TimeEvent> events;
+
+        for (int c = 0; c < project.getNumClips(); ++c)
+        {
+            const auto& clip = project.getClip(c);
+            const int numWords = clip.getNumWords();
+
+            double clipStartTime = clip.getStartTime();
+            if (settings.quantizeEnabled)
+                clipStartTime = settings.quantizeTime(clipStartTime);
+
+            events.push_back({ toTickTime(clipStartTime), EventType::ClipStart, c, -1 });
+            double currentTime = clipStartTime;
+
+            for (int w = 0; w < numWords; ++w)
+            {
+                double wordTime = clip.getStartTime() + clip.getWord(w).relativeTime;
+
+                if (settings.quantizeEnabled)
+                {
+                    wordTime = settings.quantizeTime(wordTime);
+                    if (wordTime < currentTime)
+                        wordTime = currentTime;
+                }
+
+                const double wordDuration = (w < numWords - 1 ? clip.getStartTime() + clip.getWord(w + 1).relativeTime
+                                                              : clip.getEndTime()) - wordTime;
+
+                events.push_back({ toTickTime(wordTime), EventType::WordStart, c, w });
+                events.push_back({ toTickTime(wordTime + highlightDuration(wordDuration, wordTime)), EventType::HighlightEnd, c, w });
+                events.push_back({ toTickTime(wordTime + wordDuration), EventType::WordEnd, c, w });
+                currentTime = wordTime + wordDuration;
+            }
+
+            events.push_back({ toTickTime(clip.getEndTime()), EventType::ClipEnd, c, -1 });
+        }
+
+        std::stable_sort(events.begin(), events.end());
+        return events;
+    }
+
+    size_t linearSeek(const std::vector<TimelineEventManager::TimeEvent>& timeline, double time)
+    {
+        for (size_t i = 0; i < timeline.size(); ++i)
+            if (timeline[i].time >= time)
+                return i;
+
+        return timeline.size();
+    }
+}
+
+TEST_CASE("TimelineEventManager follows time jumps in either direction", "[timeline]")
+{
+    const auto project = createTestProject();
+    TimelineEventManager manager;
+    manager.buildTimeline(project);
+
+    const auto& timeline = manager.getTimeline();
+    REQUIRE(!timeline.empty());
+
+    std::vector<TimelineEventManager::TimeEvent> fired;
+    manager.onClipStart = [&](int c) { fired.push_back({ 0.0, TimelineEventManager::EventType::ClipStart, c, -1 }); };
+    manager.onClipEnd = [&](int c) { fired.push_back({ 0.0, TimelineEventManager::EventType::ClipEnd, c, -1 }); };
+    manager.onWordStart = [&](int c, int w) { fired.push_back({ 0.0, TimelineEventManager::EventType::WordStart, c, w }); };
+    manager.onWordEnd = [&](int c, int w) { fired.push_back({ 0.0, TimelineEventManager::EventType::WordEnd, c, w }); };
+    manager.onHighlightEnd = [&](int c, int w) { fired.push_back({ 0.0, TimelineEventManager::EventType::HighlightEnd, c, w }); };
+
+    SECTION("Each window fires exactly its own events, wherever the last one ended")
+    {
+        // Forward and backward hops of every size, from wherever the last window left the cursor
+        juce::Random random(42);
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            const double from = random.nextDouble() * 110.0 - 5.0;
+            const double to = from + random.nextDouble() * 3.0;
+
+            fired.clear();
+            manager.processEvents(from, to);
+
+            const auto first = linearSeek(timeline, from);
+            REQUIRE(fired.size() == linearSeek(timeline, to) - first);
+
+            for (size_t e = 0; e < fired.size(); ++e)
+            {
+                REQUIRE(fired[e].type == timeline[first + e].type);
+                REQUIRE(fired[e].clipIndex == timeline[first + e].clipIndex);
+                REQUIRE(fired[e].wordIndex == timeline[first + e].wordIndex);
+            }
+        }
+    }
+
+    SECTION("Windows past either end")
+    {
+        manager.processEvents(1000.0, 1001.0);
+        REQUIRE(fired.empty());
+
+        manager.processEvents(-1.0, 0.0);
+        REQUIRE(fired.empty());
+
+        manager.processEvents(-1.0, 0.01);
+        REQUIRE(fired.size() == 2);
+    }
+
+    SECTION("Events at the same time fire clip start first")
+    {
+        manager.processEvents(0.0, 50.0);
+        fired.clear();
+        manager.processEvents(2.5, 2.6);
+
+        REQUIRE(fired.size() == 2);
+        REQUIRE(fired[0].type == TimelineEventManager::EventType::ClipStart);
+        REQUIRE(fired[1].type == TimelineEventManager::EventType::WordStart);
+        REQUIRE(manager.getDisplayStateAt(2.5).clipIndex == 1);
+        REQUIRE(manager.getDisplayStateAt(2.5).wordIndex == 0);
+    }
+}
+
+TEST_CASE("TimelineEventManager seeks and reports the active clip and word", "[timeline]")
+{
+    const auto project = createTestProject();
+    TimelineEventManager manager;
+    manager.buildTimeline(project);
+
+    SECTION("The active clip and word after a seek match playing up to that time")
+    {
+        // Forward and backward hops of every size, from wherever the last seek left the cursor
+        juce::Random random(7);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            const double time = random.nextDouble() * 110.0 - 5.0;
+            manager.seekToTime(time);
+            const ActiveState state { manager.getActiveClipIndex(), manager.getActiveWordIndex() };
+            REQUIRE(state == playTo(project, time));
+        }
+    }
+
+    SECTION("Seeking past either end")
+    {
+        manager.seekToTime(1000.0);
+        REQUIRE(manager.getActiveClipIndex() == 39);
+
+        manager.seekToTime(-1.0);
+        REQUIRE(manager.getActiveClipIndex() == -1);
+        REQUIRE(manager.getActiveWordIndex() == -1);
+    }
+
+    SECTION("Playback fires from the seek position")
+    {
+        manager.seekToTime(2.5);
+        REQUIRE(manager.getActiveClipIndex() == 0);
+        REQUIRE(manager.getActiveWordIndex() == 3);
+
+        size_t numFired = 0;
+        manager.onClipStart = [&](int) { ++numFired; };
+        manager.onWordStart = [&](int, int) { ++numFired; };
+        manager.processEvents(2.5, 2.6);
+
+        REQUIRE(numFired == 2);  // Clip 1 and its first word
+        REQUIRE(manager.getActiveClipIndex() == 1);
+        REQUIRE(manager.getActiveWordIndex() == 0);
+    }
+}
+
+TEST_CASE("TimelineEventManager skips past events when time jumps forward", "[timeline]")
+{
+    const auto project = createTestProject();
+    TimelineEventManager manager;
+    manager.buildTimeline(project);
+
+    int numWordStarts = 0;
+    manager.onWordStart = [&](int, int) { ++numWordStarts; };
+
+    manager.processEvents(0.0, 0.1);
+    REQUIRE(numWordStarts == 1);
+
+    // A jump from 0.1 to 50: only events in [50, 50.5) fire
+    numWordStarts = 0;
+    manager.processEvents(50.0, 50.5);
+    REQUIRE(numWordStarts == 2);   // Clip 20 starts at 50.0, with words at 50.0 and 50.4
+    REQUIRE(manager.getDisplayStateAt(50.4).clipIndex == 20);
+    REQUIRE(manager.getDisplayStateAt(50.4).wordIndex == 1);
+}
+
+TEST_CASE("TimelineEventManager answers display state queries", "[timeline]")
+{
+    const auto project = createTestProject();
+
+    SECTION("The display state matches replaying every event up to the time")
+    {
+        auto minimum = HighlightSettings::storytellingPreset();
+        minimum.minimumDuration = 0.6;  // Longer than the gap between words
+
+        auto fixed = HighlightSettings::naturalPreset();
+        fixed.durationMode = HighlightSettings::DurationMode::Fixed;
+        fixed.fixedDuration = 0.1;
+
+        for (const auto& settings : { HighlightSettings::naturalPreset(), minimum, fixed, HighlightSettings::rhythmicPreset() })
+        {
+            TimelineEventManager manager;
+            manager.buildTimeline(project, settings);
+
+            std::vector<double> times;
+            for (double time = -0.5; time < 105.0; time += 0.07)
+                times.push_back(time);
+            for (const auto& event : manager.getTimeline())
+                times.push_back(event.time);
+
+            for (auto time : times)
+            {
+                const auto state = manager.getDisplayStateAt(time);
+                const auto expected = replayTo(project, settings, time);
+
+                REQUIRE(state.clipIndex == expected.clipIndex);
+                REQUIRE(state.wordIndex == expected.wordIndex);
+                REQUIRE(state.highlightActive == expected.highlightActive);
+            }
+        }
+    }
+
+    SECTION("A fixed highlight ends before the next word starts")
+    {
+        auto settings = HighlightSettings::naturalPreset();
+        settings.durationMode = HighlightSettings::DurationMode::Fixed;
+        settings.fixedDuration = 0.1;
+
+        TimelineEventManager manager;
+        manager.buildTimeline(project, settings);
+
+        auto state = manager.getDisplayStateAt(0.45);   // Clip 0's second word starts at 0.4
+        REQUIRE(state.clipIndex == 0);
+        REQUIRE(state.wordIndex == 1);
+        REQUIRE(state.highlightActive);
+
+        state = manager.getDisplayStateAt(0.55);
+        REQUIRE(state.wordIndex == 1);
+        REQUIRE(!state.highlightActive);
+    }
+
+    SECTION("Queries don't disturb playback")
+    {
+        TimelineEventManager manager;
+        manager.buildTimeline(project);
+
+        size_t numFired = 0;
+        manager.onWordStart = [&](int, int) { ++numFired; };
+        manager.processEvents(0.0, 30.0);
+
+        for (double time = 100.0; time > 0.0; time -= 7.3)
+            manager.getDisplayStateAt(time);
+
+        numFired = 0;
+        manager.processEvents(30.0, 32.5);
+        REQUIRE(numFired == 4);  // Clip 12 starts at 30.0 with four words
+        REQUIRE(manager.getDisplayStateAt(-1.0).clipIndex == -1);
+        REQUIRE(manager.getDisplayStateAt(1000.0).clipIndex == 39);
+    }
+}
+
+TEST_CASE("TimelineEventManager merges clip runs into one sorted timeline", "[timeline]")
+{
+    const auto project = createTestProject();
+
+    auto settings = HighlightSettings::storytellingPreset();
+    settings.minimumDuration = 0.6;  // Highlights run past the next word and into the next clip
+
+    TimelineEventManager manager;
+    manager.buildTimeline(project, settings);
+
+    // Sorted by time, with same-time events from different clips in clip order
+    const auto& timeline = manager.getTimeline();
+    REQUIRE(timeline.size() == (size_t) (2 * project.getNumClips() + 3 * project.getTotalNumWords()));
+
+    for (size_t i = 1; i < timeline.size(); ++i)
+    {
+        REQUIRE(timeline[i - 1].time <= timeline[i].time);
+
+        if (timeline[i - 1].time == timeline[i].time)
+            REQUIRE(timeline[i - 1].clipIndex <= timeline[i].clipIndex);
+    }
+}
+
+TEST_CASE("TimelineEventManager rebuilds a single clip", "[timeline]")
+{
+    auto project = createTestProject();
+
+    auto settings = HighlightSettings::storytellingPreset();
+    settings.minimumDuration = 0.6;
+
+    TimelineEventManager manager;
+    manager.buildTimeline(project, settings);
+    manager.processEvents(0.0, 30.0);
+
+    SECTION("Editing a clip's words matches a full rebuild")
+    {
+        auto& clip = project.getClip(12);
+        clip.getWord(1).relativeTime = 0.9;
+        clip.addWord(NarrateWord("extra", 1.8));
+        clip.setEndTime(clip.getEndTime() + 0.7);  // Now overlaps the next clip
+
+        manager.rebuildClip(project, 12);
+
+        TimelineEventManager expected;
+        expected.buildTimeline(project, settings);
+        requireSameTimeline(manager, expected);
+    }
+
+    SECTION("Emptying a clip and moving it within its slot matches a full rebuild")
+    {
+        auto& clip = project.getClip(3);
+        while (clip.getNumWords() > 0)
+            clip.removeWord(0);
+        clip.setStartTime(clip.getStartTime() + 0.2);
+
+        manager.rebuildClip(project, 3);
+
+        TimelineEventManager expected;
+        expected.buildTimeline(project, settings);
+        requireSameTimeline(manager, expected);
+    }
+
+    SECTION("Playback carries on from the same time")
+    {
+        project.getClip(25).getWord(2).relativeTime = 1.1;
+        manager.rebuildClip(project, 25);
+
+        size_t numFired = 0;
+        manager.onClipStart = [&](int) { ++numFired; };
+        manager.onWordStart = [&](int, int) { ++numFired; };
+        manager.processEvents(30.0, 32.5);
+
+        REQUIRE(numFired == 5);  // Clip 12 and its four words
+    }
+
+    SECTION("A run of edits growing and shrinking clips matches a full rebuild")
+    {
+        for (const int clipIndex : { 12, 13, 12, 5, 12 })
+        {
+            auto& clip = project.getClip(clipIndex);
+
+            if (clip.getNumWords() < 6)
+                clip.addWord(NarrateWord("more", clip.getDuration() - 0.3));
+            else
+                clip.removeWord(1);
+
+            manager.rebuildClip(project, clipIndex);
+        }
+
+        TimelineEventManager expected;
+        expected.buildTimeline(project, settings);
+        requireSameTimeline(manager, expected);
+    }
+
+    SECTION("Moving a clip past others falls back to a full rebuild")
+    {
+        // The clip count is unchanged, but every clip from 5 to 12 now has a new index
+        const int clipIndex = project.setClipTimes(5, 31.0, 33.0);
+        REQUIRE(clipIndex == 12);
+        REQUIRE(project.getNumClips() == 40);
+
+        manager.rebuildClip(project, clipIndex);
+
+        TimelineEventManager expected;
+        expected.buildTimeline(project, settings);
+        requireSameTimeline(manager, expected);
+
+        size_t numFired = 0;
+        manager.onClipStart = [&](int clipStarted)
+        {
+            REQUIRE(clipStarted == 12);
+            ++numFired;
+        };
+        manager.processEvents(30.5, 31.5);
+        REQUIRE(numFired == 1);
+    }
+
+    SECTION("Adding a clip falls back to a full rebuild")
+    {
+        NarrateClip clip("late", 200.0, 201.0);
+        clip.addWord(NarrateWord("last", 0.0));
+        project.addClip(clip);
+
+        manager.rebuildClip(project, 40);
+
+        TimelineEventManager expected;
+        expected.buildTimeline(project, settings);
+        requireSameTimeline(manager, expected);
+    }
+}
+
+TEST_CASE("TimelineEventManager dispatches to a listener", "[timeline]")
+{
+    const auto project = createTestProject();
+
+    struct RecordingListener final : TimelineEventManager::Listener
+    {
+        std::vector<TimelineEventManager::TimeEvent> events;
+
+        void clipStarted(int clipIndex) override { events.push_back({ 0.0, TimelineEventManager::EventType::ClipStart, clipIndex, -1 }); }
+        void clipEnded(int clipIndex) override { events.push_back({ 0.0, TimelineEventManager::EventType::ClipEnd, clipIndex, -1 }); }
+        void wordStarted(int clipIndex, int wordIndex) override { events.push_back({ 0.0, TimelineEventManager::EventType::WordStart, clipIndex, wordIndex }); }
+        void wordEnded(int clipIndex, int wordIndex) override { events.push_back({ 0.0, TimelineEventManager::EventType::WordEnd, clipIndex, wordIndex }); }
+        void highlightEnded(int clipIndex, int wordIndex) override { events.push_back({ 0.0, TimelineEventManager::EventType::HighlightEnd, clipIndex, wordIndex }); }
+    };
+
+    TimelineEventManager manager;
+    manager.buildTimeline(project);
+
+    RecordingListener listener;
+    manager.processEvents(-1.0, 1000.0, listener);
+
+    // Every event fires once, in timeline order, with its clip and word decoded
+    const auto timeline = manager.getTimeline();
+    REQUIRE(listener.events.size() == timeline.size());
+
+    for (size_t i = 0; i < timeline.size(); ++i)
+    {
+        REQUIRE(listener.events[i].type == timeline[i].type);
+        REQUIRE(listener.events[i].clipIndex == timeline[i].clipIndex);
+        REQUIRE(listener.events[i].wordIndex == timeline[i].wordIndex);
+    }
+
+    // Times are whole ticks, and word events name words that exist in their clip
+    for (const auto& event : timeline)
+    {
+        const double ticks = event.time * TimelineEventManager::ticksPerSecond;
+        REQUIRE(ticks == std::round(ticks));
+
+        if (event.wordIndex >= 0)
+            REQUIRE(event.wordIndex < project.getClip(event.clipIndex).getNumWords());
+    }
+}
+
+TEST_CASE("TimelineEventManager compiles the same timeline in parallel chunks", "[timeline]")
+{
+    const auto project = createLargeProject();
+    REQUIRE(project.getTotalNumWords() >= TimelineEventManager::parallelBuildMinWords);
+
+    std::vector<HighlightSettings> allSettings;
+
+    for (bool quantize : { false, true })
+    {
+        for (auto mode : { HighlightSettings::DurationMode::Original, HighlightSettings::DurationMode::Minimum,
+                           HighlightSettings::DurationMode::Fixed, HighlightSettings::DurationMode::GridBased })
+        {
+            HighlightSettings settings;
+            settings.quantizeEnabled = quantize;
+            settings.bpm = 97.0;
+            settings.subdivision = 8;
+            settings.durationMode = mode;
+            settings.minimumDuration = 0.45;
+            settings.fixedDuration = 0.3;
+            allSettings.push_back(settings);
+        }
+    }
+
+    // Each manager is kept across the settings, so later parallel builds reuse the first one's threads
+    TimelineEventManager managers[2];
+    managers[0].setMaxBuildThreads(1);
+    managers[1].setMaxBuildThreads(4);
+
+    for (const auto& settings : allSettings)
+    {
+        const auto expected = buildReferenceTimeline(project, settings);
+
+        for (auto& manager : managers)
+        {
+            manager.buildTimeline(project, settings);
+
+            const auto timeline = manager.getTimeline();
+            REQUIRE(timeline.size() == expected.size());
+
+            for (size_t i = 0; i < timeline.size(); ++i)
+            {
+                REQUIRE(timeline[i].time == expected[i].time);
+                REQUIRE(timeline[i].type == expected[i].type);
+                REQUIRE(timeline[i].clipIndex == expected[i].clipIndex);
+                REQUIRE(timeline[i].wordIndex == expected[i].wordIndex);
+            }
+
+            // The active state carries across the chunks the merge was split into
+            TimelineEventManager serial;
+            serial.setMaxBuildThreads(1);
+            serial.buildTimeline(project, settings);
+
+            for (double time = 0.0; time < project.getTotalDuration(); time += 1.7)
+            {
+                const auto state = manager.getDisplayStateAt(time);
+                const auto expectedState = serial.getDisplayStateAt(time);
+                REQUIRE(state.clipIndex == expectedState.clipIndex);
+                REQUIRE(state.wordIndex == expectedState.wordIndex);
+                REQUIRE(state.highlightActive == expectedState.highlightActive);
+            }
+        }
+    }
+}